@@ -0,0 +1,199 @@
+#include <furi.h>
+#include <toolbox/compress.h>
+
+#include "../minunit.h"
+
+#define COMPRESS_TEST_SLOT_SIZE 128
+#define COMPRESS_TEST_SLOTS 4
+#define COMPRESS_TEST_ICON_COUNT (COMPRESS_TEST_SLOTS + 1)
+#define COMPRESS_TEST_ICON_SIZE 64
+#define COMPRESS_TEST_BIG_ICON_SIZE 512
+#define COMPRESS_TEST_BUFFER_SIZE 1024
+
+typedef struct {
+    uint8_t bitmap[COMPRESS_TEST_ICON_SIZE];
+    uint8_t data[COMPRESS_TEST_BUFFER_SIZE];
+} CompressTestIcon;
+
+static void compress_test_fill_bitmap(uint8_t* bitmap, size_t size, uint8_t seed) {
+    // Runs of a repeated byte, compressible like real icons
+    for(size_t i = 0; i < size; i++) {
+        bitmap[i] = seed + (i / 8);
+    }
+}
+
+// Encode bitmap the way assets compiler does: header with payload size, then heatshrink stream
+static bool compress_test_make_icon(
+    Compress* compress,
+    const uint8_t* bitmap,
+    size_t size,
+    uint8_t* icon_data) {
+    size_t encoded_size = 0;
+    bool encoded = compress_encode(
+        compress, (uint8_t*)bitmap, size, icon_data, COMPRESS_TEST_BUFFER_SIZE, &encoded_size);
+    if(!encoded || icon_data[0] != 0x01) {
+        return false;
+    }
+
+    // compress_encode counts the header in, assets compiler does not
+    uint16_t payload_size = encoded_size - 4;
+    memcpy(&icon_data[2], &payload_size, sizeof(payload_size));
+    return true;
+}
+
+static bool compress_test_decode(
+    CompressIcon* compress_icon,
+    const uint8_t* icon_data,
+    const uint8_t* bitmap,
+    size_t size) {
+    uint8_t* decoded = NULL;
+    compress_icon_decode(compress_icon, icon_data, &decoded);
+    return decoded && memcmp(decoded, bitmap, size) == 0;
+}
+
+typedef struct {
+    Compress* compress;
+    CompressIcon* compress_icon;
+    CompressTestIcon* icons;
+} CompressTestContext;
+
+static CompressTestContext test;
+
+static void compress_test_setup(void) {
+    test.compress = compress_alloc(COMPRESS_TEST_BUFFER_SIZE);
+    test.compress_icon = compress_icon_alloc();
+    compress_icon_set_cache_size(
+        test.compress_icon, COMPRESS_TEST_SLOTS * COMPRESS_TEST_SLOT_SIZE);
+
+    test.icons = malloc(sizeof(CompressTestIcon) * COMPRESS_TEST_ICON_COUNT);
+    for(size_t i = 0; i < COMPRESS_TEST_ICON_COUNT; i++) {
+        compress_test_fill_bitmap(test.icons[i].bitmap, COMPRESS_TEST_ICON_SIZE, i * 16);
+        furi_check(compress_test_make_icon(
+            test.compress, test.icons[i].bitmap, COMPRESS_TEST_ICON_SIZE, test.icons[i].data));
+    }
+}
+
+static void compress_test_teardown(void) {
+    free(test.icons);
+    compress_icon_free(test.compress_icon);
+    compress_free(test.compress);
+}
+
+static bool compress_test_decode_icon(size_t index) {
+    CompressTestIcon* icon = &test.icons[index];
+    return compress_test_decode(
+        test.compress_icon, icon->data, icon->bitmap, COMPRESS_TEST_ICON_SIZE);
+}
+
+MU_TEST(test_compress_icon_cache_hit) {
+    CompressIconCacheStats stats;
+
+    mu_check(compress_test_decode_icon(0));
+    compress_icon_get_cache_stats(test.compress_icon, &stats);
+    mu_assert_int_eq(0, stats.hits);
+    mu_assert_int_eq(1, stats.misses);
+
+    mu_check(compress_test_decode_icon(0));
+    mu_check(compress_test_decode_icon(0));
+    compress_icon_get_cache_stats(test.compress_icon, &stats);
+    mu_assert_int_eq(2, stats.hits);
+    mu_assert_int_eq(1, stats.misses);
+    mu_assert_int_eq(0, stats.evictions);
+}
+
+MU_TEST(test_compress_icon_cache_eviction) {
+    CompressIconCacheStats stats;
+
+    // Fill every slot, then make icon 0 the most recently used one
+    for(size_t i = 0; i < COMPRESS_TEST_SLOTS; i++) {
+        mu_check(compress_test_decode_icon(i));
+    }
+    mu_check(compress_test_decode_icon(0));
+    compress_icon_get_cache_stats(test.compress_icon, &stats);
+    mu_assert_int_eq(1, stats.hits);
+    mu_assert_int_eq(COMPRESS_TEST_SLOTS, stats.misses);
+    mu_assert_int_eq(0, stats.evictions);
+
+    // One more icon evicts least recently used icon 1
+    mu_check(compress_test_decode_icon(COMPRESS_TEST_SLOTS));
+    compress_icon_get_cache_stats(test.compress_icon, &stats);
+    mu_assert_int_eq(1, stats.evictions);
+
+    mu_check(compress_test_decode_icon(0));
+    mu_check(compress_test_decode_icon(COMPRESS_TEST_SLOTS));
+    compress_icon_get_cache_stats(test.compress_icon, &stats);
+    mu_assert_int_eq(3, stats.hits);
+
+    mu_check(compress_test_decode_icon(1));
+    compress_icon_get_cache_stats(test.compress_icon, &stats);
+    mu_assert_int_eq(3, stats.hits);
+    mu_assert_int_eq(COMPRESS_TEST_SLOTS + 2, stats.misses);
+    mu_assert_int_eq(2, stats.evictions);
+}
+
+MU_TEST(test_compress_icon_cache_reused_address) {
+    CompressIconCacheStats stats;
+    uint8_t* icon_data = malloc(COMPRESS_TEST_BUFFER_SIZE);
+
+    memcpy(icon_data, test.icons[0].data, COMPRESS_TEST_BUFFER_SIZE);
+    mu_check(compress_test_decode(
+        test.compress_icon, icon_data, test.icons[0].bitmap, COMPRESS_TEST_ICON_SIZE));
+
+    // Same address now holds another icon, e.g. after a FAP was unloaded and another one loaded
+    memcpy(icon_data, test.icons[1].data, COMPRESS_TEST_BUFFER_SIZE);
+    bool reused_decoded = compress_test_decode(
+        test.compress_icon, icon_data, test.icons[1].bitmap, COMPRESS_TEST_ICON_SIZE);
+    bool reused_cached = compress_test_decode(
+        test.compress_icon, icon_data, test.icons[1].bitmap, COMPRESS_TEST_ICON_SIZE);
+    free(icon_data);
+
+    mu_assert(reused_decoded, "Stale icon returned for reused address");
+    mu_assert(reused_cached, "Reused address not cached with new icon");
+    compress_icon_get_cache_stats(test.compress_icon, &stats);
+    mu_assert_int_eq(1, stats.hits);
+    mu_assert_int_eq(2, stats.misses);
+    mu_assert_int_eq(0, stats.evictions);
+}
+
+MU_TEST(test_compress_icon_cache_oversized) {
+    CompressIconCacheStats stats;
+    uint8_t* bitmap = malloc(COMPRESS_TEST_BIG_ICON_SIZE);
+    uint8_t* icon_data = malloc(COMPRESS_TEST_BUFFER_SIZE);
+    compress_test_fill_bitmap(bitmap, COMPRESS_TEST_BIG_ICON_SIZE, 0x5A);
+    bool made = compress_test_make_icon(
+        test.compress, bitmap, COMPRESS_TEST_BIG_ICON_SIZE, icon_data);
+
+    // Cached small icons stay in place, big one bypasses the cache
+    bool small_decoded = compress_test_decode_icon(0);
+    bool big_decoded = true;
+    for(size_t i = 0; i < 3; i++) {
+        big_decoded &= compress_test_decode(
+            test.compress_icon, icon_data, bitmap, COMPRESS_TEST_BIG_ICON_SIZE);
+    }
+    bool small_cached = compress_test_decode_icon(0);
+    free(icon_data);
+    free(bitmap);
+
+    mu_assert(made, "Icon bigger than cache slot is not compressed");
+    mu_check(small_decoded);
+    mu_check(big_decoded);
+    mu_check(small_cached);
+    compress_icon_get_cache_stats(test.compress_icon, &stats);
+    mu_assert_int_eq(1, stats.hits);
+    mu_assert_int_eq(4, stats.misses);
+    mu_assert_int_eq(0, stats.evictions);
+}
+
+MU_TEST_SUITE(test_compress) {
+    MU_SUITE_CONFIGURE(&compress_test_setup, &compress_test_teardown);
+
+    MU_RUN_TEST(test_compress_icon_cache_hit);
+    MU_RUN_TEST(test_compress_icon_cache_eviction);
+    MU_RUN_TEST(test_compress_icon_cache_reused_address);
+    MU_RUN_TEST(test_compress_icon_cache_oversized);
+}
+
+int run_minunit_test_compress(void) {
+    MU_RUN_SUITE(test_compress);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,160 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <desktop/animations/animation_storage.h>
+#include <cfw/cfw.h>
+
+#include "../minunit.h"
+
+#define ANIMATION_TEST_NAME "unit_tests_pack"
+#define ANIMATION_TEST_DIR EXT_PATH("dolphin/" ANIMATION_TEST_NAME)
+#define ANIMATION_TEST_PACK ANIMATION_TEST_DIR "/frames.pack"
+#define ANIMATION_TEST_MANIFEST EXT_PATH("dolphin/unit_tests_manifest.txt")
+
+static char animation_test_manifest_name[] = "unit_tests_manifest.txt";
+
+// Levels no dolphin has, so animation manager never picks it while test runs
+static const char animation_test_manifest[] = "Filetype: Flipper Animation Manifest\n"
+                                              "Version: 1\n"
+                                              "\n"
+                                              "Name: " ANIMATION_TEST_NAME "\n"
+                                              "Min butthurt: 0\n"
+                                              "Max butthurt: 14\n"
+                                              "Min level: 100\n"
+                                              "Max level: 100\n"
+                                              "Weight: 1\n";
+
+static const char animation_test_meta[] = "Filetype: Flipper Animation\n"
+                                          "Version: 1\n"
+                                          "\n"
+                                          "Width: 8\n"
+                                          "Height: 2\n"
+                                          "Passive frames: 2\n"
+                                          "Active frames: 0\n"
+                                          "Frames order: 0 1\n"
+                                          "Active cycles: 0\n"
+                                          "Frame rate: 2\n"
+                                          "Duration: 3600\n"
+                                          "Active cooldown: 0\n"
+                                          "\n"
+                                          "Bubble slots: 0\n";
+
+// Uncompressed 8x2 bitmaps
+static const uint8_t animation_test_frame_0[] = {0x00, 0xA0, 0xA1};
+static const uint8_t animation_test_frame_1[] = {0x00, 0xB0, 0xB1};
+static const uint8_t animation_test_frame_1_new[] = {0x00, 0xC0};
+
+static bool
+    animation_test_write(Storage* storage, const char* path, const void* data, size_t size) {
+    File* file = storage_file_alloc(storage);
+    bool result = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                  (storage_file_write(file, data, size) == size);
+    storage_file_free(file);
+    return result;
+}
+
+// Load animation the way animation manager does and check data of frame 1
+static bool animation_test_check_frame_1(const uint8_t* expected, size_t size) {
+    StorageAnimation* storage_animation = animation_storage_find_animation(ANIMATION_TEST_NAME);
+    if(!storage_animation) return false;
+
+    const BubbleAnimation* animation = animation_storage_get_bubble_animation(storage_animation);
+    bool result = animation && animation->frame_stream &&
+                  animation_storage_prefetch_frame(animation, 1);
+    if(result) {
+        const uint8_t* frame = animation_storage_get_frame(animation, 1);
+        result = frame && (memcmp(frame, expected, size) == 0);
+    }
+
+    animation_storage_free_storage_animation(&storage_animation);
+    return result;
+}
+
+// Change last byte of the packed frame 1, a rebuilt pack would not have it
+static bool animation_test_patch_pack(Storage* storage, uint8_t value) {
+    File* file = storage_file_alloc(storage);
+    bool result =
+        storage_file_open(file, ANIMATION_TEST_PACK, FSAM_READ_WRITE, FSOM_OPEN_EXISTING) &&
+        storage_file_seek(file, storage_file_size(file) - 1, true) &&
+        (storage_file_write(file, &value, 1) == 1);
+    storage_file_free(file);
+    return result;
+}
+
+MU_TEST(test_animation_storage_pack_outdated) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    char* manifest_name = cfw_settings.manifest_name;
+    bool created = false, built = false, reused = false, rebuilt = false;
+
+    storage_simply_remove_recursive(storage, ANIMATION_TEST_DIR);
+    storage_simply_mkdir(storage, EXT_PATH("dolphin"));
+    do {
+        // Build: first load packs frame files
+        if(!storage_simply_mkdir(storage, ANIMATION_TEST_DIR)) break;
+        if(!animation_test_write(
+               storage,
+               ANIMATION_TEST_MANIFEST,
+               animation_test_manifest,
+               strlen(animation_test_manifest)))
+            break;
+        if(!animation_test_write(
+               storage,
+               ANIMATION_TEST_DIR "/meta.txt",
+               animation_test_meta,
+               strlen(animation_test_meta)))
+            break;
+        if(!animation_test_write(
+               storage,
+               ANIMATION_TEST_DIR "/frame_0.bm",
+               animation_test_frame_0,
+               sizeof(animation_test_frame_0)))
+            break;
+        if(!animation_test_write(
+               storage,
+               ANIMATION_TEST_DIR "/frame_1.bm",
+               animation_test_frame_1,
+               sizeof(animation_test_frame_1)))
+            break;
+        created = true;
+
+        cfw_settings.manifest_name = animation_test_manifest_name;
+        built = animation_test_check_frame_1(
+                    animation_test_frame_1, sizeof(animation_test_frame_1)) &&
+                storage_file_exists(storage, ANIMATION_TEST_PACK);
+        if(!built) break;
+
+        // Reopen: unchanged files keep the pack
+        const uint8_t patched[] = {0x00, 0xB0, 0xEE};
+        if(!animation_test_patch_pack(storage, 0xEE)) break;
+        reused = animation_test_check_frame_1(patched, sizeof(patched));
+        if(!reused) break;
+
+        // Frame resized while meta.txt stays the same outdates the pack
+        if(!animation_test_write(
+               storage,
+               ANIMATION_TEST_DIR "/frame_1.bm",
+               animation_test_frame_1_new,
+               sizeof(animation_test_frame_1_new)))
+            break;
+        rebuilt = animation_test_check_frame_1(
+            animation_test_frame_1_new, sizeof(animation_test_frame_1_new));
+    } while(false);
+
+    cfw_settings.manifest_name = manifest_name;
+    storage_simply_remove_recursive(storage, ANIMATION_TEST_DIR);
+    storage_simply_remove(storage, ANIMATION_TEST_MANIFEST);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(created, "Cannot create test animation");
+    mu_assert(built, "Pack is not built");
+    mu_assert(reused, "Pack of unchanged animation is not reused");
+    mu_assert(rebuilt, "Outdated pack is used");
+}
+
+MU_TEST_SUITE(test_animation_storage_suite) {
+    MU_RUN_TEST(test_animation_storage_pack_outdated);
+}
+
+int run_minunit_test_animation_storage(void) {
+    MU_RUN_SUITE(test_animation_storage_suite);
+    return MU_EXIT_CODE;
+}
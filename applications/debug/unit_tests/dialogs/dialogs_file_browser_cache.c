@@ -0,0 +1,117 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <gui/modules/file_browser_worker.h>
+
+#include "../minunit.h"
+
+#define BROWSER_CACHE_TEST_DIR EXT_PATH("unit_tests/browser_cache_dir")
+#define BROWSER_CACHE_TEST_FILES 8
+#define BROWSER_CACHE_TEST_TIMEOUT 5000
+
+typedef struct {
+    FuriSemaphore* done;
+    uint32_t item_cnt;
+} BrowserCacheTestContext;
+
+static void browser_cache_test_folder_callback(
+    void* context,
+    uint32_t item_cnt,
+    int32_t file_idx,
+    bool is_root) {
+    UNUSED(file_idx);
+    UNUSED(is_root);
+    BrowserCacheTestContext* test = context;
+    test->item_cnt = item_cnt;
+    furi_semaphore_release(test->done);
+}
+
+static bool browser_cache_test_create_file(Storage* storage, uint32_t index) {
+    FuriString* path = furi_string_alloc_printf("%s/file_%lu.test", BROWSER_CACHE_TEST_DIR, index);
+    File* file = storage_file_alloc(storage);
+    bool result =
+        storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    storage_file_free(file);
+    furi_string_free(path);
+    return result;
+}
+
+// Opens the folder in a new worker, the way every file dialog does, and waits for the listing
+static uint32_t browser_cache_test_open_folder(BrowserCacheTestContext* test) {
+    FuriString* path = furi_string_alloc_set(BROWSER_CACHE_TEST_DIR);
+    BrowserWorker* browser = file_browser_worker_alloc(path, NULL, "*", false, false);
+    file_browser_worker_set_callback_context(browser, test);
+    file_browser_worker_set_folder_callback(browser, browser_cache_test_folder_callback);
+
+    test->item_cnt = 0;
+    FuriStatus status = furi_semaphore_acquire(test->done, BROWSER_CACHE_TEST_TIMEOUT);
+
+    file_browser_worker_free(browser);
+    furi_string_free(path);
+
+    return (status == FuriStatusOk) ? test->item_cnt : UINT32_MAX;
+}
+
+MU_TEST(test_file_browser_cache_survives_worker) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    BrowserCacheTestContext test = {.done = furi_semaphore_alloc(1, 0)};
+    BrowserWorkerCacheStats before, after;
+
+    storage_simply_remove_recursive(storage, BROWSER_CACHE_TEST_DIR);
+    mu_assert(storage_simply_mkdir(storage, BROWSER_CACHE_TEST_DIR), "Cannot create test dir");
+    for(uint32_t i = 0; i < BROWSER_CACHE_TEST_FILES; i++) {
+        mu_assert(browser_cache_test_create_file(storage, i), "Cannot create test file");
+    }
+
+    // First dialog reads the folder from storage
+    file_browser_worker_get_cache_stats(&before);
+    mu_assert_int_eq(BROWSER_CACHE_TEST_FILES, browser_cache_test_open_folder(&test));
+    file_browser_worker_get_cache_stats(&after);
+    mu_assert_int_eq(before.misses + 1, after.misses);
+
+    // Second dialog lists it from cache, although the first worker is gone
+    before = after;
+    mu_assert_int_eq(BROWSER_CACHE_TEST_FILES, browser_cache_test_open_folder(&test));
+    file_browser_worker_get_cache_stats(&after);
+    mu_assert_int_eq(before.hits + 1, after.hits);
+    mu_assert_int_eq(before.misses, after.misses);
+
+    // Writing elsewhere on the card keeps the folder cached
+    mu_assert(
+        storage_simply_mkdir(storage, EXT_PATH("unit_tests/browser_cache_other")),
+        "Cannot create other dir");
+    storage_simply_remove(storage, EXT_PATH("unit_tests/browser_cache_other"));
+    before = after;
+    mu_assert_int_eq(BROWSER_CACHE_TEST_FILES, browser_cache_test_open_folder(&test));
+    file_browser_worker_get_cache_stats(&after);
+    mu_assert_int_eq(before.hits + 1, after.hits);
+
+    // New file in the folder itself invalidates the listing
+    uint32_t version_before = 0, version_after = 0;
+    mu_assert_int_eq(
+        FSE_OK, storage_common_dir_version(storage, BROWSER_CACHE_TEST_DIR, &version_before));
+    mu_assert(
+        browser_cache_test_create_file(storage, BROWSER_CACHE_TEST_FILES),
+        "Cannot create test file");
+    mu_assert_int_eq(
+        FSE_OK, storage_common_dir_version(storage, BROWSER_CACHE_TEST_DIR, &version_after));
+    mu_assert(version_before != version_after, "Folder version not changed");
+
+    before = after;
+    mu_assert_int_eq(BROWSER_CACHE_TEST_FILES + 1, browser_cache_test_open_folder(&test));
+    file_browser_worker_get_cache_stats(&after);
+    mu_assert_int_eq(before.misses + 1, after.misses);
+
+    storage_simply_remove_recursive(storage, BROWSER_CACHE_TEST_DIR);
+    furi_semaphore_free(test.done);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(dialogs_file_browser_cache) {
+    MU_RUN_TEST(test_file_browser_cache_survives_worker);
+}
+
+int run_minunit_test_dialogs_file_browser_cache(void) {
+    MU_RUN_SUITE(dialogs_file_browser_cache);
+
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,154 @@
+#include <furi.h>
+#include <flipper_application/api_hashtable/api_hashtable.h>
+#include <loader/firmware_api/firmware_api.h>
+
+#include "../minunit.h"
+
+#define BENCHMARK_PASS_COUNT 32
+
+// Undefined symbols of a typical GUI application
+static const char* const fap_undefined_symbols[] = {
+    "__furi_crash_implementation",
+    "canvas_clear",
+    "canvas_draw_box",
+    "canvas_draw_dot",
+    "canvas_draw_frame",
+    "canvas_draw_str",
+    "canvas_draw_str_aligned",
+    "canvas_set_color",
+    "canvas_set_font",
+    "free",
+    "furi_hal_random_get",
+    "furi_kernel_get_tick_frequency",
+    "furi_log_print_format",
+    "furi_message_queue_alloc",
+    "furi_message_queue_free",
+    "furi_message_queue_get",
+    "furi_message_queue_put",
+    "furi_mutex_acquire",
+    "furi_mutex_alloc",
+    "furi_mutex_free",
+    "furi_mutex_release",
+    "furi_record_close",
+    "furi_record_open",
+    "furi_string_alloc",
+    "furi_string_free",
+    "furi_string_get_cstr",
+    "furi_string_printf",
+    "furi_timer_alloc",
+    "furi_timer_free",
+    "furi_timer_start",
+    "furi_timer_stop",
+    "gui_add_view_port",
+    "gui_remove_view_port",
+    "malloc",
+    "memcpy",
+    "memset",
+    "notification_message",
+    "sequence_display_backlight_enforce_auto",
+    "sequence_display_backlight_enforce_on",
+    "sequence_single_vibro",
+    "snprintf",
+    "view_port_alloc",
+    "view_port_draw_callback_set",
+    "view_port_enabled_set",
+    "view_port_free",
+    "view_port_input_callback_set",
+    "view_port_update",
+};
+
+// Not in API, must fail in both tables
+static const char* const missing_symbols[] = {
+    "__check_fail",
+    "furi_hal_does_not_exist",
+    "",
+};
+
+static bool api_hashtable_resolve(const ElfApiInterface* interface, uint32_t hash, uint32_t* out) {
+    Elf32_Addr address = 0;
+    bool found = interface->resolver_callback(interface, hash, &address);
+    *out = found ? address : 0;
+    return found;
+}
+
+MU_TEST(test_api_hashtable_firmware_symbols) {
+    const ElfApiInterface* sorted = firmware_api_unit_tests_sorted_interface;
+    const ElfApiInterface* perfect = firmware_api_unit_tests_perfect_interface;
+
+    for(size_t i = 0; i < firmware_api_unit_tests_symbol_count; i++) {
+        const struct sym_entry* entry = &firmware_api_unit_tests_symbols[i];
+        uint32_t sorted_address, perfect_address;
+
+        mu_assert(api_hashtable_resolve(sorted, entry->hash, &sorted_address), "Sorted miss");
+        mu_assert(api_hashtable_resolve(perfect, entry->hash, &perfect_address), "Perfect miss");
+        mu_assert_int_eq(entry->address, sorted_address);
+        mu_assert_int_eq(entry->address, perfect_address);
+
+        // Hashes around a key land on other slots and must not alias it
+        uint32_t neighbour = entry->hash + 1;
+        bool sorted_found = api_hashtable_resolve(sorted, neighbour, &sorted_address);
+        bool perfect_found = api_hashtable_resolve(perfect, neighbour, &perfect_address);
+        mu_assert(sorted_found == perfect_found, "Resolvers disagree on neighbour hash");
+        mu_assert_int_eq(sorted_address, perfect_address);
+    }
+}
+
+MU_TEST(test_api_hashtable_fap_symbols) {
+    const ElfApiInterface* sorted = firmware_api_unit_tests_sorted_interface;
+    const ElfApiInterface* perfect = firmware_api_unit_tests_perfect_interface;
+    uint32_t sorted_address, perfect_address;
+
+    for(size_t i = 0; i < COUNT_OF(fap_undefined_symbols); i++) {
+        uint32_t hash = elf_symbolname_hash(fap_undefined_symbols[i]);
+        mu_assert(api_hashtable_resolve(sorted, hash, &sorted_address), fap_undefined_symbols[i]);
+        mu_assert(
+            api_hashtable_resolve(perfect, hash, &perfect_address), fap_undefined_symbols[i]);
+        mu_assert_int_eq(sorted_address, perfect_address);
+    }
+
+    for(size_t i = 0; i < COUNT_OF(missing_symbols); i++) {
+        uint32_t hash = elf_symbolname_hash(missing_symbols[i]);
+        mu_assert(!api_hashtable_resolve(sorted, hash, &sorted_address), missing_symbols[i]);
+        mu_assert(!api_hashtable_resolve(perfect, hash, &perfect_address), missing_symbols[i]);
+    }
+}
+
+static uint32_t api_hashtable_benchmark(const ElfApiInterface* interface, uint32_t* checksum) {
+    uint32_t ticks = furi_get_tick();
+    for(size_t pass = 0; pass < BENCHMARK_PASS_COUNT; pass++) {
+        for(size_t i = 0; i < firmware_api_unit_tests_symbol_count; i++) {
+            Elf32_Addr address = 0;
+            interface->resolver_callback(
+                interface, firmware_api_unit_tests_symbols[i].hash, &address);
+            *checksum += address;
+        }
+    }
+    return furi_get_tick() - ticks;
+}
+
+MU_TEST(test_api_hashtable_benchmark) {
+    uint32_t sorted_checksum = 0, perfect_checksum = 0;
+    uint32_t sorted_ticks =
+        api_hashtable_benchmark(firmware_api_unit_tests_sorted_interface, &sorted_checksum);
+    uint32_t perfect_ticks =
+        api_hashtable_benchmark(firmware_api_unit_tests_perfect_interface, &perfect_checksum);
+    mu_assert_int_eq(sorted_checksum, perfect_checksum);
+
+    printf(
+        "API resolve %d x %zu symbols: sorted table %lu ms, perfect hash %lu ms\r\n",
+        BENCHMARK_PASS_COUNT,
+        firmware_api_unit_tests_symbol_count,
+        sorted_ticks,
+        perfect_ticks);
+}
+
+MU_TEST_SUITE(test_api_hashtable_suite) {
+    MU_RUN_TEST(test_api_hashtable_firmware_symbols);
+    MU_RUN_TEST(test_api_hashtable_fap_symbols);
+    MU_RUN_TEST(test_api_hashtable_benchmark);
+}
+
+int run_minunit_test_api_hashtable(void) {
+    MU_RUN_SUITE(test_api_hashtable_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,83 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <flipper_application/application_manifest_cache.h>
+
+#include "../minunit.h"
+
+#define MANIFEST_CACHE_TEST_PATH EXT_PATH("unit_tests/manifest_cache.fap")
+
+static bool manifest_cache_test_write(Storage* storage, const char* data) {
+    File* file = storage_file_alloc(storage);
+    size_t size = strlen(data);
+    bool result =
+        storage_file_open(file, MANIFEST_CACHE_TEST_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+        (storage_file_write(file, data, size) == size);
+    storage_file_free(file);
+    return result;
+}
+
+// Key of the current version of the test file, then lookup of it in cache
+static bool manifest_cache_test_get(Storage* storage, FlipperApplicationManifest* manifest) {
+    FlipperApplicationManifestCacheKey key;
+    memset(manifest, 0, sizeof(FlipperApplicationManifest));
+    return flipper_application_manifest_cache_key(storage, MANIFEST_CACHE_TEST_PATH, &key) &&
+           flipper_application_manifest_cache_get(storage, &key, manifest);
+}
+
+MU_TEST(test_manifest_cache_hit_and_miss) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperApplicationManifest* stored = malloc(sizeof(FlipperApplicationManifest));
+    FlipperApplicationManifest* loaded = malloc(sizeof(FlipperApplicationManifest));
+    FlipperApplicationManifestCacheKey key;
+    bool keyed = false, hit = false, same = false, size_miss = false, mtime_miss = false;
+
+    strlcpy(stored->name, "Cache Test", sizeof(stored->name));
+    stored->has_icon = 1;
+    memset(stored->icon, 0x5A, sizeof(stored->icon));
+
+    storage_simply_mkdir(storage, EXT_PATH("unit_tests"));
+    do {
+        if(!manifest_cache_test_write(storage, "fap v1")) break;
+        keyed = flipper_application_manifest_cache_key(storage, MANIFEST_CACHE_TEST_PATH, &key);
+        if(!keyed) break;
+        flipper_application_manifest_cache_put(storage, &key, stored);
+
+        // Unchanged file
+        hit = manifest_cache_test_get(storage, loaded);
+        if(!hit) break;
+        same = (strcmp(loaded->name, stored->name) == 0) &&
+               (loaded->has_icon == stored->has_icon) &&
+               (memcmp(loaded->icon, stored->icon, sizeof(stored->icon)) == 0);
+
+        // Size changed
+        if(!manifest_cache_test_write(storage, "fap v1.1")) break;
+        size_miss = !manifest_cache_test_get(storage, loaded);
+
+        // Same size, newer mtime, FAT keeps it with 2 second resolution
+        if(!flipper_application_manifest_cache_key(storage, MANIFEST_CACHE_TEST_PATH, &key)) break;
+        flipper_application_manifest_cache_put(storage, &key, stored);
+        furi_delay_ms(2100);
+        if(!manifest_cache_test_write(storage, "fap v1.2")) break;
+        mtime_miss = !manifest_cache_test_get(storage, loaded);
+    } while(false);
+
+    storage_simply_remove(storage, MANIFEST_CACHE_TEST_PATH);
+    free(loaded);
+    free(stored);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(keyed, "Cannot get cache key");
+    mu_assert(hit, "Unchanged file is not found in cache");
+    mu_assert(same, "Cached manifest differs from stored one");
+    mu_assert(size_miss, "Resized file is found in cache");
+    mu_assert(mtime_miss, "Modified file is found in cache");
+}
+
+MU_TEST_SUITE(test_manifest_cache_suite) {
+    MU_RUN_TEST(test_manifest_cache_hit_and_miss);
+}
+
+int run_minunit_test_manifest_cache(void) {
+    MU_RUN_SUITE(test_manifest_cache_suite);
+    return MU_EXIT_CODE;
+}
@@ -75,6 +75,10 @@ static const char* test_data_odd = "Filetype: Flipper File test\n"
                                    // Mixed trailing whitespace
                                    "Hex data: DE AD BE\t    ";
 
+#define BENCHMARK_RAW_LINES 64
+#define BENCHMARK_RAW_SIZE 512
+#define BENCHMARK_KEY_COUNT 300
+
 // data created by user on linux machine
 static const char* test_file_linux = TEST_DIR READ_TEST_NIX;
 // data created by user on windows machine
@@ -116,18 +120,23 @@ static void tests_teardown(void) {
     furi_record_close(RECORD_STORAGE);
 }
 
-static bool test_read(const char* file_name) {
+static bool test_read_ex(const char* file_name, bool buffered) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     bool result = false;
 
-    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FlipperFormat* file = buffered ? flipper_format_buffered_file_alloc(storage) :
+                                     flipper_format_file_alloc(storage);
     FuriString* string_value;
     string_value = furi_string_alloc();
     uint32_t uint32_value;
     void* scratchpad = malloc(512);
 
     do {
-        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(buffered) {
+            if(!flipper_format_buffered_file_open_existing(file, file_name)) break;
+        } else {
+            if(!flipper_format_file_open_existing(file, file_name)) break;
+        }
 
         if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
         if(furi_string_cmp_str(string_value, test_filetype) != 0) break;
@@ -178,6 +187,10 @@ static bool test_read(const char* file_name) {
     return result;
 }
 
+static bool test_read(const char* file_name) {
+    return test_read_ex(file_name, false);
+}
+
 static bool test_read_updated(const char* file_name) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     bool result = false;
@@ -456,6 +469,135 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+static bool test_write_raw_benchmark(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_buffered_file_alloc(storage);
+    int32_t* raw_data = malloc(sizeof(int32_t) * BENCHMARK_RAW_SIZE);
+
+    do {
+        if(!flipper_format_buffered_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_header_cstr(file, test_filetype, test_version)) break;
+
+        bool error = false;
+        for(size_t line = 0; line < BENCHMARK_RAW_LINES; line++) {
+            for(size_t i = 0; i < BENCHMARK_RAW_SIZE; i++) {
+                raw_data[i] = (int32_t)(100 + line + i * 7) * ((i & 1) ? -1 : 1);
+            }
+            if(!flipper_format_write_int32(file, "RAW_Data", raw_data, BENCHMARK_RAW_SIZE)) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    free(raw_data);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_read_raw_benchmark(const char* file_name, bool buffered, uint32_t* time) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = buffered ? flipper_format_buffered_file_alloc(storage) :
+                                     flipper_format_file_alloc(storage);
+    FuriString* string_value = furi_string_alloc();
+    int32_t* raw_data = malloc(sizeof(int32_t) * BENCHMARK_RAW_SIZE);
+    uint32_t start = furi_get_tick();
+
+    do {
+        if(buffered) {
+            if(!flipper_format_buffered_file_open_existing(file, file_name)) break;
+        } else {
+            if(!flipper_format_file_open_existing(file, file_name)) break;
+        }
+
+        uint32_t uint32_value;
+        if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
+
+        // Same access pattern as SubGhz RAW file reader
+        size_t line = 0;
+        bool error = false;
+        while(flipper_format_get_value_count(file, "RAW_Data", &uint32_value)) {
+            if(uint32_value != BENCHMARK_RAW_SIZE) break;
+            if(!flipper_format_read_int32(file, "RAW_Data", raw_data, uint32_value)) break;
+            for(size_t i = 0; i < BENCHMARK_RAW_SIZE; i++) {
+                if(raw_data[i] != (int32_t)(100 + line + i * 7) * ((i & 1) ? -1 : 1)) {
+                    error = true;
+                    break;
+                }
+            }
+            if(error) break;
+            line++;
+        }
+        if(line != BENCHMARK_RAW_LINES) break;
+
+        result = true;
+    } while(false);
+
+    *time = furi_get_tick() - start;
+
+    free(raw_data);
+    furi_string_free(string_value);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_read_key_index(const char* file_name, bool indexed, uint32_t* time) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_buffered_file_alloc(storage);
+    flipper_format_set_key_index(file, indexed);
+    FuriString* key = furi_string_alloc();
+    uint32_t start = furi_get_tick();
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(file, file_name)) break;
+
+        // Worst case for rewind-and-read: every key is read from the top, last one first
+        bool error = false;
+        for(size_t i = BENCHMARK_KEY_COUNT; i > 0; i--) {
+            uint32_t value = 0;
+            furi_string_printf(key, "Key %zu", i - 1);
+            if(!flipper_format_rewind(file) ||
+               !flipper_format_read_uint32(file, furi_string_get_cstr(key), &value, 1) ||
+               value != i - 1) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+
+        // Index is dropped on update
+        uint32_t value = 12345;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_update_uint32(file, "Key 0", &value, 1)) break;
+        value = 0;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_uint32(file, "Key 1", &value, 1) || value != 1) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_uint32(file, "Key 0", &value, 1) || value != 12345) break;
+        if(flipper_format_read_uint32(file, "Missing key", &value, 1)) break;
+
+        result = true;
+    } while(false);
+
+    *time = furi_get_tick() - start;
+
+    furi_string_free(key);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
 MU_TEST(flipper_format_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -467,6 +609,9 @@ MU_TEST(flipper_format_read_test) {
     mu_assert(test_read(test_file_linux), "Read test error [Linux]");
     mu_assert(test_read(test_file_windows), "Read test error [Windows]");
     mu_assert(test_read(test_file_flipper), "Read test error [Flipper]");
+    mu_assert(test_read_ex(test_file_linux, true), "Read test error [Linux, buffered]");
+    mu_assert(test_read_ex(test_file_windows, true), "Read test error [Windows, buffered]");
+    mu_assert(test_read_ex(test_file_flipper, true), "Read test error [Flipper, buffered]");
 }
 
 MU_TEST(flipper_format_delete_test) {
@@ -528,6 +673,47 @@ MU_TEST(flipper_format_oddities_test) {
     mu_assert(test_read(test_file_linux), "Read test error [Oddities]");
 }
 
+MU_TEST(flipper_format_raw_benchmark_test) {
+    const char* file_name = TEST_DIR "ff_raw_benchmark.test";
+    uint32_t file_time = 0;
+    uint32_t buffered_time = 0;
+
+    mu_assert(test_write_raw_benchmark(file_name), "RAW write test error");
+    // File stream is read in small chunks, buffered stream is scanned in place
+    mu_assert(test_read_raw_benchmark(file_name, false, &file_time), "RAW read test error");
+    mu_assert(
+        test_read_raw_benchmark(file_name, true, &buffered_time),
+        "RAW read test error [buffered]");
+
+    printf(
+        "RAW_Data %d x %d values: file %lums, buffered %lums\r\n",
+        BENCHMARK_RAW_LINES,
+        BENCHMARK_RAW_SIZE,
+        file_time,
+        buffered_time);
+}
+
+MU_TEST(flipper_format_key_index_test) {
+    const char* file_name = TEST_DIR "ff_key_index.test";
+    FuriString* data = furi_string_alloc();
+    for(size_t i = 0; i < BENCHMARK_KEY_COUNT; i++) {
+        furi_string_cat_printf(data, "# Comment %zu\nKey %zu: %zu\n", i, i, i);
+    }
+    mu_assert(storage_write_string(file_name, furi_string_get_cstr(data)), "Write test error");
+    furi_string_free(data);
+
+    uint32_t scan_time = 0;
+    uint32_t index_time = 0;
+    mu_assert(test_read_key_index(file_name, false, &scan_time), "Read test error");
+    mu_assert(test_read_key_index(file_name, true, &index_time), "Read test error [indexed]");
+
+    printf(
+        "Read %d keys after rewind: scan %lums, index %lums\r\n",
+        BENCHMARK_KEY_COUNT,
+        scan_time,
+        index_time);
+}
+
 MU_TEST_SUITE(flipper_format) {
     tests_setup();
     MU_RUN_TEST(flipper_format_write_test);
@@ -542,6 +728,8 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
     MU_RUN_TEST(flipper_format_oddities_test);
+    MU_RUN_TEST(flipper_format_raw_benchmark_test);
+    MU_RUN_TEST(flipper_format_key_index_test);
     tests_teardown();
 }
 
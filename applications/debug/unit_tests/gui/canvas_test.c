@@ -0,0 +1,316 @@
+#include <furi.h>
+#include <gui/canvas_i.h>
+#include <u8g2_glue.h>
+
+#include "../minunit.h"
+
+#define CANVAS_TEST_BUFFER_SIZE (128 * 64 / 8)
+#define CANVAS_TEST_BLIT_CASES 20000
+#define CANVAS_TEST_BLIT_SIZE_MAX 40
+#define CANVAS_TEST_BENCHMARK_COUNT 64
+
+typedef struct {
+    u8g2_t u8g2;
+    uint8_t buffer[CANVAS_TEST_BUFFER_SIZE];
+} CanvasTestFrame;
+
+static uint32_t canvas_test_random_state;
+
+static uint32_t canvas_test_random(uint32_t range) {
+    // xorshift32, fixed seed keeps failures reproducible
+    canvas_test_random_state ^= canvas_test_random_state << 13;
+    canvas_test_random_state ^= canvas_test_random_state >> 17;
+    canvas_test_random_state ^= canvas_test_random_state << 5;
+    return canvas_test_random_state % range;
+}
+
+// Same layout as display frame buffer, but own memory and no display transport
+static void canvas_test_frame_init(CanvasTestFrame* frame) {
+    u8g2_Setup_st756x_flipper(&frame->u8g2, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+    // Setup points to the display frame buffer, replace it before anything is drawn
+    u8g2_SetupBuffer(&frame->u8g2, frame->buffer, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+}
+
+// Bitmap drawing as it was done before the blitter: one u8g2_DrawHVLine() per pixel
+static void canvas_test_draw_bitmap_int(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    bool mirror,
+    bool rotation,
+    const uint8_t* bitmap) {
+    u8g2_uint_t blen = (w + 7) >> 3;
+
+    if(rotation && !mirror) {
+        x += w + 1;
+    } else if(mirror && !rotation) {
+        y += h - 1;
+    }
+
+    while(h > 0) {
+        const uint8_t* b = bitmap;
+        uint16_t len = w;
+        uint16_t x0 = x;
+        uint16_t y0 = y;
+        uint8_t color = u8g2->draw_color;
+        uint8_t ncolor = (color == 0 ? 1 : 0);
+        uint8_t mask = 1;
+
+        while(len > 0) {
+            if(u8x8_pgm_read(b) & mask) {
+                u8g2->draw_color = color;
+                u8g2_DrawHVLine(u8g2, x0, y0, 1, 0);
+            } else if(u8g2->bitmap_transparency == 0) {
+                u8g2->draw_color = ncolor;
+                u8g2_DrawHVLine(u8g2, x0, y0, 1, 0);
+            }
+
+            if(rotation) {
+                y0++;
+            } else {
+                x0++;
+            }
+
+            mask <<= 1;
+            if(mask == 0) {
+                mask = 1;
+                b++;
+            }
+            len--;
+        }
+
+        u8g2->draw_color = color;
+        bitmap += blen;
+
+        if(mirror) {
+            if(rotation) {
+                x++;
+            } else {
+                y--;
+            }
+        } else {
+            if(rotation) {
+                x--;
+            } else {
+                y++;
+            }
+        }
+        h--;
+    }
+}
+
+static void canvas_test_draw_bitmap(
+    u8g2_t* u8g2,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap,
+    IconRotation rotation) {
+    if(u8g2_IsIntersection(u8g2, x, y, x + width, y + height) == 0) return;
+
+    bool mirror = (rotation == IconRotation180) || (rotation == IconRotation270);
+    bool rotate = (rotation == IconRotation90) || (rotation == IconRotation270);
+    canvas_test_draw_bitmap_int(u8g2, x, y, width, height, mirror, rotate, bitmap);
+}
+
+MU_TEST(test_canvas_blit_matches_per_pixel) {
+    CanvasTestFrame* expected = malloc(sizeof(CanvasTestFrame));
+    CanvasTestFrame* actual = malloc(sizeof(CanvasTestFrame));
+    const size_t bitmap_size_max = (CANVAS_TEST_BLIT_SIZE_MAX + 7) / 8 * CANVAS_TEST_BLIT_SIZE_MAX;
+    uint8_t* bitmap = malloc(bitmap_size_max);
+    canvas_test_frame_init(expected);
+    canvas_test_frame_init(actual);
+    canvas_test_random_state = 0x2545F491;
+    bool equal = true;
+
+    for(size_t i = 0; i < CANVAS_TEST_BLIT_CASES && equal; i++) {
+        // Size, position including negative and off screen, rotation and mirror
+        int32_t w = 1 + canvas_test_random(CANVAS_TEST_BLIT_SIZE_MAX);
+        int32_t h = 1 + canvas_test_random(CANVAS_TEST_BLIT_SIZE_MAX);
+        int32_t x = (int32_t)canvas_test_random(128 + 2 * CANVAS_TEST_BLIT_SIZE_MAX) -
+                    CANVAS_TEST_BLIT_SIZE_MAX;
+        int32_t y = (int32_t)canvas_test_random(64 + 2 * CANVAS_TEST_BLIT_SIZE_MAX) -
+                    CANVAS_TEST_BLIT_SIZE_MAX;
+        IconRotation rotation = canvas_test_random(4);
+        uint8_t color = canvas_test_random(3);
+        uint8_t transparent = canvas_test_random(2);
+
+        for(size_t j = 0; j < bitmap_size_max; j++) {
+            bitmap[j] = canvas_test_random(256);
+        }
+        for(size_t j = 0; j < CANVAS_TEST_BUFFER_SIZE; j++) {
+            expected->buffer[j] = canvas_test_random(256);
+        }
+        memcpy(actual->buffer, expected->buffer, CANVAS_TEST_BUFFER_SIZE);
+
+        // Canvas frames set clip window, half of the cases draw into a random one
+        CanvasTestFrame* frames[] = {expected, actual};
+        uint32_t clip = canvas_test_random(2);
+        u8g2_uint_t clip_x0 = canvas_test_random(128), clip_x1 = canvas_test_random(129);
+        u8g2_uint_t clip_y0 = canvas_test_random(64), clip_y1 = canvas_test_random(65);
+        for(size_t j = 0; j < COUNT_OF(frames); j++) {
+            u8g2_t* u8g2 = &frames[j]->u8g2;
+            if(clip) {
+                u8g2_SetClipWindow(u8g2, clip_x0, clip_y0, clip_x1, clip_y1);
+            } else {
+                u8g2_SetMaxClipWindow(u8g2);
+            }
+            u8g2_SetDrawColor(u8g2, color);
+            u8g2_SetBitmapMode(u8g2, transparent);
+        }
+
+        canvas_test_draw_bitmap(&expected->u8g2, x, y, w, h, bitmap, rotation);
+        canvas_draw_u8g2_bitmap(&actual->u8g2, x, y, w, h, bitmap, rotation);
+
+        equal = (memcmp(expected->buffer, actual->buffer, CANVAS_TEST_BUFFER_SIZE) == 0);
+        if(!equal) {
+            printf(
+                "Blit mismatch in case %zu: x %ld y %ld w %ld h %ld rot %d color %u transp %u "
+                "clip %lu %u,%u-%u,%u\r\n",
+                i,
+                x,
+                y,
+                w,
+                h,
+                rotation,
+                color,
+                transparent,
+                clip,
+                clip_x0,
+                clip_y0,
+                clip_x1,
+                clip_y1);
+        }
+    }
+
+    free(bitmap);
+    free(actual);
+    free(expected);
+
+    mu_assert(equal, "Blitter output differs from per pixel path");
+}
+
+MU_TEST(test_canvas_blit_benchmark) {
+    CanvasTestFrame* frame = malloc(sizeof(CanvasTestFrame));
+    uint8_t* bitmap = malloc(CANVAS_TEST_BUFFER_SIZE);
+    canvas_test_frame_init(frame);
+    canvas_test_random_state = 0x2545F491;
+    for(size_t i = 0; i < CANVAS_TEST_BUFFER_SIZE; i++) {
+        bitmap[i] = canvas_test_random(256);
+    }
+
+    const IconRotation rotations[] = {
+        IconRotation0, IconRotation90, IconRotation180, IconRotation270};
+    for(size_t i = 0; i < COUNT_OF(rotations); i++) {
+        // Full screen bitmap, rotated ones are 64x128 to stay on screen
+        bool rotated = (rotations[i] == IconRotation90) || (rotations[i] == IconRotation270);
+        size_t w = rotated ? 64 : 128;
+        size_t h = rotated ? 128 : 64;
+        int32_t x = (rotations[i] == IconRotation90) ? 62 : 0;
+
+        uint32_t pixel_ticks = furi_get_tick();
+        for(size_t j = 0; j < CANVAS_TEST_BENCHMARK_COUNT; j++) {
+            canvas_test_draw_bitmap(&frame->u8g2, x, 0, w, h, bitmap, rotations[i]);
+        }
+        pixel_ticks = furi_get_tick() - pixel_ticks;
+
+        uint32_t blit_ticks = furi_get_tick();
+        for(size_t j = 0; j < CANVAS_TEST_BENCHMARK_COUNT; j++) {
+            canvas_draw_u8g2_bitmap(&frame->u8g2, x, 0, w, h, bitmap, rotations[i]);
+        }
+        blit_ticks = furi_get_tick() - blit_ticks;
+
+        printf(
+            "Canvas bitmap %d x %zux%zu rotation %zu: per pixel %lu ms, blitter %lu ms\r\n",
+            CANVAS_TEST_BENCHMARK_COUNT,
+            w,
+            h,
+            i * 90,
+            pixel_ticks,
+            blit_ticks);
+    }
+
+    free(bitmap);
+    free(frame);
+}
+
+// Canvas the way canvas_init() makes it, drawing into own frame without display transport
+static Canvas* canvas_test_canvas_alloc(void) {
+    Canvas* canvas = malloc(sizeof(Canvas));
+    canvas->compress_icon = compress_icon_alloc();
+    canvas->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    CanvasCallbackPairArray_init(canvas->canvas_callback_pair);
+
+    u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+    u8g2_SetBufferPtr(&canvas->fb, malloc(CANVAS_TEST_BUFFER_SIZE));
+    canvas->orientation = CanvasOrientationHorizontal;
+    canvas->committed_buffer = malloc(CANVAS_TEST_BUFFER_SIZE);
+    canvas->commit_full = true;
+    canvas_reset(canvas);
+    return canvas;
+}
+
+static void canvas_test_canvas_free(Canvas* canvas) {
+    free(u8g2_GetBufferPtr(&canvas->fb));
+    canvas_free(canvas);
+}
+
+static void canvas_test_commit_callback(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    void* context) {
+    UNUSED(data);
+    UNUSED(size);
+    UNUSED(orientation);
+    uint32_t* callback_count = context;
+    (*callback_count)++;
+}
+
+MU_TEST(test_canvas_commit_identical_frames) {
+    Canvas* canvas = canvas_test_canvas_alloc();
+    uint32_t callback_count = 0;
+    canvas_add_framebuffer_callback(canvas, canvas_test_commit_callback, &callback_count);
+
+    // First frame is sent in full, then the same frame again and again
+    canvas_draw_box(canvas, 10, 10, 20, 20);
+    for(size_t i = 0; i < 4; i++) {
+        canvas_commit(canvas);
+    }
+    CanvasCommitStats stats;
+    canvas_get_commit_stats(canvas, &stats);
+    uint32_t identical_callback_count = callback_count;
+
+    // Change within one page
+    canvas_draw_dot(canvas, 100, 60);
+    canvas_commit(canvas);
+    CanvasCommitStats changed_stats;
+    canvas_get_commit_stats(canvas, &changed_stats);
+
+    canvas_remove_framebuffer_callback(canvas, canvas_test_commit_callback, &callback_count);
+    canvas_test_canvas_free(canvas);
+
+    mu_assert_int_eq(4, stats.commits);
+    mu_assert_int_eq(3, stats.skipped);
+    mu_assert_int_eq(8, stats.pages);
+    mu_assert_int_eq(stats.commits, identical_callback_count);
+
+    mu_assert_int_eq(5, changed_stats.commits);
+    mu_assert_int_eq(3, changed_stats.skipped);
+    mu_assert_int_eq(9, changed_stats.pages);
+    mu_assert_int_eq(changed_stats.commits, callback_count);
+}
+
+MU_TEST_SUITE(test_canvas_suite) {
+    MU_RUN_TEST(test_canvas_blit_matches_per_pixel);
+    MU_RUN_TEST(test_canvas_blit_benchmark);
+    MU_RUN_TEST(test_canvas_commit_identical_frames);
+}
+
+int run_minunit_test_canvas(void) {
+    MU_RUN_SUITE(test_canvas_suite);
+    return MU_EXIT_CODE;
+}
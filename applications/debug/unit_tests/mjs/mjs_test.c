@@ -0,0 +1,203 @@
+#include <furi.h>
+#include <mjs_core_public.h>
+#include <mjs_exec_public.h>
+#include <mjs_object_public.h>
+#include <mjs_primitive_public.h>
+#include <mjs_string_public.h>
+
+#include "../minunit.h"
+
+static struct mjs* test_mjs;
+
+// mJS has no delete operator, scripts remove properties with del(obj, name)
+static void mjs_test_del(struct mjs* mjs) {
+    mjs_val_t name = mjs_arg(mjs, 1);
+    mjs_del(mjs, mjs_arg(mjs, 0), mjs_get_cstring(mjs, &name), ~0);
+    mjs_return(mjs, MJS_UNDEFINED);
+}
+
+static void mjs_test_setup(void) {
+    test_mjs = mjs_create(NULL);
+    mjs_set(
+        test_mjs,
+        mjs_get_global(test_mjs),
+        "del",
+        ~0,
+        mjs_mk_foreign_func(test_mjs, (mjs_func_ptr_t)mjs_test_del));
+}
+
+static void mjs_test_teardown(void) {
+    mjs_destroy(test_mjs);
+    test_mjs = NULL;
+}
+
+static bool mjs_test_exec(const char* script, mjs_val_t* result) {
+    mjs_err_t err = mjs_exec(test_mjs, script, result);
+    if(err != MJS_OK) {
+        printf("mJS error %d: %s\r\n", err, mjs_strerror(test_mjs, err));
+    }
+    return err == MJS_OK;
+}
+
+MU_TEST(test_mjs_property_order_and_prototype) {
+    // Same lookup site sees objects with different layouts and an inherited property
+    const char* script =
+        "let objs = [{longname: 1, b: 2}, {b: 3, longname: 4}, Object.create({longname: 5})];"
+        "let t = 0;"
+        "for(let k = 0; k < 3; k++) {"
+        "  for(let i = 0; i < 3; i++) { t = t * 3 + objs[i].longname; }"
+        "}"
+        "t;";
+    mjs_val_t result;
+    mu_assert(mjs_test_exec(script, &result), "Script failed");
+    mu_assert_double_eq(19682, mjs_get_double(test_mjs, result));
+}
+
+MU_TEST(test_mjs_computed_key) {
+    const char* script = "let o = {longname: 10, another: 20};"
+                         "let keys = ['longname', 'another', 'longname', 'another'];"
+                         "let r = 0;"
+                         "for(let i = 0; i < 4; i++) { r = r * 100 + o[keys[i]]; }"
+                         "r;";
+    mjs_val_t result;
+    mu_assert(mjs_test_exec(script, &result), "Script failed");
+    mu_assert_double_eq(10201020, mjs_get_double(test_mjs, result));
+}
+
+MU_TEST(test_mjs_delete_and_readd) {
+    const char* script = "let o = {longname: 10, another: 20};"
+                         "let r = [];"
+                         "for(let i = 0; i < 3; i++) {"
+                         "  r.push(o.longname);"
+                         "  if(i === 0) { del(o, 'longname'); }"
+                         "  if(i === 1) { o.longname = 33; }"
+                         "}"
+                         "r[0] === 10 && typeof r[1] === 'undefined' && r[2] === 33 &&"
+                         "o.another === 20;";
+    mjs_val_t result;
+    mu_assert(mjs_test_exec(script, &result), "Script failed");
+    mu_assert(mjs_get_bool(test_mjs, result), "Deleted property served from cache");
+}
+
+MU_TEST(test_mjs_special_property) {
+    // apply is resolved by interpreter before own properties
+    const char* script = "let o = {longname: 10, apply: 7};"
+                         "let r = 0;"
+                         "for(let i = 0; i < 3; i++) { r = r + o.longname; }"
+                         "r === 30 && typeof o.apply === 'foreign_ptr';";
+    mjs_val_t result;
+    mu_assert(mjs_test_exec(script, &result), "Script failed");
+    mu_assert(mjs_get_bool(test_mjs, result), "Special property changed");
+}
+
+MU_TEST(test_mjs_own_property_shadows_prototype) {
+    const char* script = "let p = Object.create({inherited: 1});"
+                         "let r = 0;"
+                         "for(let i = 0; i < 3; i++) {"
+                         "  r = r * 10 + p.inherited;"
+                         "  if(i === 0) { p.inherited = 2; }"
+                         "}"
+                         "r;";
+    mjs_val_t result;
+    mu_assert(mjs_test_exec(script, &result), "Script failed");
+    mu_assert_double_eq(122, mjs_get_double(test_mjs, result));
+}
+
+MU_TEST(test_mjs_gc) {
+    // Objects and strings die every iteration, collected while lookup sites remember them
+    const char* script = "let g = 0;"
+                         "for(let i = 0; i < 3000; i++) {"
+                         "  let tmp = {vvvvvvv: i, pad: 'xxxxxxxxxxxx' + 'yy'};"
+                         "  g = g + tmp.vvvvvvv;"
+                         "  if(i % 500 === 0) { gc(true); }"
+                         "}"
+                         "let q = {counter: 0};"
+                         "for(let i = 0; i < 5; i++) { q.counter = q.counter + i; }"
+                         "g + q.counter;";
+    mjs_val_t result;
+    mu_assert(mjs_test_exec(script, &result), "Script failed");
+    mu_assert_double_eq(4498510, mjs_get_double(test_mjs, result));
+}
+
+MU_TEST(test_mjs_function_argument) {
+    const char* script = "function f(x) { return x.field1 + x.field2; }"
+                         "f({field1: 1, field2: 2}) + f({field2: 30, field1: 40});";
+    mjs_val_t result;
+    mu_assert(mjs_test_exec(script, &result), "Script failed");
+    mu_assert_double_eq(73, mjs_get_double(test_mjs, result));
+}
+
+typedef struct {
+    const char* name;
+    const char* script;
+    double result;
+} MjsTestBenchmark;
+
+static const MjsTestBenchmark mjs_test_benchmarks[] = {
+    {
+        .name = "property",
+        .script = "let cfg = {field00: 0, field01: 1, field02: 2, field03: 3, field04: 4,"
+                  "  field05: 5, field06: 6, field07: 7, field08: 8, field09: 9, field10: 10,"
+                  "  field11: 11, field12: 12, field13: 13, field14: 14, field15: 15};"
+                  "function sum(c) { return c.field00 + c.field05 + c.field10 + c.field15; }"
+                  "let s = 0; for(let i = 0; i < 2000; i++) { s = s + sum(cfg); } s;",
+        .result = 60000,
+    },
+    {
+        .name = "variable",
+        .script = "let alpha = 1; let beta = 2; let gamma = 3;"
+                  "let s = 0; for(let i = 0; i < 2000; i++) { s = s + alpha + beta + gamma; } s;",
+        .result = 12000,
+    },
+    {
+        .name = "array",
+        .script = "let a = []; for(let i = 0; i < 100; i++) { a.push(i); }"
+                  "let s = 0; for(let k = 0; k < 10; k++) {"
+                  "  for(let i = 0; i < 100; i++) { s = s + a[i]; }"
+                  "} s;",
+        .result = 49500,
+    },
+    {
+        .name = "string",
+        .script = "let s = ''; let n = 0; for(let i = 0; i < 2000; i++) {"
+                  "  s = s + 'x'; if(s.length > 200) { n = n + s.length; s = ''; }"
+                  "} n;",
+        .result = 1809,
+    },
+};
+
+MU_TEST(test_mjs_benchmark) {
+    for(size_t i = 0; i < COUNT_OF(mjs_test_benchmarks); i++) {
+        const MjsTestBenchmark* benchmark = &mjs_test_benchmarks[i];
+        struct mjs* instance = mjs_create(NULL);
+        mjs_val_t result;
+
+        uint32_t ticks = furi_get_tick();
+        mjs_err_t err = mjs_exec(instance, benchmark->script, &result);
+        ticks = furi_get_tick() - ticks;
+        double value = mjs_get_double(instance, result);
+        mjs_destroy(instance);
+
+        printf("mJS %s: %lu ms\r\n", benchmark->name, ticks);
+        mu_assert_int_eq(MJS_OK, err);
+        mu_assert_double_eq(benchmark->result, value);
+    }
+}
+
+MU_TEST_SUITE(test_mjs_suite) {
+    MU_SUITE_CONFIGURE(&mjs_test_setup, &mjs_test_teardown);
+
+    MU_RUN_TEST(test_mjs_property_order_and_prototype);
+    MU_RUN_TEST(test_mjs_computed_key);
+    MU_RUN_TEST(test_mjs_delete_and_readd);
+    MU_RUN_TEST(test_mjs_special_property);
+    MU_RUN_TEST(test_mjs_own_property_shadows_prototype);
+    MU_RUN_TEST(test_mjs_gc);
+    MU_RUN_TEST(test_mjs_function_argument);
+    MU_RUN_TEST(test_mjs_benchmark);
+}
+
+int run_minunit_test_mjs(void) {
+    MU_RUN_SUITE(test_mjs_suite);
+    return MU_EXIT_CODE;
+}
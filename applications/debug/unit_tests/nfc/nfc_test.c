@@ -18,12 +18,22 @@
 #include <toolbox/keys_dict.h>
 #include <nfc/nfc.h>
 
+#include <flipper_application/flipper_application.h>
+#include <loader/firmware_api/firmware_api.h>
+#include "../../../main/nfc/plugins/supported_cards/nfc_supported_card_plugin.h"
+
 #include "../minunit.h"
 
 #define TAG "NfcTest"
 
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_CACHE_PATH EXT_PATH("unit_tests/mf_dict.nfc.cache")
+#define NFC_TEST_DICT_CACHE_KEY_NUM (200)
+#define NFC_TEST_DICT_IMPORT_KEY_NUM (5000)
+#define NFC_TEST_DICT_IMPORT_DUPLICATE_STEP (10)
+#define NFC_TEST_MICROEL_PLUGIN_PATH EXT_PATH("apps_data/nfc/plugins/microel_parser.fal")
+#define NFC_TEST_MICROEL_UID_LEN (4)
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
@@ -627,6 +637,250 @@ MU_TEST(mf_classic_dict_test) {
         "Remove test dict failed");
 }
 
+static bool mf_classic_dict_cache_check(const MfClassicKey* key_arr_ref, size_t key_num) {
+    KeysDict* dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+    bool keys_match = keys_dict_get_total_keys(dict) == key_num;
+
+    // Two passes to check rewind too
+    for(size_t pass = 0; pass < 2 && keys_match; pass++) {
+        MfClassicKey key_dut = {};
+        size_t key_idx = 0;
+        keys_dict_rewind(dict);
+        while(keys_match && keys_dict_get_next_key(dict, key_dut.data, sizeof(MfClassicKey))) {
+            keys_match = (key_idx < key_num) &&
+                         (memcmp(key_arr_ref[key_idx].data, key_dut.data, sizeof(MfClassicKey)) ==
+                          0);
+            key_idx++;
+        }
+        keys_match = keys_match && key_idx == key_num;
+    }
+
+    keys_dict_free(dict);
+    return keys_match;
+}
+
+MU_TEST(mf_classic_dict_cache_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH);
+    storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_CACHE_PATH);
+
+    KeysDict* dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    MfClassicKey* key_arr_ref = malloc((NFC_TEST_DICT_CACHE_KEY_NUM + 1) * sizeof(MfClassicKey));
+    for(size_t i = 0; i < NFC_TEST_DICT_CACHE_KEY_NUM + 1; i++) {
+        furi_hal_random_fill_buf(key_arr_ref[i].data, sizeof(MfClassicKey));
+    }
+    for(size_t i = 0; i < NFC_TEST_DICT_CACHE_KEY_NUM; i++) {
+        keys_dict_add_key(dict, key_arr_ref[i].data, sizeof(MfClassicKey));
+    }
+    keys_dict_free(dict);
+    mu_assert(
+        !storage_file_exists(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_CACHE_PATH),
+        "Cache created for writable dictionary");
+
+    // First read-only open creates cache, second one reads from it
+    mu_assert(
+        mf_classic_dict_cache_check(key_arr_ref, NFC_TEST_DICT_CACHE_KEY_NUM),
+        "Keys mismatch on cache creation");
+    mu_assert(
+        storage_file_exists(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_CACHE_PATH),
+        "Cache not created");
+    mu_assert(
+        mf_classic_dict_cache_check(key_arr_ref, NFC_TEST_DICT_CACHE_KEY_NUM),
+        "Keys mismatch in cache");
+
+    // Cache is read, not rebuilt: a key changed in cache only is returned as is
+    MfClassicKey* key_arr_cached = malloc(NFC_TEST_DICT_CACHE_KEY_NUM * sizeof(MfClassicKey));
+    memcpy(key_arr_cached, key_arr_ref, NFC_TEST_DICT_CACHE_KEY_NUM * sizeof(MfClassicKey));
+    MfClassicKey* key_last = &key_arr_cached[NFC_TEST_DICT_CACHE_KEY_NUM - 1];
+    for(size_t i = 0; i < sizeof(MfClassicKey); i++) {
+        key_last->data[i] ^= 0xFF;
+    }
+    File* cache_file = storage_file_alloc(storage);
+    mu_assert(
+        storage_file_open(
+            cache_file,
+            NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_CACHE_PATH,
+            FSAM_READ_WRITE,
+            FSOM_OPEN_EXISTING),
+        "Open cache failed");
+    bool key_written =
+        storage_file_seek(
+            cache_file, storage_file_size(cache_file) - sizeof(MfClassicKey), true) &&
+        storage_file_write(cache_file, key_last->data, sizeof(MfClassicKey)) ==
+            sizeof(MfClassicKey);
+    storage_file_free(cache_file);
+    mu_assert(key_written, "Write cache failed");
+    mu_assert(
+        mf_classic_dict_cache_check(key_arr_cached, NFC_TEST_DICT_CACHE_KEY_NUM),
+        "Cache rebuilt instead of read");
+    free(key_arr_cached);
+
+    // Modification drops cache
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+    MfClassicKey* key_new = &key_arr_ref[NFC_TEST_DICT_CACHE_KEY_NUM];
+    mu_assert(keys_dict_add_key(dict, key_new->data, sizeof(MfClassicKey)), "add key failed");
+    keys_dict_free(dict);
+    mu_assert(
+        mf_classic_dict_cache_check(key_arr_ref, NFC_TEST_DICT_CACHE_KEY_NUM + 1),
+        "Keys mismatch after cache invalidation");
+
+    free(key_arr_ref);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
+        "Remove test dict failed");
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_CACHE_PATH),
+        "Remove test dict cache failed");
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(mf_classic_dict_import_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(storage_common_stat(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) == FSE_OK) {
+        mu_assert(
+            storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
+            "Remove test dict failed");
+    }
+
+    KeysDict* dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+
+    // Import the same way the add key scene does: check presence, then add
+    MfClassicKey* key_arr_ref = malloc(NFC_TEST_DICT_IMPORT_KEY_NUM * sizeof(MfClassicKey));
+    size_t unique_keys = 0;
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < NFC_TEST_DICT_IMPORT_KEY_NUM; i++) {
+        if(i % NFC_TEST_DICT_IMPORT_DUPLICATE_STEP == NFC_TEST_DICT_IMPORT_DUPLICATE_STEP - 1) {
+            key_arr_ref[i] = key_arr_ref[i / 2];
+        } else {
+            furi_hal_random_fill_buf(key_arr_ref[i].data, sizeof(MfClassicKey));
+        }
+
+        if(!keys_dict_is_key_present(dict, key_arr_ref[i].data, sizeof(MfClassicKey))) {
+            mu_assert(
+                keys_dict_add_key(dict, key_arr_ref[i].data, sizeof(MfClassicKey)),
+                "add key failed");
+            unique_keys++;
+        }
+    }
+    uint32_t time = furi_get_tick() - start;
+    printf("Imported %d keys in %lu ms\r\n", NFC_TEST_DICT_IMPORT_KEY_NUM, time);
+
+    mu_assert(
+        keys_dict_get_total_keys(dict) == unique_keys, "keys_dict_get_total_keys() failed");
+    for(size_t i = 0; i < NFC_TEST_DICT_IMPORT_KEY_NUM; i++) {
+        mu_assert(
+            keys_dict_is_key_present(dict, key_arr_ref[i].data, sizeof(MfClassicKey)),
+            "keys_dict_is_key_present() failed");
+    }
+
+    keys_dict_free(dict);
+    free(key_arr_ref);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
+        "Remove test dict failed");
+    furi_record_close(RECORD_STORAGE);
+}
+
+// Key derivation of Microel cards, used by sectors 0 and 1
+static void nfc_test_microel_keys(const uint8_t* uid, MfClassicKey* key_a, MfClassicKey* key_b) {
+    const uint8_t xor_key[] = {0x01, 0x92, 0xA7, 0x75, 0x2B, 0xF9};
+    uint8_t sum = 0;
+    for(size_t i = 0; i < NFC_TEST_MICROEL_UID_LEN; i++) {
+        sum += uid[i];
+    }
+    if(sum % 2) sum += 2;
+
+    uint8_t first = (sum ^ xor_key[0]) >> 4;
+    uint8_t mask = 0x00;
+    if(first == 0x2 || first == 0x3 || first == 0xA || first == 0xB) {
+        mask = 0x40;
+    } else if(first == 0x6 || first == 0x7 || first == 0xE || first == 0xF) {
+        mask = 0xC0;
+    }
+
+    for(size_t i = 0; i < sizeof(key_a->data); i++) {
+        key_a->data[i] = sum ^ xor_key[i] ^ mask;
+        key_b->data[i] = key_a->data[i] ^ 0xFF;
+    }
+}
+
+static bool
+    nfc_test_microel_plugin_read(const NfcSupportedCardsPlugin* plugin, const uint8_t* uid) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_4b, nfc_device);
+    nfc_device_set_uid(nfc_device, uid, NFC_TEST_MICROEL_UID_LEN);
+
+    MfClassicData* mfc_data = mf_classic_alloc();
+    nfc_device_copy_data(nfc_device, NfcProtocolMfClassic, mfc_data);
+    MfClassicKey key_a = {};
+    MfClassicKey key_b = {};
+    nfc_test_microel_keys(uid, &key_a, &key_b);
+    for(uint8_t sector = 0; sector < 2; sector++) {
+        MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(mfc_data, sector);
+        sec_tr->key_a = key_a;
+        sec_tr->key_b = key_b;
+    }
+
+    NfcListener* mfc_listener = nfc_listener_alloc(listener, NfcProtocolMfClassic, mfc_data);
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    bool read = plugin->read(poller, nfc_device);
+
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+
+    mf_classic_free(mfc_data);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    return read;
+}
+
+MU_TEST(supported_card_plugin_reread_test) {
+    // Same loaded plugin reads cards whose keys differ, as resident plugins of NFC app do
+    const uint8_t uid_first[NFC_TEST_MICROEL_UID_LEN] = {0x04, 0x11, 0x22, 0x33};
+    const uint8_t uid_second[NFC_TEST_MICROEL_UID_LEN] = {0x04, 0x11, 0x22, 0x44};
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperApplication* app =
+        flipper_application_alloc(storage, firmware_api_unit_tests_perfect_interface);
+    const NfcSupportedCardsPlugin* plugin = NULL;
+    do {
+        if(flipper_application_preload(app, NFC_TEST_MICROEL_PLUGIN_PATH) !=
+           FlipperApplicationPreloadStatusSuccess)
+            break;
+        if(flipper_application_map_to_memory(app) != FlipperApplicationLoadStatusSuccess) break;
+        const FlipperAppPluginDescriptor* descriptor =
+            flipper_application_plugin_get_descriptor(app);
+        if(descriptor == NULL) break;
+        if(strcmp(descriptor->appid, NFC_SUPPORTED_CARD_PLUGIN_APP_ID) != 0) break;
+        plugin = descriptor->entry_point;
+    } while(false);
+
+    bool first_read = plugin && nfc_test_microel_plugin_read(plugin, uid_first);
+    bool second_read = plugin && nfc_test_microel_plugin_read(plugin, uid_second);
+    bool first_reread = plugin && nfc_test_microel_plugin_read(plugin, uid_first);
+
+    flipper_application_free(app);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(plugin, "Failed to load Microel plugin");
+    mu_assert(first_read, "First card not read");
+    mu_assert(second_read, "Second card read with keys of the first one");
+    mu_assert(first_reread, "First card not read again");
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
@@ -667,6 +921,10 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_dict_cache_test);
+    MU_RUN_TEST(mf_classic_dict_import_test);
+
+    MU_RUN_TEST(supported_card_plugin_reread_test);
 
     nfc_test_free();
 }
@@ -12,6 +12,7 @@
 #include <storage/storage.h>
 #include <loader/loader.h>
 #include <storage/filesystem_api_defines.h>
+#include <gui/gui_i.h>
 
 #include <lib/toolbox/md5_calc.h>
 #include <lib/toolbox/path.h>
@@ -24,6 +25,7 @@
 #include <pb_encode.h>
 #include <pb_decode.h>
 #include <storage.pb.h>
+#include <gui.pb.h>
 #include <flipper.pb.h>
 
 LIST_DEF(MsgList, PB_Main, M_POD_OPLIST)
@@ -54,6 +56,7 @@ static RpcSessionContext rpc_session[TEST_RPC_SESSIONS];
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME EXT_PATH("unit_tests_tmp")
 #define MD5SUM_SIZE 16
+#define RPC_GUI_TEST_KEYFRAME_INTERVAL_MS 1000 // have to be exact as in rpc_gui.c
 
 #define PING_REQUEST 0
 #define PING_RESPONSE 1
@@ -1482,11 +1485,247 @@ MU_TEST(test_system_protobuf_version) {
     test_rpc_free_msg_list(expected_msg_list);
 }
 
+#define BENCHMARK_SEND_COUNT 256
+
+static struct {
+    uint8_t* expected;
+    size_t expected_size;
+    size_t sent_size;
+    size_t sent_count;
+    bool equal;
+} test_rpc_send;
+
+static void test_rpc_send_bytes_callback(void* ctx, uint8_t* got_bytes, size_t got_size) {
+    UNUSED(ctx);
+    test_rpc_send.sent_size += got_size;
+    test_rpc_send.sent_count++;
+    if(test_rpc_send.expected) {
+        test_rpc_send.equal = (got_size == test_rpc_send.expected_size) &&
+                              !memcmp(got_bytes, test_rpc_send.expected, got_size);
+    }
+}
+
+static void test_rpc_fill_read_response(PB_Main* message, size_t data_size) {
+    test_rpc_fill_basic_message(message, PB_Main_storage_read_response_tag, ++command_id);
+    message->content.storage_read_response.has_file = true;
+    PB_Storage_File* file = &message->content.storage_read_response.file;
+    file->data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(data_size));
+    file->data->size = data_size;
+    for(size_t i = 0; i < data_size; i++) {
+        file->data->bytes[i] = i * 7;
+    }
+}
+
+// Encoding as it was done before the session TX buffer: sizing pass, allocation, encoding
+static uint8_t* test_rpc_encode_delimited(PB_Main* message, size_t* size) {
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    furi_check(pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED));
+
+    uint8_t* buffer = malloc(ostream.bytes_written);
+    *size = ostream.bytes_written;
+    ostream = pb_ostream_from_buffer(buffer, *size);
+    furi_check(pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED));
+
+    return buffer;
+}
+
+MU_TEST(test_rpc_send_encoding) {
+    rpc_session_set_send_bytes_callback(rpc_session[0].session, test_rpc_send_bytes_callback);
+
+    // Fits into session buffer, needs buffer growth, fits into buffer again
+    const size_t data_sizes[] = {0, 1, 127, 128, MAX_DATA_SIZE, 4000, 16, 3000};
+    for(size_t i = 0; i < COUNT_OF(data_sizes); i++) {
+        PB_Main message = {0};
+        test_rpc_fill_read_response(&message, data_sizes[i]);
+        test_rpc_send.expected = test_rpc_encode_delimited(&message, &test_rpc_send.expected_size);
+        test_rpc_send.equal = false;
+
+        rpc_send_and_release(rpc_session[0].session, &message);
+        mu_check(test_rpc_send.equal);
+
+        free(test_rpc_send.expected);
+        test_rpc_send.expected = NULL;
+    }
+
+    rpc_session_set_send_bytes_callback(rpc_session[0].session, output_bytes_callback);
+}
+
+MU_TEST(test_rpc_send_benchmark) {
+    PB_Main message = {0};
+    test_rpc_fill_read_response(&message, MAX_DATA_SIZE);
+    rpc_session_set_send_bytes_callback(rpc_session[0].session, test_rpc_send_bytes_callback);
+    memset(&test_rpc_send, 0, sizeof(test_rpc_send));
+
+    uint32_t legacy_ticks = furi_get_tick();
+    size_t legacy_size = 0;
+    for(size_t i = 0; i < BENCHMARK_SEND_COUNT; i++) {
+        size_t size = 0;
+        uint8_t* buffer = test_rpc_encode_delimited(&message, &size);
+        test_rpc_send_bytes_callback(NULL, buffer, size);
+        legacy_size += size;
+        free(buffer);
+    }
+    legacy_ticks = furi_get_tick() - legacy_ticks;
+    mu_assert_int_eq(BENCHMARK_SEND_COUNT, test_rpc_send.sent_count);
+
+    test_rpc_send.sent_size = 0;
+    test_rpc_send.sent_count = 0;
+    uint32_t send_ticks = furi_get_tick();
+    for(size_t i = 0; i < BENCHMARK_SEND_COUNT; i++) {
+        rpc_send(rpc_session[0].session, &message);
+    }
+    send_ticks = furi_get_tick() - send_ticks;
+    mu_assert_int_eq(BENCHMARK_SEND_COUNT, test_rpc_send.sent_count);
+    mu_assert_int_eq(legacy_size, test_rpc_send.sent_size);
+
+    printf(
+        "RPC send %d x %u bytes: legacy encode %lu ms, session buffer %lu ms\r\n",
+        BENCHMARK_SEND_COUNT,
+        MAX_DATA_SIZE,
+        legacy_ticks,
+        send_ticks);
+
+    rpc_session_set_send_bytes_callback(rpc_session[0].session, output_bytes_callback);
+    pb_release(&PB_Main_msg, &message);
+}
+
 MU_TEST_SUITE(test_rpc_system) {
     MU_SUITE_CONFIGURE(&test_rpc_setup, &test_rpc_teardown);
 
     MU_RUN_TEST(test_ping);
     MU_RUN_TEST(test_system_protobuf_version);
+    MU_RUN_TEST(test_rpc_send_encoding);
+    MU_RUN_TEST(test_rpc_send_benchmark);
+}
+
+#define BENCHMARK_READ_FILE_SIZE (2 * 1024 * 1024)
+#define BENCHMARK_READ_PATTERN(offset) ((offset) % 251)
+
+static struct {
+    uint32_t command_id;
+    size_t offset;
+    size_t messages;
+    size_t max_chunk;
+    bool valid;
+    FuriSemaphore* done;
+} test_rpc_read;
+
+// Loopback transport: every rpc_send delivers one delimited message
+static void test_rpc_read_bytes_callback(void* ctx, uint8_t* got_bytes, size_t got_size) {
+    UNUSED(ctx);
+    pb_istream_t istream = pb_istream_from_buffer(got_bytes, got_size);
+    PB_Main result = {.cb_content.funcs.decode = NULL};
+
+    bool valid = pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED) &&
+                 (result.command_id == test_rpc_read.command_id) &&
+                 (result.command_status == PB_CommandStatus_OK) &&
+                 (result.which_content == PB_Main_storage_read_response_tag) &&
+                 result.content.storage_read_response.file.data;
+
+    if(valid) {
+        pb_bytes_array_t* data = result.content.storage_read_response.file.data;
+        for(size_t i = 0; valid && (i < data->size); i++) {
+            valid = (data->bytes[i] == BENCHMARK_READ_PATTERN(test_rpc_read.offset + i));
+        }
+        test_rpc_read.offset += data->size;
+        test_rpc_read.max_chunk = MAX(test_rpc_read.max_chunk, data->size);
+    }
+
+    test_rpc_read.valid &= valid;
+    test_rpc_read.messages++;
+    if(!valid || !result.has_next) {
+        furi_semaphore_release(test_rpc_read.done);
+    }
+
+    pb_release(&PB_Main_msg, &result);
+}
+
+static void test_rpc_read_terminated_callback(void* context) {
+    furi_semaphore_release(context);
+}
+
+static void test_rpc_read_run(RpcOwner owner, const char* path) {
+    RpcSession* session = NULL;
+    for(int i = 0; !session && (i < 10000); ++i) {
+        session = rpc_session_open(rpc, owner);
+        furi_delay_tick(1);
+    }
+    furi_check(session);
+
+    FuriSemaphore* terminated = furi_semaphore_alloc(1, 0);
+    rpc_session_set_context(session, terminated);
+    rpc_session_set_send_bytes_callback(session, test_rpc_read_bytes_callback);
+    rpc_session_set_terminated_callback(session, test_rpc_read_terminated_callback);
+
+    memset(&test_rpc_read, 0, sizeof(test_rpc_read));
+    test_rpc_read.command_id = ++command_id;
+    test_rpc_read.valid = true;
+    test_rpc_read.done = furi_semaphore_alloc(1, 0);
+
+    PB_Main request = {0};
+    test_rpc_create_simple_message(
+        &request, PB_Main_storage_read_request_tag, path, test_rpc_read.command_id);
+
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    furi_check(pb_encode_ex(&ostream, &PB_Main_msg, &request, PB_ENCODE_DELIMITED));
+    size_t size = ostream.bytes_written;
+    uint8_t* buffer = malloc(size);
+    ostream = pb_ostream_from_buffer(buffer, size);
+    furi_check(pb_encode_ex(&ostream, &PB_Main_msg, &request, PB_ENCODE_DELIMITED));
+    pb_release(&PB_Main_msg, &request);
+
+    uint32_t ticks = furi_get_tick();
+    for(size_t sent = 0; sent < size;) {
+        size_t bytes_sent = rpc_session_feed(session, buffer + sent, size - sent, 1000);
+        furi_check(bytes_sent);
+        sent += bytes_sent;
+    }
+    mu_check(furi_semaphore_acquire(test_rpc_read.done, 30000) == FuriStatusOk);
+    ticks = furi_get_tick() - ticks;
+
+    mu_check(test_rpc_read.valid);
+    mu_assert_int_eq(BENCHMARK_READ_FILE_SIZE, test_rpc_read.offset);
+    printf(
+        "RPC read %d bytes, owner %d: %lu ms, %zu messages of up to %zu bytes\r\n",
+        BENCHMARK_READ_FILE_SIZE,
+        owner,
+        ticks,
+        test_rpc_read.messages,
+        test_rpc_read.max_chunk);
+
+    free(buffer);
+    furi_semaphore_free(test_rpc_read.done);
+    test_rpc_read.done = NULL;
+
+    rpc_session_close(session);
+    furi_check(furi_semaphore_acquire(terminated, FuriWaitForever) == FuriStatusOk);
+    furi_semaphore_free(terminated);
+}
+
+MU_TEST(test_storage_read_large) {
+    const char* path = TEST_DIR "large.bin";
+    Storage* fs_api = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(fs_api);
+    uint8_t* buffer = malloc(4096);
+
+    furi_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t offset = 0; offset < BENCHMARK_READ_FILE_SIZE; offset += 4096) {
+        for(size_t i = 0; i < 4096; i++) {
+            buffer[i] = BENCHMARK_READ_PATTERN(offset + i);
+        }
+        furi_check(storage_file_write(file, buffer, 4096) == 4096);
+    }
+    storage_file_close(file);
+
+    free(buffer);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    // Unknown transport keeps MAX_DATA_SIZE chunks, USB gets big ones
+    test_rpc_read_run(RpcOwnerUnknown, path);
+    mu_assert_int_eq(MAX_DATA_SIZE, test_rpc_read.max_chunk);
+    test_rpc_read_run(RpcOwnerUsb, path);
+    mu_check(test_rpc_read.max_chunk >= MAX_DATA_SIZE);
 }
 
 MU_TEST_SUITE(test_rpc_storage) {
@@ -1505,11 +1744,93 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_mkdir);
     MU_RUN_TEST(test_storage_md5sum);
     MU_RUN_TEST(test_storage_rename);
+    MU_RUN_TEST(test_storage_read_large);
 
     DISABLE_TEST(MU_RUN_TEST(test_storage_interrupt_continuous_same_system););
     MU_RUN_TEST(test_storage_interrupt_continuous_another_system);
 }
 
+static void test_rpc_gui_request(uint16_t tag, uint32_t command_id) {
+    PB_Main request = {0};
+    test_rpc_fill_basic_message(&request, tag, command_id);
+    test_rpc_encode_and_feed_one(&request, 0);
+}
+
+// Decode next message sent to session 0, false if nothing came in time
+static bool test_rpc_gui_receive(PB_Main* message, uint32_t timeout) {
+    rpc_session[0].timeout = furi_get_tick() + timeout;
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = &rpc_session[0],
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    memset(message, 0, sizeof(PB_Main));
+    return pb_decode_ex(&istream, &PB_Main_msg, message, PB_DECODE_DELIMITED);
+}
+
+static bool test_rpc_gui_receive_frame(const uint8_t* expected, size_t size, uint32_t timeout) {
+    PB_Main message;
+    if(!test_rpc_gui_receive(&message, timeout)) return false;
+
+    const pb_bytes_array_t* data = message.content.gui_screen_frame.data;
+    bool result = (message.which_content == PB_Main_gui_screen_frame_tag) && data &&
+                  (data->size == size) && (memcmp(data->bytes, expected, size) == 0);
+    pb_release(&PB_Main_msg, &message);
+    return result;
+}
+
+MU_TEST(test_gui_screen_stream_static_screen) {
+    Gui* gui = furi_record_open(RECORD_GUI);
+    size_t frame_size = gui_get_framebuffer_size(gui);
+    uint8_t* expected = malloc(frame_size);
+    CanvasOrientation orientation;
+    PB_Main message;
+    bool started = false, first_frame = false, keyframe = false, stopped = false;
+
+    // GUI can not redraw, so there are no commits and stream has to use frame on screen
+    gui_lock(gui);
+    canvas_get_committed_frame(gui->canvas, expected, &orientation);
+
+    test_rpc_gui_request(PB_Main_gui_start_screen_stream_request_tag, ++command_id);
+    if(test_rpc_gui_receive(&message, MAX_RECEIVE_OUTPUT_TIMEOUT)) {
+        started = (message.command_id == command_id) &&
+                  (message.command_status == PB_CommandStatus_OK) &&
+                  (message.which_content == PB_Main_empty_tag);
+        pb_release(&PB_Main_msg, &message);
+    }
+    if(started) {
+        first_frame = test_rpc_gui_receive_frame(expected, frame_size, 500);
+        keyframe = test_rpc_gui_receive_frame(
+            expected, frame_size, RPC_GUI_TEST_KEYFRAME_INTERVAL_MS + 500);
+    }
+
+    gui_unlock(gui);
+
+    // Frames of redraws may come before the response
+    test_rpc_gui_request(PB_Main_gui_stop_screen_stream_request_tag, ++command_id);
+    while(test_rpc_gui_receive(&message, MAX_RECEIVE_OUTPUT_TIMEOUT)) {
+        stopped = (message.command_id == command_id) &&
+                  (message.which_content == PB_Main_empty_tag);
+        pb_release(&PB_Main_msg, &message);
+        if(stopped) break;
+    }
+
+    free(expected);
+    furi_record_close(RECORD_GUI);
+
+    mu_assert(started, "Screen stream is not started");
+    mu_assert(first_frame, "Current screen is not sent on start");
+    mu_assert(keyframe, "Keyframe is not sent for static screen");
+    mu_assert(stopped, "Screen stream is not stopped");
+}
+
+MU_TEST_SUITE(test_rpc_gui) {
+    MU_SUITE_CONFIGURE(&test_rpc_setup, &test_rpc_teardown);
+
+    MU_RUN_TEST(test_gui_screen_stream_static_screen);
+}
+
 static void test_app_create_request(
     PB_Main* request,
     const char* app_name,
@@ -1850,6 +2171,7 @@ int run_minunit_test_rpc(void) {
     furi_record_close(RECORD_STORAGE);
     MU_RUN_SUITE(test_rpc_system);
     MU_RUN_SUITE(test_rpc_app);
+    MU_RUN_SUITE(test_rpc_gui);
     MU_RUN_SUITE(test_rpc_session);
 
     return MU_EXIT_CODE;
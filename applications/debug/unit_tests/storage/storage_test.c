@@ -1,5 +1,6 @@
 #include "../minunit.h"
 #include <furi.h>
+#include <furi_hal.h>
 #include <storage/storage.h>
 
 // DO NOT USE THIS IN PRODUCTION CODE
@@ -13,6 +14,20 @@
 
 #define STORAGE_TEST_DIR UNIT_TESTS_PATH("test_dir")
 
+#define STORAGE_CACHE_TEST_DIR UNIT_TESTS_PATH("cache_dir")
+#define STORAGE_CACHE_TEST_FILE UNIT_TESTS_PATH("cache_file.test")
+#define STORAGE_CACHE_TEST_DIR_FILES 64
+#define STORAGE_CACHE_TEST_DIR_PASSES 4
+#define STORAGE_CACHE_TEST_CHUNK_SIZE 4096
+#define STORAGE_CACHE_TEST_FILE_CHUNKS 128
+
+#define STORAGE_BATCH_TEST_DIR UNIT_TESTS_PATH("batch_dir")
+#define STORAGE_BATCH_TEST_FILE UNIT_TESTS_PATH("batch_file.test")
+#define STORAGE_BATCH_TEST_DIR_FILES 1000
+#define STORAGE_BATCH_TEST_COUNT 16
+#define STORAGE_BATCH_TEST_NAMES_SIZE 1024
+#define STORAGE_BATCH_TEST_NAME_LENGTH 256
+
 static bool storage_file_create(Storage* storage, const char* path, const char* data) {
     File* file = storage_file_alloc(storage);
     bool result = false;
@@ -186,6 +201,248 @@ MU_TEST_SUITE(storage_file_64k) {
     MU_RUN_TEST(storage_file_read_write_64k);
 }
 
+static void storage_cache_test_print_stats(const char* stage, uint32_t time) {
+    FuriHalSdCacheStats stats;
+    furi_hal_sd_get_cache_stats(&stats);
+    printf(
+        "%s: %lu ms, cache %lu hits, %lu misses, %lu evictions, %lu write-backs\r\n",
+        stage,
+        time,
+        stats.hits,
+        stats.misses,
+        stats.evictions,
+        stats.write_backs);
+}
+
+static size_t storage_cache_test_list_dir(Storage* storage) {
+    File* dir = storage_file_alloc(storage);
+    size_t count = 0;
+    if(storage_dir_open(dir, STORAGE_CACHE_TEST_DIR)) {
+        while(storage_dir_read(dir, NULL, NULL, 0)) count++;
+    }
+    storage_dir_close(dir);
+    storage_file_free(dir);
+    return count;
+}
+
+MU_TEST(storage_sector_cache_dir_list) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_CACHE_TEST_DIR);
+    mu_check(storage_simply_mkdir(storage, STORAGE_CACHE_TEST_DIR));
+
+    FuriString* path = furi_string_alloc();
+    for(size_t i = 0; i < STORAGE_CACHE_TEST_DIR_FILES; i++) {
+        furi_string_printf(path, "%s/file_with_long_name_%03zu.test", STORAGE_CACHE_TEST_DIR, i);
+        mu_check(storage_file_create(storage, furi_string_get_cstr(path), "data"));
+    }
+    furi_string_free(path);
+
+    // Directory sectors are metadata, repeated listing should come from cache
+    uint32_t start = furi_get_tick();
+    for(size_t pass = 0; pass < STORAGE_CACHE_TEST_DIR_PASSES; pass++) {
+        mu_assert_int_eq(STORAGE_CACHE_TEST_DIR_FILES, storage_cache_test_list_dir(storage));
+    }
+    storage_cache_test_print_stats("Directory listing", furi_get_tick() - start);
+
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_CACHE_TEST_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_sector_cache_large_file) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t* chunk = malloc(STORAGE_CACHE_TEST_CHUNK_SIZE);
+
+    storage_simply_remove(storage, STORAGE_CACHE_TEST_FILE);
+    uint32_t start = furi_get_tick();
+    mu_check(storage_file_open(file, STORAGE_CACHE_TEST_FILE, FSAM_WRITE, FSOM_CREATE_NEW));
+    for(size_t i = 0; i < STORAGE_CACHE_TEST_FILE_CHUNKS; i++) {
+        memset(chunk, (uint8_t)i, STORAGE_CACHE_TEST_CHUNK_SIZE);
+        mu_check(
+            storage_file_write(file, chunk, STORAGE_CACHE_TEST_CHUNK_SIZE) ==
+            STORAGE_CACHE_TEST_CHUNK_SIZE);
+    }
+    mu_check(storage_file_close(file));
+    storage_cache_test_print_stats("Large file write", furi_get_tick() - start);
+
+    // Close is a flush point, nothing may stay in cache only
+    FuriHalSdCacheStats stats;
+    furi_hal_sd_get_cache_stats(&stats);
+    mu_assert_int_eq(0, stats.dirty);
+
+    mu_check(storage_file_open(file, STORAGE_CACHE_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_assert_int_eq(
+        STORAGE_CACHE_TEST_CHUNK_SIZE * STORAGE_CACHE_TEST_FILE_CHUNKS, storage_file_size(file));
+    for(size_t i = 0; i < STORAGE_CACHE_TEST_FILE_CHUNKS; i++) {
+        mu_check(
+            storage_file_read(file, chunk, STORAGE_CACHE_TEST_CHUNK_SIZE) ==
+            STORAGE_CACHE_TEST_CHUNK_SIZE);
+        bool chunk_ok = true;
+        for(size_t j = 0; j < STORAGE_CACHE_TEST_CHUNK_SIZE; j++) {
+            chunk_ok &= chunk[j] == (uint8_t)i;
+        }
+        mu_check(chunk_ok);
+    }
+    mu_check(storage_file_close(file));
+    mu_check(storage_simply_remove(storage, STORAGE_CACHE_TEST_FILE));
+
+    free(chunk);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_sector_cache) {
+    MU_RUN_TEST(storage_sector_cache_dir_list);
+    MU_RUN_TEST(storage_sector_cache_large_file);
+}
+
+static void storage_batch_test_dir_setup(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_BATCH_TEST_DIR);
+    mu_check(storage_simply_mkdir(storage, STORAGE_BATCH_TEST_DIR));
+
+    FuriString* path = furi_string_alloc();
+    for(size_t i = 0; i < STORAGE_BATCH_TEST_DIR_FILES; i++) {
+        furi_string_printf(path, "%s/batch_file_%04zu.test", STORAGE_BATCH_TEST_DIR, i);
+        mu_check(storage_file_create(storage, furi_string_get_cstr(path), "data"));
+    }
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_batch_test_dir_teardown(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_BATCH_TEST_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_dir_read_batch_test) {
+    storage_batch_test_dir_setup();
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+    FileInfo* fileinfo = malloc(sizeof(FileInfo) * STORAGE_BATCH_TEST_COUNT);
+    char* names = malloc(STORAGE_BATCH_TEST_NAMES_SIZE);
+    char* name = malloc(STORAGE_BATCH_TEST_NAME_LENGTH);
+    FileInfo single_fileinfo;
+
+    // Same items in the same order as storage_dir_read
+    uint32_t batch_time = 0;
+    uint32_t single_time = 0;
+    size_t count = 0;
+    File* single_dir = storage_file_alloc(storage);
+    mu_check(storage_dir_open(dir, STORAGE_BATCH_TEST_DIR));
+    mu_check(storage_dir_open(single_dir, STORAGE_BATCH_TEST_DIR));
+    while(true) {
+        uint32_t start = furi_get_tick();
+        size_t batch_count = storage_dir_read_batch(
+            dir,
+            fileinfo,
+            names,
+            STORAGE_BATCH_TEST_NAMES_SIZE,
+            STORAGE_BATCH_TEST_NAME_LENGTH,
+            STORAGE_BATCH_TEST_COUNT);
+        batch_time += furi_get_tick() - start;
+        if(!batch_count) break;
+
+        const char* batch_name = names;
+        for(size_t i = 0; i < batch_count; i++) {
+            start = furi_get_tick();
+            mu_check(storage_dir_read(
+                single_dir, &single_fileinfo, name, STORAGE_BATCH_TEST_NAME_LENGTH));
+            single_time += furi_get_tick() - start;
+
+            mu_assert_string_eq(name, batch_name);
+            mu_check(single_fileinfo.size == fileinfo[i].size);
+            mu_check(file_info_is_dir(&single_fileinfo) == file_info_is_dir(&fileinfo[i]));
+            batch_name += strlen(batch_name) + 1;
+        }
+        count += batch_count;
+    }
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(dir));
+    mu_check(!storage_dir_read(single_dir, NULL, name, STORAGE_BATCH_TEST_NAME_LENGTH));
+    mu_assert_int_eq(STORAGE_BATCH_TEST_DIR_FILES, count);
+    storage_dir_close(single_dir);
+    storage_dir_close(dir);
+
+    printf(
+        "Listing %d files: %lu ms item by item, %lu ms in batches\r\n",
+        STORAGE_BATCH_TEST_DIR_FILES,
+        single_time,
+        batch_time);
+
+    free(name);
+    free(names);
+    free(fileinfo);
+    storage_file_free(single_dir);
+    storage_file_free(dir);
+    furi_record_close(RECORD_STORAGE);
+    storage_batch_test_dir_teardown();
+}
+
+MU_TEST(storage_common_stat_batch_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const char* paths[] = {
+        STORAGE_BATCH_TEST_FILE,
+        UNIT_TESTS_PATH("missing.test"),
+        EXT_PATH("unit_tests"),
+    };
+    FileInfo fileinfo[COUNT_OF(paths)];
+    FS_Error errors[COUNT_OF(paths)];
+
+    storage_simply_remove(storage, STORAGE_BATCH_TEST_FILE);
+    mu_check(storage_file_create(storage, STORAGE_BATCH_TEST_FILE, "data"));
+    size_t found = storage_common_stat_batch(storage, paths, fileinfo, errors, COUNT_OF(paths));
+    mu_assert_int_eq(2, found);
+    mu_assert_int_eq(FSE_OK, errors[0]);
+    mu_check(!file_info_is_dir(&fileinfo[0]));
+    mu_check(fileinfo[0].size == strlen("data"));
+    mu_assert_int_eq(FSE_NOT_EXIST, errors[1]);
+    mu_assert_int_eq(FSE_OK, errors[2]);
+    mu_check(file_info_is_dir(&fileinfo[2]));
+    mu_check(storage_simply_remove(storage, STORAGE_BATCH_TEST_FILE));
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_file_read_batch_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t data[256];
+    for(size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+
+    storage_simply_remove(storage, STORAGE_BATCH_TEST_FILE);
+    mu_check(storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_WRITE, FSOM_CREATE_NEW));
+    mu_check(storage_file_write(file, data, sizeof(data)) == sizeof(data));
+    mu_check(storage_file_close(file));
+
+    uint8_t buffers[3][16];
+    StorageReadRequest requests[] = {
+        {.offset = 200, .buff = buffers[0], .size = 16},
+        {.offset = 10, .buff = buffers[1], .size = 16},
+        {.offset = 250, .buff = buffers[2], .size = 16},
+    };
+    mu_check(storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    // Last request crosses end of file
+    mu_assert_int_eq(2, storage_file_read_batch(file, requests, COUNT_OF(requests)));
+    mu_assert_mem_eq(&data[200], buffers[0], 16);
+    mu_assert_mem_eq(&data[10], buffers[1], 16);
+    mu_assert_int_eq(6, requests[2].bytes_read);
+    mu_assert_mem_eq(&data[250], buffers[2], 6);
+    mu_check(storage_file_close(file));
+    mu_check(storage_simply_remove(storage, STORAGE_BATCH_TEST_FILE));
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_batch) {
+    MU_RUN_TEST(storage_dir_read_batch_test);
+    MU_RUN_TEST(storage_common_stat_batch_test);
+    MU_RUN_TEST(storage_file_read_batch_test);
+}
+
 MU_TEST(storage_dir_open_close) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* file;
@@ -646,6 +903,38 @@ MU_TEST(test_storage_common_migrate) {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST(test_storage_common_mtime) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const char* path = UNIT_TESTS_PATH("mtime.test");
+
+    storage_simply_remove(storage, path);
+    uint32_t before = furi_hal_rtc_get_timestamp();
+    mu_check(storage_file_create(storage, path, "test"));
+    uint32_t after = furi_hal_rtc_get_timestamp();
+
+    // FAT keeps time with 2 second resolution
+    uint32_t mtime = 0;
+    mu_assert_int_eq(FSE_OK, storage_common_mtime(storage, path, &mtime));
+    mu_check(mtime + 2 > before);
+    mu_check(mtime <= after);
+
+    // Same values from a single lookup
+    FileInfo fileinfo;
+    uint32_t stat_mtime = 0;
+    mu_assert_int_eq(FSE_OK, storage_common_stat_mtime(storage, path, &fileinfo, &stat_mtime));
+    mu_assert_int_eq(mtime, stat_mtime);
+    mu_assert_int_eq(4, fileinfo.size);
+    mu_check(!file_info_is_dir(&fileinfo));
+
+    mu_assert_int_eq(
+        FSE_NOT_EXIST, storage_common_mtime(storage, UNIT_TESTS_PATH("mtime.none"), &mtime));
+    mu_assert_int_eq(
+        FSE_NOT_IMPLEMENTED, storage_common_mtime(storage, STORAGE_INT_PATH_PREFIX, &mtime));
+
+    storage_simply_remove(storage, path);
+    furi_record_close(RECORD_STORAGE);
+}
+
 #define MD5_HASH_SIZE (16)
 #include <lib/toolbox/md5_calc.h>
 
@@ -696,6 +985,7 @@ MU_TEST_SUITE(test_data_path) {
 
 MU_TEST_SUITE(test_storage_common) {
     MU_RUN_TEST(test_storage_common_migrate);
+    MU_RUN_TEST(test_storage_common_mtime);
 }
 
 MU_TEST_SUITE(test_md5_calc_suite) {
@@ -706,6 +996,8 @@ int run_minunit_test_storage(void) {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_file_64k);
     MU_RUN_SUITE(storage_dir);
+    MU_RUN_SUITE(storage_sector_cache);
+    MU_RUN_SUITE(storage_batch);
     MU_RUN_SUITE(storage_rename);
     MU_RUN_SUITE(test_data_path);
     MU_RUN_SUITE(test_storage_common);
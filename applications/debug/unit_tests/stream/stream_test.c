@@ -518,12 +518,84 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+static size_t stream_buffered_parse_lines(Stream* stream, const char* path) {
+    size_t line_count = 0;
+    FuriString* line = furi_string_alloc();
+
+    mu_check(buffered_file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    while(stream_read_line(stream, line)) {
+        line_count++;
+    }
+    mu_check(stream_eof(stream));
+    buffered_file_stream_close(stream);
+
+    furi_string_free(line);
+    return line_count;
+}
+
+MU_TEST(stream_buffered_read_ahead_benchmark) {
+    const char* path = EXT_PATH("filestream_ir_library.str");
+    const size_t data_size = 1024 * 1024;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    // generate infrared library-like file
+    FuriString* block = furi_string_alloc();
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(stream, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    size_t line_count = 0;
+    size_t written = 0;
+    for(size_t i = 0; written < data_size; i++) {
+        furi_string_printf(
+            block,
+            "# \n"
+            "name: Power_%zu\n"
+            "type: parsed\n"
+            "protocol: NEC\n"
+            "address: %02zX 00 00 00\n"
+            "command: %02zX 00 00 00\n",
+            i,
+            i & 0xFF,
+            (i >> 8) & 0xFF);
+        mu_assert_int_eq(furi_string_size(block), stream_write_string(stream, block));
+        written += furi_string_size(block);
+        line_count += 6;
+    }
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+    furi_string_free(block);
+
+    // previous fixed 1 KiB cache
+    stream = buffered_file_stream_alloc_ex(storage, 1024);
+    uint32_t fixed_time = furi_get_tick();
+    mu_assert_int_eq(line_count, stream_buffered_parse_lines(stream, path));
+    fixed_time = furi_get_tick() - fixed_time;
+    stream_free(stream);
+
+    // adaptive read-ahead
+    stream = buffered_file_stream_alloc(storage);
+    uint32_t read_ahead_time = furi_get_tick();
+    mu_assert_int_eq(line_count, stream_buffered_parse_lines(stream, path));
+    read_ahead_time = furi_get_tick() - read_ahead_time;
+    stream_free(stream);
+
+    printf(
+        "Parsed %zu lines: fixed cache %lums, read-ahead %lums\r\n",
+        line_count,
+        fixed_time,
+        read_ahead_time);
+
+    mu_check(storage_simply_remove(storage, path));
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+    MU_RUN_TEST(stream_buffered_read_ahead_benchmark);
 }
 
 int run_minunit_test_stream(void) {
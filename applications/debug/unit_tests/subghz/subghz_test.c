@@ -6,6 +6,8 @@
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
 #include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/blocks/math.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
@@ -18,6 +20,11 @@
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
 #define TEST_TIMEOUT 10000
+#define TEST_DISPATCH_PULSES_MAX 32768
+#define TEST_KEELOQ_KEYSTORE_SIZE 2000
+#define TEST_KEELOQ_REMOTE_COUNT 64
+#define TEST_KEELOQ_PRESS_COUNT 4
+#define TEST_KEYSTORE_BINARY_NAME EXT_PATH("unit_tests/subghz/keeloq_mfcodes.bin")
 
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
@@ -830,9 +837,238 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+static void subghz_test_dispatch_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    UNUSED(decoder_base);
+    uint32_t* count = context;
+    (*count)++;
+}
+
+static size_t subghz_test_dispatch_load_pulses(const char* path, LevelDuration* pulses) {
+    size_t pulse_count = 0;
+    uint32_t test_start = furi_get_tick();
+
+    file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
+    if(subghz_file_encoder_worker_start(file_worker_encoder_handler, path, NULL)) {
+        // the worker needs a file in order to open and read part of the file
+        furi_delay_ms(100);
+
+        while(pulse_count < TEST_DISPATCH_PULSES_MAX &&
+              furi_get_tick() - test_start < TEST_TIMEOUT) {
+            LevelDuration level_duration =
+                subghz_file_encoder_worker_get_level_duration(file_worker_encoder_handler);
+            if(level_duration_is_reset(level_duration)) break;
+            pulses[pulse_count++] = level_duration;
+            // Yield, to load data inside the worker
+            furi_thread_yield();
+        }
+        if(subghz_file_encoder_worker_is_running(file_worker_encoder_handler)) {
+            subghz_file_encoder_worker_stop(file_worker_encoder_handler);
+        }
+    }
+    subghz_file_encoder_worker_free(file_worker_encoder_handler);
+
+    return pulse_count;
+}
+
+MU_TEST(subghz_receiver_dispatch_test) {
+    LevelDuration* pulses = malloc(TEST_DISPATCH_PULSES_MAX * sizeof(LevelDuration));
+    uint32_t pulse_count = subghz_test_dispatch_load_pulses(TEST_RANDOM_DIR_NAME, pulses);
+    mu_assert(pulse_count > 0, "Failed to load RAW capture\r\n");
+
+    // Reference: every decoder is fed every pulse, as before the dispatch stage
+    uint32_t reference_count = 0;
+    SubGhzReceiver* reference = subghz_receiver_alloc_init(environment_handler);
+    subghz_receiver_set_rx_callback(reference, subghz_test_dispatch_rx_callback, &reference_count);
+
+    const SubGhzProtocolRegistry* registry = &subghz_protocol_registry;
+    size_t decoder_count = 0;
+    SubGhzProtocolDecoderBase** decoders =
+        malloc(subghz_protocol_registry_count(registry) * sizeof(SubGhzProtocolDecoderBase*));
+    for(size_t i = 0; i < subghz_protocol_registry_count(registry); i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(registry, i);
+        if(!(protocol->flag & SubGhzProtocolFlag_Decodable)) continue;
+        SubGhzProtocolDecoderBase* decoder =
+            subghz_receiver_search_decoder_base_by_name(reference, protocol->name);
+        if(decoder) decoders[decoder_count++] = decoder;
+    }
+
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < pulse_count; i++) {
+        bool level = level_duration_get_level(pulses[i]);
+        uint32_t duration = level_duration_get_duration(pulses[i]);
+        for(size_t j = 0; j < decoder_count; j++) {
+            decoders[j]->protocol->decoder->feed(decoders[j], level, duration);
+        }
+    }
+    uint32_t reference_time = furi_get_tick() - start;
+
+    // Receiver with the dispatch stage
+    uint32_t dispatch_count = 0;
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment_handler);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_ignore_filter(receiver, 0);
+    subghz_receiver_set_rx_callback(receiver, subghz_test_dispatch_rx_callback, &dispatch_count);
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < pulse_count; i++) {
+        subghz_receiver_decode(
+            receiver,
+            level_duration_get_level(pulses[i]),
+            level_duration_get_duration(pulses[i]));
+    }
+    uint32_t dispatch_time = furi_get_tick() - start;
+
+    printf(
+        "Receiver dispatch: %lu pulses, feed all %lu ms (%lu pulses/s), dispatch %lu ms (%lu pulses/s)\r\n",
+        pulse_count,
+        reference_time,
+        reference_time ? pulse_count * 1000 / reference_time : 0,
+        dispatch_time,
+        dispatch_time ? pulse_count * 1000 / dispatch_time : 0);
+
+    subghz_receiver_free(receiver);
+    subghz_receiver_free(reference);
+    free(decoders);
+    free(pulses);
+
+    mu_assert_int_eq(reference_count, dispatch_count);
+}
+
+static uint64_t subghz_test_keeloq_random(uint64_t* state) {
+    // xorshift64, deterministic synthetic keys
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+MU_TEST(subghz_keeloq_keystore_index_test) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+
+    uint64_t random_state = 0x4B65654C6F71ULL;
+    for(size_t i = 0; i < TEST_KEELOQ_KEYSTORE_SIZE; i++) {
+        SubGhzKey* key = SubGhzKeyArray_push_raw(*keys);
+        key->name = furi_string_alloc_printf("Synthetic_%03u", i / 10);
+        key->key = subghz_test_keeloq_random(&random_state);
+        key->type = (i % 2) ? KEELOQ_LEARNING_NORMAL : KEELOQ_LEARNING_SIMPLE;
+    }
+
+    SubGhzProtocolDecoderBase* decoder = subghz_protocol_keeloq_decoder.alloc(environment);
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    FuriString* text = furi_string_alloc();
+
+    uint32_t resolved = 0;
+    uint32_t start = furi_get_tick();
+    for(size_t remote = 0; remote < TEST_KEELOQ_REMOTE_COUNT; remote++) {
+        // Remotes are spread over the whole keystore, later keys cost more to find
+        const SubGhzKey* key = SubGhzKeyArray_cget(
+            *keys, (remote * TEST_KEELOQ_KEYSTORE_SIZE) / TEST_KEELOQ_REMOTE_COUNT);
+        uint32_t serial = subghz_test_keeloq_random(&random_state) & 0x0FFFFFFF;
+        uint8_t btn = 0x2;
+        uint32_t fix = (uint32_t)btn << 28 | serial;
+        uint64_t man = key->type == KEELOQ_LEARNING_NORMAL ?
+                           subghz_protocol_keeloq_common_normal_learning(fix, key->key) :
+                           key->key;
+
+        for(uint16_t press = 0; press < TEST_KEELOQ_PRESS_COUNT; press++) {
+            uint32_t decrypt = (uint32_t)btn << 28 | (serial & 0xFF) << 16 | (0x100 + press);
+            uint32_t hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+            uint64_t data =
+                subghz_protocol_blocks_reverse_key((uint64_t)fix << 32 | hop, 64);
+
+            uint8_t key_data[sizeof(uint64_t)];
+            for(size_t i = 0; i < sizeof(uint64_t); i++) {
+                key_data[i] = data >> ((sizeof(uint64_t) - i - 1) * 8);
+            }
+            uint32_t bit = 64;
+            flipper_format_rewind(flipper_format);
+            stream_clean(flipper_format_get_raw_stream(flipper_format));
+            flipper_format_write_uint32(flipper_format, "Bit", &bit, 1);
+            flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(uint64_t));
+
+            // Every press is decoded from scratch, like after a receiver reset
+            decoder->protocol->decoder->reset(decoder);
+            subghz_protocol_decoder_base_deserialize(decoder, flipper_format);
+            furi_string_reset(text);
+            subghz_protocol_decoder_base_get_string(decoder, text);
+            if(furi_string_search_str(text, "Unknown") == FURI_STRING_FAILURE) resolved++;
+        }
+    }
+    uint32_t time = furi_get_tick() - start;
+
+    printf(
+        "KeeLoq keystore: %u keys, %u hops in %lu ms\r\n",
+        TEST_KEELOQ_KEYSTORE_SIZE,
+        TEST_KEELOQ_REMOTE_COUNT * TEST_KEELOQ_PRESS_COUNT,
+        time);
+
+    furi_string_free(text);
+    flipper_format_free(flipper_format);
+    decoder->protocol->decoder->free(decoder);
+    subghz_environment_free(environment);
+
+    mu_assert_int_eq(TEST_KEELOQ_REMOTE_COUNT * TEST_KEELOQ_PRESS_COUNT, resolved);
+}
+
+static bool subghz_keystore_binary_roundtrip(SubGhzKeystore* source, uint8_t* iv) {
+    if(!subghz_keystore_save_binary(source, TEST_KEYSTORE_BINARY_NAME, iv)) return false;
+
+    SubGhzKeystore* compiled = subghz_keystore_alloc();
+    bool result = subghz_keystore_load(compiled, TEST_KEYSTORE_BINARY_NAME);
+
+    SubGhzKeyArray_t* expected = subghz_keystore_get_data(source);
+    SubGhzKeyArray_t* actual = subghz_keystore_get_data(compiled);
+    if(result && SubGhzKeyArray_size(*expected) == SubGhzKeyArray_size(*actual)) {
+        // Key order decides which manufacture wins, so it must survive compilation
+        for(size_t i = 0; i < SubGhzKeyArray_size(*expected); i++) {
+            const SubGhzKey* a = SubGhzKeyArray_cget(*expected, i);
+            const SubGhzKey* b = SubGhzKeyArray_cget(*actual, i);
+            if(a->key != b->key || a->type != b->type ||
+               !furi_string_equal(a->name, b->name)) {
+                result = false;
+                break;
+            }
+        }
+    } else {
+        result = false;
+    }
+
+    subghz_keystore_free(compiled);
+    storage_simply_remove(furi_record_open(RECORD_STORAGE), TEST_KEYSTORE_BINARY_NAME);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
+
+MU_TEST(subghz_keystore_binary_test) {
+    SubGhzKeystore* source = subghz_keystore_alloc();
+    mu_assert(subghz_keystore_load(source, KEYSTORE_DIR_NAME), "Test keystore error");
+
+    uint32_t start = furi_get_tick();
+    mu_assert(
+        subghz_keystore_binary_roundtrip(source, NULL), "Unencrypted binary keystore mismatch");
+
+    uint8_t iv[16] = {0};
+    furi_hal_random_fill_buf(iv, sizeof(iv));
+    mu_assert(subghz_keystore_binary_roundtrip(source, iv), "Encrypted binary keystore mismatch");
+
+    printf(
+        "Binary keystore: %zu keys round-tripped in %lu ms\r\n",
+        SubGhzKeyArray_size(*subghz_keystore_get_data(source)),
+        furi_get_tick() - start);
+
+    subghz_keystore_free(source);
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_binary_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -907,6 +1143,8 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_decoder_acurite_592txr_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_receiver_dispatch_test);
+    MU_RUN_TEST(subghz_keeloq_keystore_index_test);
     subghz_test_deinit();
 }
 
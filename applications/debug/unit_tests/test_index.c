@@ -30,7 +30,14 @@ int run_minunit_test_datetime(void);
 int run_minunit_test_float_tools(void);
 int run_minunit_test_bt(void);
 int run_minunit_test_dialogs_file_browser_options(void);
+int run_minunit_test_dialogs_file_browser_cache(void);
 int run_minunit_test_expansion(void);
+int run_minunit_test_api_hashtable(void);
+int run_minunit_test_manifest_cache(void);
+int run_minunit_test_canvas(void);
+int run_minunit_test_compress(void);
+int run_minunit_test_animation_storage(void);
+int run_minunit_test_mjs(void);
 
 typedef int (*UnitTestEntry)(void);
 
@@ -63,7 +70,14 @@ const UnitTest unit_tests[] = {
     {.name = "bt", .entry = run_minunit_test_bt},
     {.name = "dialogs_file_browser_options",
      .entry = run_minunit_test_dialogs_file_browser_options},
+    {.name = "dialogs_file_browser_cache", .entry = run_minunit_test_dialogs_file_browser_cache},
     {.name = "expansion", .entry = run_minunit_test_expansion},
+    {.name = "api_hashtable", .entry = run_minunit_test_api_hashtable},
+    {.name = "manifest_cache", .entry = run_minunit_test_manifest_cache},
+    {.name = "canvas", .entry = run_minunit_test_canvas},
+    {.name = "compress", .entry = run_minunit_test_compress},
+    {.name = "animation_storage", .entry = run_minunit_test_animation_storage},
+    {.name = "mjs", .entry = run_minunit_test_mjs},
 };
 
 void minunit_print_progress(void) {
@@ -649,7 +649,9 @@ void mfkey(ProgramState* program_state) {
     //FURI_LOG_I(TAG, "Unique keys found:");
     for(i = 0; i < keyarray_size; i++) {
         //FURI_LOG_I(TAG, "%012" PRIx64, keyarray[i]);
-        keys_dict_add_key(user_dict, keyarray[i].data, sizeof(MfClassicKey));
+        if(!keys_dict_is_key_present(user_dict, keyarray[i].data, sizeof(MfClassicKey))) {
+            keys_dict_add_key(user_dict, keyarray[i].data, sizeof(MfClassicKey));
+        }
     }
     if(keyarray_size > 0) {
         dolphin_deed(DolphinDeedNfcMfcAdd);
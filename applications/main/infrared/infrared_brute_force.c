@@ -1,16 +1,54 @@
 #include "infrared_brute_force.h"
 
 #include <stdlib.h>
+#include <m-array.h>
 #include <m-dict.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <storage/storage.h>
 
 #include "infrared_signal.h"
 
+#define TAG "InfraredBruteForce"
+
+#define INFRARED_BRUTE_FORCE_INDEX_EXTENSION ".cache"
+#define INFRARED_BRUTE_FORCE_INDEX_MAGIC (0x49424952U) // "RIBI"
+#define INFRARED_BRUTE_FORCE_INDEX_VERSION (1U)
+#define INFRARED_BRUTE_FORCE_INDEX_NAME_MAX (UINT8_MAX)
+
+/*
+ * Index of a signal database
+ *
+ * Header is followed by an entry for every signal name found in database:
+ * name length (1 byte), name without terminator, signal count (4 bytes) and
+ * file offsets of the signals (4 bytes each). Stored next to the database,
+ * valid while its size and modification time match the ones in header.
+ * Opening a universal remote reads signal counts from it instead of parsing
+ * the whole database, transmission seeks straight to the next signal.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t name_count;
+    uint32_t source_size;
+    uint32_t source_mtime;
+} FURI_PACKED InfraredBruteForceIndexHeader;
+
 typedef struct {
     uint32_t index;
     uint32_t count;
+    uint32_t index_offset; ///< Offset of signal offsets in index file, 0 if not indexed
 } InfraredBruteForceRecord;
 
+ARRAY_DEF(InfraredBruteForceOffsetArray, uint32_t, M_POD_OPLIST);
+
+DICT_DEF2(
+    InfraredBruteForceOffsetDict,
+    FuriString*,
+    FURI_STRING_OPLIST,
+    InfraredBruteForceOffsetArray_t,
+    ARRAY_OPLIST(InfraredBruteForceOffsetArray, M_POD_OPLIST));
+
 DICT_DEF2(
     InfraredBruteForceRecordDict,
     FuriString*,
@@ -25,6 +63,9 @@ struct InfraredBruteForce {
     InfraredSignal* current_signal;
     InfraredBruteForceRecordDict_t records;
     bool is_started;
+    uint32_t* signal_offsets; ///< Offsets of current record signals, NULL if not indexed
+    uint32_t signal_count;
+    uint32_t signal_next;
 };
 
 InfraredBruteForce* infrared_brute_force_alloc(void) {
@@ -33,6 +74,7 @@ InfraredBruteForce* infrared_brute_force_alloc(void) {
     brute_force->db_filename = NULL;
     brute_force->current_signal = NULL;
     brute_force->is_started = false;
+    brute_force->signal_offsets = NULL;
     brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
     return brute_force;
@@ -50,15 +92,195 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
     brute_force->db_filename = db_filename;
 }
 
-bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
-    furi_assert(!brute_force->is_started);
-    furi_assert(brute_force->db_filename);
+static FuriString* infrared_brute_force_index_path_alloc(const InfraredBruteForce* brute_force) {
+    return furi_string_alloc_printf(
+        "%s%s", brute_force->db_filename, INFRARED_BRUTE_FORCE_INDEX_EXTENSION);
+}
+
+static bool infrared_brute_force_index_header(
+    const InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceIndexHeader* header) {
+    FileInfo file_info;
+    if(storage_common_stat(storage, brute_force->db_filename, &file_info) != FSE_OK) return false;
+    if(file_info.size > UINT32_MAX) return false;
+    if(storage_common_mtime(storage, brute_force->db_filename, &header->source_mtime) != FSE_OK)
+        return false;
+
+    header->magic = INFRARED_BRUTE_FORCE_INDEX_MAGIC;
+    header->version = INFRARED_BRUTE_FORCE_INDEX_VERSION;
+    header->source_size = file_info.size;
+    return true;
+}
+
+// Get signal counts of added records from index
+static bool infrared_brute_force_index_load(InfraredBruteForce* brute_force, Storage* storage) {
+    InfraredBruteForceIndexHeader expected = {0};
+    if(!infrared_brute_force_index_header(brute_force, storage, &expected)) return false;
+
+    FuriString* index_path = infrared_brute_force_index_path_alloc(brute_force);
+    File* file = storage_file_alloc(storage);
+    FuriString* name = furi_string_alloc();
+    char* name_buf = malloc(INFRARED_BRUTE_FORCE_INDEX_NAME_MAX + 1);
     bool success = false;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index_path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        InfraredBruteForceIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        expected.name_count = header.name_count;
+        if(memcmp(&header, &expected, sizeof(header)) != 0) {
+            FURI_LOG_D(TAG, "Index is outdated");
+            break;
+        }
+
+        size_t i = 0;
+        for(; i < header.name_count; i++) {
+            uint8_t name_len;
+            uint32_t count;
+            if(storage_file_read(file, &name_len, sizeof(name_len)) != sizeof(name_len)) break;
+            if(storage_file_read(file, name_buf, name_len) != name_len) break;
+            if(storage_file_read(file, &count, sizeof(count)) != sizeof(count)) break;
+            name_buf[name_len] = '\0';
+            furi_string_set(name, name_buf);
+
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, name);
+            if(record) {
+                record->count = count;
+                record->index_offset = storage_file_tell(file);
+            }
+
+            const uint64_t next = storage_file_tell(file) + (uint64_t)count * sizeof(uint32_t);
+            if(next > storage_file_size(file) || !storage_file_seek(file, next, true)) break;
+        }
+
+        success = (i == header.name_count) && storage_file_eof(file);
+    } while(false);
+
+    if(!success) {
+        InfraredBruteForceRecordDict_it_t it;
+        for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+            !InfraredBruteForceRecordDict_end_p(it);
+            InfraredBruteForceRecordDict_next(it)) {
+            InfraredBruteForceRecord* record = &InfraredBruteForceRecordDict_ref(it)->value;
+            record->count = 0;
+            record->index_offset = 0;
+        }
+    }
+
+    free(name_buf);
+    furi_string_free(name);
+    storage_file_free(file);
+    furi_string_free(index_path);
+
+    return success;
+}
+
+static bool infrared_brute_force_index_write(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceOffsetDict_t offsets) {
+    InfraredBruteForceIndexHeader header = {0};
+    if(!infrared_brute_force_index_header(brute_force, storage, &header)) return false;
+
+    FuriString* index_path = infrared_brute_force_index_path_alloc(brute_force);
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(InfraredBruteForceOffsetDict_size(offsets) > UINT16_MAX) break;
+        header.name_count = InfraredBruteForceOffsetDict_size(offsets);
+
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index_path), FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        InfraredBruteForceOffsetDict_it_t it;
+        for(InfraredBruteForceOffsetDict_it(it, offsets); !InfraredBruteForceOffsetDict_end_p(it);
+            InfraredBruteForceOffsetDict_next(it)) {
+            const InfraredBruteForceOffsetDict_itref_t* entry =
+                InfraredBruteForceOffsetDict_cref(it);
+            const uint8_t name_len = furi_string_size(entry->key);
+            const uint32_t count = InfraredBruteForceOffsetArray_size(entry->value);
+            const size_t offsets_size = count * sizeof(uint32_t);
+
+            if(storage_file_write(file, &name_len, sizeof(name_len)) != sizeof(name_len)) break;
+            if(storage_file_write(file, furi_string_get_cstr(entry->key), name_len) != name_len)
+                break;
+            if(storage_file_write(file, &count, sizeof(count)) != sizeof(count)) break;
+            if(storage_file_write(
+                   file, InfraredBruteForceOffsetArray_cget(entry->value, 0), offsets_size) !=
+               offsets_size)
+                break;
+        }
+
+        success = InfraredBruteForceOffsetDict_end_p(it);
+    } while(false);
+
+    storage_file_free(file);
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to write index");
+        storage_simply_remove(storage, furi_string_get_cstr(index_path));
+    }
+    furi_string_free(index_path);
+
+    return success;
+}
+
+// Parse and validate the whole database, collecting signal offsets by name
+static bool infrared_brute_force_index_build(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceOffsetDict_t offsets) {
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
     FuriString* signal_name = furi_string_alloc();
     InfraredSignal* signal = infrared_signal_alloc();
+    bool success = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, brute_force->db_filename)) break;
+        Stream* stream = flipper_format_get_raw_stream(ff);
+
+        bool signals_valid = false;
+        size_t offset = stream_tell(stream);
+        while(infrared_signal_read_name(ff, signal_name)) {
+            signals_valid = infrared_signal_read_body(signal, ff) &&
+                            infrared_signal_is_valid(signal);
+            if(!signals_valid) break;
+
+            // Index can't store longer names, such database is counted without it
+            if(furi_string_size(signal_name) > INFRARED_BRUTE_FORCE_INDEX_NAME_MAX) {
+                signals_valid = false;
+                break;
+            }
+
+            InfraredBruteForceOffsetArray_push_back(
+                *InfraredBruteForceOffsetDict_safe_get(offsets, signal_name), offset);
+            offset = stream_tell(stream);
+        }
+
+        if(!signals_valid) break;
+        success = true;
+    } while(false);
+
+    infrared_signal_free(signal);
+    furi_string_free(signal_name);
+    flipper_format_free(ff);
+
+    return success;
+}
+
+static bool
+    infrared_brute_force_count_messages(InfraredBruteForce* brute_force, Storage* storage) {
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* signal_name = furi_string_alloc();
+    InfraredSignal* signal = infrared_signal_alloc();
+    bool success = false;
 
     do {
         if(!flipper_format_buffered_file_open_existing(ff, brute_force->db_filename)) break;
@@ -82,12 +304,70 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
 
     infrared_signal_free(signal);
     furi_string_free(signal_name);
-
     flipper_format_free(ff);
+
+    return success;
+}
+
+bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
+    furi_assert(!brute_force->is_started);
+    furi_assert(brute_force->db_filename);
+    bool success = false;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    if(infrared_brute_force_index_load(brute_force, storage)) {
+        success = true;
+    } else {
+        InfraredBruteForceOffsetDict_t offsets;
+        InfraredBruteForceOffsetDict_init(offsets);
+
+        FURI_LOG_D(TAG, "Building index");
+        if(infrared_brute_force_index_build(brute_force, storage, offsets)) {
+            success = infrared_brute_force_index_write(brute_force, storage, offsets) &&
+                      infrared_brute_force_index_load(brute_force, storage);
+        }
+
+        InfraredBruteForceOffsetDict_clear(offsets);
+
+        // Index is not available, e.g. storage has no modification time
+        if(!success) {
+            success = infrared_brute_force_count_messages(brute_force, storage);
+        }
+    }
+
     furi_record_close(RECORD_STORAGE);
     return success;
 }
 
+static bool infrared_brute_force_load_signal_offsets(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    const InfraredBruteForceRecord* record) {
+    FuriString* index_path = infrared_brute_force_index_path_alloc(brute_force);
+    File* file = storage_file_alloc(storage);
+    const size_t offsets_size = record->count * sizeof(uint32_t);
+    uint32_t* offsets = malloc(offsets_size);
+
+    bool success = storage_file_open(
+                       file, furi_string_get_cstr(index_path), FSAM_READ, FSOM_OPEN_EXISTING) &&
+                   storage_file_seek(file, record->index_offset, true) &&
+                   storage_file_read(file, offsets, offsets_size) == offsets_size;
+
+    if(success) {
+        brute_force->signal_offsets = offsets;
+        brute_force->signal_count = record->count;
+        brute_force->signal_next = 0;
+    } else {
+        free(offsets);
+    }
+
+    storage_file_free(file);
+    furi_string_free(index_path);
+
+    return success;
+}
+
 bool infrared_brute_force_start(
     InfraredBruteForce* brute_force,
     uint32_t index,
@@ -96,6 +376,7 @@ bool infrared_brute_force_start(
     bool success = false;
     *record_count = 0;
 
+    const InfraredBruteForceRecord* current_record = NULL;
     InfraredBruteForceRecordDict_it_t it;
     for(InfraredBruteForceRecordDict_it(it, brute_force->records);
         !InfraredBruteForceRecordDict_end_p(it);
@@ -105,6 +386,7 @@ bool infrared_brute_force_start(
             *record_count = record->value.count;
             if(*record_count) {
                 furi_string_set(brute_force->current_record_name, record->key);
+                current_record = &record->value;
             }
             break;
         }
@@ -117,6 +399,10 @@ bool infrared_brute_force_start(
         brute_force->is_started = true;
         success =
             flipper_format_buffered_file_open_existing(brute_force->ff, brute_force->db_filename);
+        // Without offsets signals are searched by name
+        if(success && current_record->index_offset) {
+            infrared_brute_force_load_signal_offsets(brute_force, storage, current_record);
+        }
         if(!success) infrared_brute_force_stop(brute_force);
     }
     return success;
@@ -129,6 +415,8 @@ bool infrared_brute_force_is_started(const InfraredBruteForce* brute_force) {
 void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
     furi_string_reset(brute_force->current_record_name);
+    free(brute_force->signal_offsets);
+    brute_force->signal_offsets = NULL;
     infrared_signal_free(brute_force->current_signal);
     flipper_format_free(brute_force->ff);
     brute_force->current_signal = NULL;
@@ -137,12 +425,34 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static bool infrared_brute_force_read_next_indexed(InfraredBruteForce* brute_force) {
+    if(brute_force->signal_next >= brute_force->signal_count) return false;
+
+    const uint32_t offset = brute_force->signal_offsets[brute_force->signal_next++];
+    if(!stream_seek(flipper_format_get_raw_stream(brute_force->ff), offset, StreamOffsetFromStart))
+        return false;
+
+    FuriString* signal_name = furi_string_alloc();
+    // Signal name is checked in case database was changed after index was loaded
+    const bool success =
+        infrared_signal_read(brute_force->current_signal, brute_force->ff, signal_name) &&
+        furi_string_equal(signal_name, brute_force->current_record_name);
+    furi_string_free(signal_name);
+
+    return success;
+}
+
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
-    const bool success = infrared_signal_search_by_name_and_read(
-        brute_force->current_signal,
-        brute_force->ff,
-        furi_string_get_cstr(brute_force->current_record_name));
+    bool success;
+    if(brute_force->signal_offsets) {
+        success = infrared_brute_force_read_next_indexed(brute_force);
+    } else {
+        success = infrared_signal_search_by_name_and_read(
+            brute_force->current_signal,
+            brute_force->ff,
+            furi_string_get_cstr(brute_force->current_record_name));
+    }
     if(success) {
         infrared_signal_transmit(brute_force->current_signal);
     }
@@ -153,7 +463,7 @@ void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
     uint32_t index,
     const char* name) {
-    InfraredBruteForceRecord value = {.index = index, .count = 0};
+    InfraredBruteForceRecord value = {.index = index, .count = 0, .index_offset = 0};
     FuriString* key;
     key = furi_string_alloc_set(name);
     InfraredBruteForceRecordDict_set_at(brute_force->records, key, value);
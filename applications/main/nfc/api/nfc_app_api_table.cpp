@@ -10,16 +10,23 @@
 
 static_assert(!has_hash_collisions(nfc_app_api_table), "Detected API method hash collision!");
 
-constexpr HashtableApiInterface nfc_application_hashtable_api_interface{
+static constexpr auto nfc_app_api_perfect_table = perfect_hash_table(nfc_app_api_table);
+static_assert(
+    is_perfect_hash_valid(nfc_app_api_perfect_table, nfc_app_api_table),
+    "Failed to build API perfect hash table!");
+
+constexpr PerfectHashApiInterface nfc_application_hashtable_api_interface{
     {
         .api_version_major = 0,
         .api_version_minor = 0,
-        /* generic resolver using pre-sorted array */
-        .resolver_callback = &elf_resolve_from_hashtable,
+        /* generic resolver using perfect hash table */
+        .resolver_callback = &elf_resolve_from_perfect_hashtable,
     },
-    /* pointers to application's API table boundaries */
-    nfc_app_api_table.cbegin(),
-    nfc_app_api_table.cend(),
+    /* application's API perfect hash table */
+    nfc_app_api_perfect_table.slots.data(),
+    nfc_app_api_perfect_table.displacements.data(),
+    nfc_app_api_perfect_table.slots.size(),
+    nfc_app_api_perfect_table.displacements.size(),
 };
 
 /* Casting to generic resolver to use in Composite API resolver */
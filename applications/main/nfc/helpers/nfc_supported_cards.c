@@ -8,6 +8,8 @@
 #include <flipper_application/plugins/composite_resolver.h>
 #include <loader/firmware_api/firmware_api.h>
 
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+
 #include <furi.h>
 #include <path.h>
 #include <m-array.h>
@@ -17,6 +19,9 @@
 #define NFC_SUPPORTED_CARDS_PLUGINS_PATH APP_DATA_PATH("plugins")
 #define NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX "_parser.fal"
 
+// Memory kept by loaded plugins between reads, also limited to a quarter of max free block
+#define NFC_SUPPORTED_CARDS_RESIDENT_BUDGET (16 * 1024)
+
 typedef enum {
     NfcSupportedCardsPluginFeatureHasVerify = (1U << 0),
     NfcSupportedCardsPluginFeatureHasRead = (1U << 1),
@@ -27,6 +32,11 @@ typedef struct {
     FuriString* path;
     NfcProtocol protocol;
     NfcSupportedCardsPluginFeature feature;
+    NfcSupportedCardPluginSignature signature;
+    FlipperApplication* app; ///< Resident plugin application, NULL if not loaded
+    const NfcSupportedCardsPlugin* plugin;
+    size_t app_size; ///< Heap taken by resident plugin
+    uint32_t last_use;
 } NfcSupportedCardsPluginCache;
 
 ARRAY_DEF(NfcSupportedCardsPluginCache, NfcSupportedCardsPluginCache, M_POD_OPLIST);
@@ -47,15 +57,19 @@ typedef struct {
 } NfcSupportedCardsLoadContext;
 
 struct NfcSupportedCards {
+    Storage* storage;
     CompositeApiResolver* api_resolver;
     NfcSupportedCardsPluginCache_t plugins_cache_arr;
     NfcSupportedCardsLoadState load_state;
     NfcSupportedCardsLoadContext* load_context;
+    size_t resident_size;
+    uint32_t resident_clock;
 };
 
 NfcSupportedCards* nfc_supported_cards_alloc(void) {
     NfcSupportedCards* instance = malloc(sizeof(NfcSupportedCards));
 
+    instance->storage = furi_record_open(RECORD_STORAGE);
     instance->api_resolver = composite_api_resolver_alloc();
     composite_api_resolver_add(instance->api_resolver, firmware_api_interface);
     composite_api_resolver_add(instance->api_resolver, nfc_application_api_interface);
@@ -73,11 +87,15 @@ void nfc_supported_cards_free(NfcSupportedCards* instance) {
         !NfcSupportedCardsPluginCache_end_p(iter);
         NfcSupportedCardsPluginCache_next(iter)) {
         NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
+        if(plugin_cache->app) {
+            flipper_application_free(plugin_cache->app);
+        }
         furi_string_free(plugin_cache->path);
     }
     NfcSupportedCardsPluginCache_clear(instance->plugins_cache_arr);
 
     composite_api_resolver_free(instance->api_resolver);
+    furi_record_close(RECORD_STORAGE);
     free(instance);
 }
 
@@ -110,24 +128,24 @@ static void nfc_supported_cards_load_context_free(NfcSupportedCardsLoadContext*
 }
 
 static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
-    NfcSupportedCardsLoadContext* instance,
+    Storage* storage,
     const FuriString* path,
-    const ElfApiInterface* api_interface) {
-    furi_assert(instance);
+    const ElfApiInterface* api_interface,
+    FlipperApplication** app) {
+    furi_assert(storage);
     furi_assert(path);
+    furi_assert(app);
 
     const NfcSupportedCardsPlugin* plugin = NULL;
+    *app = flipper_application_alloc(storage, api_interface);
     do {
-        if(instance->app) flipper_application_free(instance->app);
-        instance->app = flipper_application_alloc(instance->storage, api_interface);
-        if(flipper_application_preload(instance->app, furi_string_get_cstr(path)) !=
+        if(flipper_application_preload(*app, furi_string_get_cstr(path)) !=
            FlipperApplicationPreloadStatusSuccess)
             break;
-        if(!flipper_application_is_plugin(instance->app)) break;
-        if(flipper_application_map_to_memory(instance->app) != FlipperApplicationLoadStatusSuccess)
-            break;
+        if(!flipper_application_is_plugin(*app)) break;
+        if(flipper_application_map_to_memory(*app) != FlipperApplicationLoadStatusSuccess) break;
         const FlipperAppPluginDescriptor* descriptor =
-            flipper_application_plugin_get_descriptor(instance->app);
+            flipper_application_plugin_get_descriptor(*app);
 
         if(descriptor == NULL) break;
 
@@ -137,6 +155,11 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
         plugin = descriptor->entry_point;
     } while(false);
 
+    if(plugin == NULL) {
+        flipper_application_free(*app);
+        *app = NULL;
+    }
+
     return plugin;
 }
 
@@ -157,7 +180,11 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_next_plugin(
 
         path_concat(NFC_SUPPORTED_CARDS_PLUGINS_PATH, instance->file_name, instance->file_path);
 
-        plugin = nfc_supported_cards_get_plugin(instance, instance->file_path, api_interface);
+        if(instance->app) {
+            flipper_application_free(instance->app);
+        }
+        plugin = nfc_supported_cards_get_plugin(
+            instance->storage, instance->file_path, api_interface, &instance->app);
     } while(plugin == NULL); //-V654
 
     return plugin;
@@ -183,6 +210,7 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
             NfcSupportedCardsPluginCache plugin_cache = {}; //-V779
             plugin_cache.path = furi_string_alloc_set(instance->load_context->file_path);
             plugin_cache.protocol = plugin->protocol;
+            plugin_cache.signature = plugin->signature;
             if(plugin->verify) {
                 plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
             }
@@ -209,6 +237,89 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
     } while(false);
 }
 
+static bool nfc_supported_cards_signature_match(
+    const NfcSupportedCardPluginSignature* signature,
+    const NfcDevice* device) {
+    if(signature->uid_len) {
+        size_t uid_len = 0;
+        nfc_device_get_uid(device, &uid_len);
+        if(uid_len != signature->uid_len) return false;
+    }
+
+    if(signature->sak_mask || signature->atqa_mask[0] || signature->atqa_mask[1]) {
+        NfcProtocol protocol = nfc_device_get_protocol(device);
+        if(protocol != NfcProtocolIso14443_3a &&
+           !nfc_protocol_has_parent(protocol, NfcProtocolIso14443_3a)) {
+            return false;
+        }
+
+        const Iso14443_3aData* data = nfc_device_get_data(device, NfcProtocolIso14443_3a);
+        uint8_t atqa[2];
+        iso14443_3a_get_atqa(data, atqa);
+        if((iso14443_3a_get_sak(data) ^ signature->sak) & signature->sak_mask) return false;
+        for(size_t i = 0; i < COUNT_OF(atqa); i++) {
+            if((atqa[i] ^ signature->atqa[i]) & signature->atqa_mask[i]) return false;
+        }
+    }
+
+    return true;
+}
+
+static void nfc_supported_cards_unload_plugin(
+    NfcSupportedCards* instance,
+    NfcSupportedCardsPluginCache* plugin_cache) {
+    flipper_application_free(plugin_cache->app);
+    plugin_cache->app = NULL;
+    plugin_cache->plugin = NULL;
+    instance->resident_size -= plugin_cache->app_size;
+    plugin_cache->app_size = 0;
+}
+
+// Unload least recently used plugins until resident ones fit into budget
+static void nfc_supported_cards_trim_resident(NfcSupportedCards* instance) {
+    size_t budget = MIN(
+        (size_t)NFC_SUPPORTED_CARDS_RESIDENT_BUDGET, memmgr_heap_get_max_free_block() / 4);
+
+    while(instance->resident_size > budget) {
+        NfcSupportedCardsPluginCache* victim = NULL;
+
+        NfcSupportedCardsPluginCache_it_t iter;
+        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+            !NfcSupportedCardsPluginCache_end_p(iter);
+            NfcSupportedCardsPluginCache_next(iter)) {
+            NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
+            if(plugin_cache->app == NULL) continue;
+            if(victim == NULL || (int32_t)(plugin_cache->last_use - victim->last_use) < 0) {
+                victim = plugin_cache;
+            }
+        }
+
+        if(victim == NULL) break;
+        nfc_supported_cards_unload_plugin(instance, victim);
+    }
+}
+
+static const NfcSupportedCardsPlugin* nfc_supported_cards_get_resident_plugin(
+    NfcSupportedCards* instance,
+    NfcSupportedCardsPluginCache* plugin_cache) {
+    if(plugin_cache->app == NULL) {
+        size_t free_heap = memmgr_get_free_heap();
+
+        const ElfApiInterface* api_interface = composite_api_resolver_get(instance->api_resolver);
+        plugin_cache->plugin = nfc_supported_cards_get_plugin(
+            instance->storage, plugin_cache->path, api_interface, &plugin_cache->app);
+        if(plugin_cache->plugin == NULL) return NULL;
+
+        // Other threads may allocate in the meantime, size is only an estimate
+        size_t free_heap_loaded = memmgr_get_free_heap();
+        plugin_cache->app_size = free_heap > free_heap_loaded ? free_heap - free_heap_loaded : 0;
+        instance->resident_size += plugin_cache->app_size;
+    }
+
+    plugin_cache->last_use = ++instance->resident_clock;
+    return plugin_cache->plugin;
+}
+
 bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nfc* nfc) {
     furi_assert(instance);
     furi_assert(device);
@@ -220,8 +331,6 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
     do {
         if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
 
-        instance->load_context = nfc_supported_cards_load_context_alloc();
-
         NfcSupportedCardsPluginCache_it_t iter;
         for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
             !NfcSupportedCardsPluginCache_end_p(iter);
@@ -229,26 +338,20 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
             NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
+            if(!nfc_supported_cards_signature_match(&plugin_cache->signature, device)) continue;
 
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, plugin_cache->path, api_interface);
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_get_resident_plugin(instance, plugin_cache);
             if(plugin == NULL) continue;
 
-            if(plugin->verify) {
-                if(!plugin->verify(nfc)) continue;
+            bool verified = (plugin->verify == NULL) || plugin->verify(nfc);
+            if(verified && plugin->read && plugin->read(nfc, device)) {
+                card_read = true;
             }
 
-            if(plugin->read) {
-                if(plugin->read(nfc, device)) {
-                    card_read = true;
-                    break;
-                }
-            }
+            nfc_supported_cards_trim_resident(instance);
+            if(card_read) break;
         }
-
-        nfc_supported_cards_load_context_free(instance->load_context);
     } while(false);
 
     return card_read;
@@ -268,8 +371,6 @@ bool nfc_supported_cards_parse(
     do {
         if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
 
-        instance->load_context = nfc_supported_cards_load_context_alloc();
-
         NfcSupportedCardsPluginCache_it_t iter;
         for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
             !NfcSupportedCardsPluginCache_end_p(iter);
@@ -277,22 +378,19 @@ bool nfc_supported_cards_parse(
             NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasParse) == 0) continue;
+            if(!nfc_supported_cards_signature_match(&plugin_cache->signature, device)) continue;
 
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, plugin_cache->path, api_interface);
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_get_resident_plugin(instance, plugin_cache);
             if(plugin == NULL) continue;
 
-            if(plugin->parse) {
-                if(plugin->parse(device, parsed_data)) {
-                    card_parsed = true;
-                    break;
-                }
+            if(plugin->parse && plugin->parse(device, parsed_data)) {
+                card_parsed = true;
             }
-        }
 
-        nfc_supported_cards_load_context_free(instance->load_context);
+            nfc_supported_cards_trim_resident(instance);
+            if(card_parsed) break;
+        }
     } while(false);
 
     return card_parsed;
@@ -16,11 +16,11 @@ typedef struct {
 } MfClassicKeyPair;
 
 typedef struct {
-    MfClassicKeyPair* keys;
+    const MfClassicKeyPair* keys;
     uint32_t verify_sector;
 } HiCardConfig;
 
-static MfClassicKeyPair hi_1k_keys[] = {
+static const MfClassicKeyPair hi_1k_keys[] = {
     {.a = 0xa0a1a2a3a4a5, .b = 0x30871CF60CF1}, // 000
     {.a = 0x000000000000, .b = 0x000000000000}, // 001
     {.a = 0x000000000000, .b = 0x000000000000}, // 002
@@ -137,18 +137,18 @@ static bool hi_read(Nfc* nfc, NfcDevice* device) {
         uint8_t keyB[HI_KEY_TO_GEN][KEY_LENGTH];
         hi_generate_key(uid, keyA, keyB);
 
-        for(size_t i = 0; i < mf_classic_get_total_sectors_num(data->type); i++) {
-            if(cfg.keys[i].a == 0x000000000000 && cfg.keys[i].b == 0x000000000000) {
-                cfg.keys[i].a = bit_lib_bytes_to_num_be(keyA[i], KEY_LENGTH);
-                cfg.keys[i].b = bit_lib_bytes_to_num_be(keyB[i], KEY_LENGTH);
-            }
-        }
-
+        // Sectors without keys in the table use the ones generated for this card
         MfClassicDeviceKeys keys = {};
         for(size_t i = 0; i < mf_classic_get_total_sectors_num(data->type); i++) {
-            bit_lib_num_to_bytes_be(cfg.keys[i].a, sizeof(MfClassicKey), keys.key_a[i].data);
+            uint64_t key_a = cfg.keys[i].a;
+            uint64_t key_b = cfg.keys[i].b;
+            if(key_a == 0x000000000000 && key_b == 0x000000000000) {
+                key_a = bit_lib_bytes_to_num_be(keyA[i], KEY_LENGTH);
+                key_b = bit_lib_bytes_to_num_be(keyB[i], KEY_LENGTH);
+            }
+            bit_lib_num_to_bytes_be(key_a, sizeof(MfClassicKey), keys.key_a[i].data);
             FURI_BIT_SET(keys.key_a_mask, i);
-            bit_lib_num_to_bytes_be(cfg.keys[i].b, sizeof(MfClassicKey), keys.key_b[i].data);
+            bit_lib_num_to_bytes_be(key_b, sizeof(MfClassicKey), keys.key_b[i].data);
             FURI_BIT_SET(keys.key_b_mask, i);
         }
 
@@ -211,6 +211,7 @@ static const NfcSupportedCardsPlugin hi_plugin = {
     .verify = hi_verify,
     .read = hi_read,
     .parse = hi_parse,
+    .signature = {.uid_len = UID_LENGTH},
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -14,7 +14,7 @@ typedef struct {
     uint64_t b;
 } MfClassicKeyPair;
 
-static MfClassicKeyPair microel_1k_keys[] = {
+static const MfClassicKeyPair microel_1k_keys[] = {
     {.a = 0x000000000000, .b = 0x000000000000}, // 000
     {.a = 0x000000000000, .b = 0x000000000000}, // 001
     {.a = 0xffffffffffff, .b = 0xffffffffffff}, // 002
@@ -126,22 +126,16 @@ static bool microel_read(Nfc* nfc, NfcDevice* device) {
             break;
         }
 
-        // Save keys generated to stucture
-        for(size_t i = 0; i < mf_classic_get_total_sectors_num(data->type); i++) {
-            if(microel_1k_keys[i].a == 0x000000000000) {
-                microel_1k_keys[i].a = bit_lib_bytes_to_num_be(keyA, KEY_LENGTH);
-            }
-            if(microel_1k_keys[i].b == 0x000000000000) {
-                microel_1k_keys[i].b = bit_lib_bytes_to_num_be(keyB, KEY_LENGTH);
-            }
-        }
+        // Zero keys of the table are replaced by the ones generated for this card
+        uint64_t num_key_a = bit_lib_bytes_to_num_be(keyA, KEY_LENGTH);
+        uint64_t num_key_b = bit_lib_bytes_to_num_be(keyB, KEY_LENGTH);
         MfClassicDeviceKeys keys = {};
         for(size_t i = 0; i < mf_classic_get_total_sectors_num(data->type); i++) {
-            bit_lib_num_to_bytes_be(
-                microel_1k_keys[i].a, sizeof(MfClassicKey), keys.key_a[i].data);
+            uint64_t key_a = microel_1k_keys[i].a ? microel_1k_keys[i].a : num_key_a;
+            uint64_t key_b = microel_1k_keys[i].b ? microel_1k_keys[i].b : num_key_b;
+            bit_lib_num_to_bytes_be(key_a, sizeof(MfClassicKey), keys.key_a[i].data);
             FURI_BIT_SET(keys.key_a_mask, i);
-            bit_lib_num_to_bytes_be(
-                microel_1k_keys[i].b, sizeof(MfClassicKey), keys.key_b[i].data);
+            bit_lib_num_to_bytes_be(key_b, sizeof(MfClassicKey), keys.key_b[i].data);
             FURI_BIT_SET(keys.key_b_mask, i);
         }
 
@@ -216,6 +210,7 @@ static const NfcSupportedCardsPlugin microel_plugin = {
         NULL, // the verification I need is based on verifying the keys generated via uid and try to authenticate not like on mizip that there is default b0 but added verify in read function
     .read = microel_read,
     .parse = microel_parse,
+    .signature = {.uid_len = UID_LENGTH},
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -36,7 +36,7 @@
 /**
  * @brief Currently supported plugin API version.
  */
-#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 1
+#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 2
 
 /**
  * @brief Verify that the card is of a supported type.
@@ -81,6 +81,22 @@ typedef bool (*NfcSupportedCardPluginRead)(Nfc* nfc, NfcDevice* device);
  */
 typedef bool (*NfcSupportedCardPluginParse)(const NfcDevice* device, FuriString* parsed_data);
 
+/**
+ * @brief Card signature of a supported card plugin.
+ *
+ * Plugin is not loaded for cards that don't match the signature, so it must
+ * only be declared if none of the plugin functions can succeed for such cards.
+ * Zero-initialised signature matches any card. SAK and ATQA are compared under
+ * their masks and require a protocol based on ISO14443-3A.
+ */
+typedef struct {
+    uint8_t uid_len; /**< Exact UID length, 0 to match any. */
+    uint8_t sak; /**< Expected SAK bits. */
+    uint8_t sak_mask; /**< SAK bits to compare, 0 to match any. */
+    uint8_t atqa[2]; /**< Expected ATQA bits. */
+    uint8_t atqa_mask[2]; /**< ATQA bits to compare, 0 to match any. */
+} NfcSupportedCardPluginSignature;
+
 /**
  * @brief Supported card plugin interface.
  *
@@ -91,4 +107,5 @@ typedef struct {
     NfcSupportedCardPluginVerify verify; /**< Pointer to the verify() function. */
     NfcSupportedCardPluginRead read; /**< Pointer to the read() function. */
     NfcSupportedCardPluginParse parse; /**< Pointer to the parse() function. */
+    NfcSupportedCardPluginSignature signature; /**< Cards this plugin may work with. */
 } NfcSupportedCardsPlugin;
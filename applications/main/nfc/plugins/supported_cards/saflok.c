@@ -20,7 +20,7 @@ typedef struct {
     uint64_t b;
 } MfClassicKeyPair;
 
-static MfClassicKeyPair saflok_1k_keys[] = {
+static const MfClassicKeyPair saflok_1k_keys[] = {
     {.a = 0x000000000000, .b = 0xffffffffffff}, // 000
     {.a = 0x2a2c13cc242a, .b = 0xffffffffffff}, // 001
     {.a = 0xffffffffffff, .b = 0xffffffffffff}, // 002
@@ -122,15 +122,11 @@ static bool saflok_read(Nfc* nfc, NfcDevice* device) {
         uint64_t num_key = bit_lib_bytes_to_num_be(key, KEY_LENGTH);
         FURI_LOG_D(TAG, "Saflok: Key generated for UID: %012llX", num_key);
 
-        for(size_t i = 0; i < mf_classic_get_total_sectors_num(data->type); i++) {
-            if(saflok_1k_keys[i].a == 0x000000000000) {
-                saflok_1k_keys[i].a = num_key;
-            }
-        }
-
+        // Zero keys of the table are replaced by the one generated for this card
         MfClassicDeviceKeys keys = {};
         for(size_t i = 0; i < mf_classic_get_total_sectors_num(data->type); i++) {
-            bit_lib_num_to_bytes_be(saflok_1k_keys[i].a, sizeof(MfClassicKey), keys.key_a[i].data);
+            uint64_t key_a = saflok_1k_keys[i].a ? saflok_1k_keys[i].a : num_key;
+            bit_lib_num_to_bytes_be(key_a, sizeof(MfClassicKey), keys.key_a[i].data);
             FURI_BIT_SET(keys.key_a_mask, i);
             bit_lib_num_to_bytes_be(saflok_1k_keys[i].b, sizeof(MfClassicKey), keys.key_b[i].data);
             FURI_BIT_SET(keys.key_b_mask, i);
@@ -159,6 +155,7 @@ static const NfcSupportedCardsPlugin saflok_plugin = {
     .read = saflok_read,
     // KDF mode
     .parse = NULL,
+    .signature = {.uid_len = UID_LENGTH},
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -857,6 +857,8 @@ static void subghz_cli_command_print_usage(void) {
             "\tencrypt_keeloq <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt keeloq manufacture keys\r\n");
         printf(
             "\tencrypt_raw <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt RAW data\r\n");
+        printf(
+            "\tcompile_keeloq <path_keystore_file> <path_compiled_file> <IV:16 bytes in hex, optional>\t - Compile keeloq manufacture keys to binary keystore\r\n");
     }
 }
 
@@ -901,6 +903,52 @@ static void subghz_cli_command_encrypt_keeloq(Cli* cli, FuriString* args) {
     furi_string_free(source);
 }
 
+static void subghz_cli_command_compile_keeloq(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+    uint8_t iv[16];
+    bool has_iv = false;
+
+    FuriString* source = furi_string_alloc();
+    FuriString* destination = furi_string_alloc();
+
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, source)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!args_read_string_and_trim(args, destination)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(furi_string_size(args)) {
+            if(!args_read_hex_bytes(args, iv, 16)) {
+                subghz_cli_command_print_usage();
+                break;
+            }
+            has_iv = true;
+        }
+
+        if(!subghz_keystore_load(keystore, furi_string_get_cstr(source))) {
+            printf("Failed to load Keystore");
+            break;
+        }
+
+        if(!subghz_keystore_save_binary(
+               keystore, furi_string_get_cstr(destination), has_iv ? iv : NULL)) {
+            printf("Failed to save Keystore");
+            break;
+        }
+    } while(false);
+
+    subghz_keystore_free(keystore);
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_encrypt_raw(Cli* cli, FuriString* args) {
     UNUSED(cli);
     uint8_t iv[16];
@@ -1175,6 +1223,11 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
                 break;
             }
 
+            if(furi_string_cmp_str(cmd, "compile_keeloq") == 0) {
+                subghz_cli_command_compile_keeloq(cli, args);
+                break;
+            }
+
             if(furi_string_cmp_str(cmd, "tx_carrier") == 0) {
                 subghz_cli_command_tx_carrier(cli, args, context);
                 break;
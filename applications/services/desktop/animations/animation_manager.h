@@ -22,6 +22,9 @@ typedef struct FrameBubble {
     const struct FrameBubble* next_bubble;
 } FrameBubble;
 
+/** Frames of external animation read from SD card on demand */
+typedef struct AnimationFrameStream AnimationFrameStream;
+
 typedef struct {
     const FrameBubble* const* frame_bubble_sequences;
     uint8_t frame_bubble_sequences_count;
@@ -32,6 +35,7 @@ typedef struct {
     uint8_t active_cycles;
     uint16_t duration;
     uint16_t active_cooldown;
+    AnimationFrameStream* frame_stream; ///< NULL if icon_animation holds all frames
 } BubbleAnimation;
 
 typedef void (*AnimationManagerSetNewIdleAnimationCallback)(void* context);
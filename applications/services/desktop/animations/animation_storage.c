@@ -14,9 +14,51 @@
 #include <assets_dolphin_blocking.h>
 
 #define ANIMATION_META_FILE "meta.txt"
+#define ANIMATION_PACK_FILE "frames.pack"
 #define ANIMATION_DIR EXT_PATH("dolphin")
 #define TAG "AnimationStorage"
 
+#define ANIMATION_PACK_MAGIC 0x50464144 // "DAFP"
+#define ANIMATION_PACK_VERSION 3
+/** Frames read from pack at once */
+#define ANIMATION_PACK_WINDOW 8
+/** Directory entries read at once while checking frame files */
+#define ANIMATION_PACK_SCAN_BATCH 8
+#define ANIMATION_PACK_SCAN_NAME_LEN 32
+
+/*
+ * Pack of animation frames
+ *
+ * Built from frame_N.bm files on first load of external animation, valid
+ * while meta.txt has the same size and modification time and directory has
+ * the same frame files with the same sizes. Frame replaced by one of the same
+ * size needs meta.txt to be touched. Header is followed by frame_count + 1
+ * offsets of frame data and data of all frames.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t frame_count;
+    uint32_t meta_size;
+    uint32_t meta_mtime;
+    uint32_t frames_hash; ///< FNV-1a of names and sizes of frame files in directory order
+} FURI_PACKED AnimationPackHeader;
+
+typedef struct {
+    uint16_t start;
+    uint16_t count;
+    uint8_t* data; ///< Data of count frames starting from start
+} AnimationFrameWindow;
+
+struct AnimationFrameStream {
+    FuriString* path;
+    uint16_t frame_count;
+    uint32_t* offsets;
+    FuriMutex* mutex; ///< Guards windows, never held while reading storage
+    AnimationFrameWindow window; ///< Frames available for drawing
+    AnimationFrameWindow prefetched; ///< Frames read ahead, taken over by drawing
+};
+
 static void animation_storage_free_bubbles(BubbleAnimation* animation);
 static void animation_storage_free_frames(BubbleAnimation* animation);
 static void animation_storage_free_animation(BubbleAnimation** storage_animation);
@@ -222,12 +264,25 @@ void animation_storage_cache_animation(StorageAnimation* storage_animation) {
     }
 }
 
+static void animation_storage_free_stream(AnimationFrameStream* stream) {
+    furi_string_free(stream->path);
+    free(stream->offsets);
+    furi_mutex_free(stream->mutex);
+    free(stream->window.data);
+    free(stream->prefetched.data);
+    free(stream);
+}
+
 static void animation_storage_free_animation(BubbleAnimation** animation) {
     furi_assert(animation);
 
     if(*animation) {
         animation_storage_free_bubbles(*animation);
-        animation_storage_free_frames(*animation);
+        if((*animation)->frame_stream) {
+            animation_storage_free_stream((*animation)->frame_stream);
+        } else {
+            animation_storage_free_frames(*animation);
+        }
         if((*animation)->frame_order) {
             free((void*)(*animation)->frame_order);
         }
@@ -283,6 +338,21 @@ static void animation_storage_free_frames(BubbleAnimation* animation) {
     free((void*)icon->frames);
 }
 
+static bool animation_storage_max_frame(
+    const BubbleAnimation* animation,
+    const uint32_t* frame_order,
+    size_t* max_frame_count) {
+    uint16_t frame_order_count = animation->passive_frames + animation->active_frames;
+
+    /* The frames should go in order (0...N), without omissions */
+    *max_frame_count = 0;
+    for(int i = 0; i < frame_order_count; ++i) {
+        *max_frame_count = MAX(*max_frame_count, frame_order[i]);
+    }
+
+    return (*max_frame_count < frame_order_count) && (*max_frame_count < 256 /* max uint8_t */);
+}
+
 static bool animation_storage_load_frames(
     Storage* storage,
     const char* name,
@@ -290,17 +360,8 @@ static bool animation_storage_load_frames(
     uint32_t* frame_order,
     uint8_t width,
     uint8_t height) {
-    uint16_t frame_order_count = animation->passive_frames + animation->active_frames;
-
-    /* The frames should go in order (0...N), without omissions */
     size_t max_frame_count = 0;
-    for(int i = 0; i < frame_order_count; ++i) {
-        max_frame_count = MAX(max_frame_count, frame_order[i]);
-    }
-
-    if((max_frame_count >= frame_order_count) || (max_frame_count >= 256 /* max uint8_t */)) {
-        return false;
-    }
+    if(!animation_storage_max_frame(animation, frame_order, &max_frame_count)) return false;
 
     Icon* icon = (Icon*)&animation->icon_animation;
     FURI_CONST_ASSIGN(icon->frame_count, max_frame_count + 1);
@@ -369,6 +430,319 @@ static bool animation_storage_load_frames(
     return frames_ok;
 }
 
+// Fold names and sizes of frame files into hash, reading animation directory once
+static bool animation_storage_frames_hash(Storage* storage, const char* name, uint32_t* hash) {
+    FuriString* path = furi_string_alloc_printf(ANIMATION_DIR "/%s", name);
+    File* dir = storage_file_alloc(storage);
+    FileInfo* file_info = malloc(sizeof(FileInfo) * ANIMATION_PACK_SCAN_BATCH);
+    char* names = malloc(ANIMATION_PACK_SCAN_BATCH * ANIMATION_PACK_SCAN_NAME_LEN);
+    bool success = false;
+
+    *hash = 2166136261UL;
+    if(storage_dir_open(dir, furi_string_get_cstr(path))) {
+        size_t count;
+        while((count = storage_dir_read_batch(
+                   dir,
+                   file_info,
+                   names,
+                   ANIMATION_PACK_SCAN_BATCH * ANIMATION_PACK_SCAN_NAME_LEN,
+                   ANIMATION_PACK_SCAN_NAME_LEN,
+                   ANIMATION_PACK_SCAN_BATCH)) > 0) {
+            const char* entry = names;
+            for(size_t i = 0; i < count; ++i) {
+                size_t length = strlen(entry);
+                if(strncmp(entry, "frame_", 6) == 0 && length > 3 &&
+                   strcmp(entry + length - 3, ".bm") == 0) {
+                    const uint32_t size = file_info[i].size;
+                    for(size_t j = 0; j < length; ++j) {
+                        *hash = (*hash ^ (uint8_t)entry[j]) * 16777619UL;
+                    }
+                    for(size_t j = 0; j < sizeof(size); ++j) {
+                        *hash = (*hash ^ ((const uint8_t*)&size)[j]) * 16777619UL;
+                    }
+                }
+                entry += length + 1;
+            }
+        }
+        success = storage_file_get_error(dir) == FSE_NOT_EXIST;
+    }
+
+    free(names);
+    free(file_info);
+    storage_file_free(dir);
+    furi_string_free(path);
+    return success;
+}
+
+static bool animation_storage_pack_header(
+    Storage* storage,
+    const char* name,
+    uint16_t frame_count,
+    AnimationPackHeader* header) {
+    FuriString* path = furi_string_alloc_printf(ANIMATION_DIR "/%s/" ANIMATION_META_FILE, name);
+    FileInfo file_info;
+    bool success = false;
+
+    do {
+        if(storage_common_stat(storage, furi_string_get_cstr(path), &file_info) != FSE_OK) break;
+        if(storage_common_mtime(storage, furi_string_get_cstr(path), &header->meta_mtime) !=
+           FSE_OK)
+            break;
+        header->meta_size = file_info.size;
+
+        // Frame added, removed or resized without touching meta.txt still outdates the pack
+        if(!animation_storage_frames_hash(storage, name, &header->frames_hash)) break;
+
+        header->magic = ANIMATION_PACK_MAGIC;
+        header->version = ANIMATION_PACK_VERSION;
+        header->frame_count = frame_count;
+        success = true;
+    } while(0);
+
+    furi_string_free(path);
+    return success;
+}
+
+// Convert frame_N.bm files into a single pack file
+static bool animation_storage_build_pack(
+    Storage* storage,
+    const char* name,
+    const AnimationPackHeader* header,
+    size_t max_frame_size) {
+    FuriString* path = furi_string_alloc_printf(ANIMATION_DIR "/%s/" ANIMATION_PACK_FILE, name);
+    File* pack = storage_file_alloc(storage);
+    File* file = storage_file_alloc(storage);
+    uint32_t* offsets = malloc(sizeof(uint32_t) * (header->frame_count + 1));
+    uint8_t* frame = malloc(max_frame_size);
+    FuriString* filename = furi_string_alloc();
+    const size_t offsets_size = sizeof(uint32_t) * (header->frame_count + 1);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(pack, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(pack, header, sizeof(*header)) != sizeof(*header)) break;
+        // Offsets are known after frames are written
+        if(storage_file_write(pack, offsets, offsets_size) != offsets_size) break;
+
+        offsets[0] = sizeof(*header) + offsets_size;
+        size_t i = 0;
+        for(; i < header->frame_count; ++i) {
+            furi_string_printf(filename, ANIMATION_DIR "/%s/frame_%zu.bm", name, i);
+            if(!storage_file_open(
+                   file, furi_string_get_cstr(filename), FSAM_READ, FSOM_OPEN_EXISTING)) {
+                FURI_LOG_E(TAG, "Can't open file \'%s\'", furi_string_get_cstr(filename));
+                break;
+            }
+            uint64_t size = storage_file_size(file);
+            if(size > max_frame_size) {
+                FURI_LOG_E(TAG, "Filesize %llu, max: %zu", size, max_frame_size);
+                break;
+            }
+            bool read = storage_file_read(file, frame, size) == size;
+            storage_file_close(file);
+            if(!read || storage_file_write(pack, frame, size) != size) break;
+            offsets[i + 1] = offsets[i] + size;
+        }
+        if(i != header->frame_count) break;
+
+        if(!storage_file_seek(pack, sizeof(*header), true)) break;
+        if(storage_file_write(pack, offsets, offsets_size) != offsets_size) break;
+        success = true;
+    } while(0);
+
+    storage_file_free(pack);
+    if(!success) {
+        FURI_LOG_E(TAG, "Failed to pack \'%s\'", name);
+        storage_common_remove(storage, furi_string_get_cstr(path));
+    }
+
+    furi_string_free(filename);
+    free(frame);
+    free(offsets);
+    storage_file_free(file);
+    furi_string_free(path);
+    return success;
+}
+
+static AnimationFrameStream* animation_storage_open_stream(
+    Storage* storage,
+    const char* name,
+    const AnimationPackHeader* expected,
+    size_t max_frame_size) {
+    AnimationFrameStream* stream = malloc(sizeof(AnimationFrameStream));
+    stream->path = furi_string_alloc_printf(ANIMATION_DIR "/%s/" ANIMATION_PACK_FILE, name);
+    stream->frame_count = expected->frame_count;
+    stream->offsets = malloc(sizeof(uint32_t) * (expected->frame_count + 1));
+    stream->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    const size_t offsets_size = sizeof(uint32_t) * (expected->frame_count + 1);
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(stream->path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        AnimationPackHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(memcmp(&header, expected, sizeof(header)) != 0) {
+            FURI_LOG_D(TAG, "Pack of \'%s\' is outdated", name);
+            break;
+        }
+        if(storage_file_read(file, stream->offsets, offsets_size) != offsets_size) break;
+        if(stream->offsets[0] != sizeof(header) + offsets_size) break;
+
+        size_t i = 0;
+        for(; i < stream->frame_count; ++i) {
+            uint32_t size = stream->offsets[i + 1] - stream->offsets[i];
+            if(stream->offsets[i + 1] < stream->offsets[i] || size > max_frame_size) break;
+        }
+        if(i != stream->frame_count) break;
+        if(stream->offsets[i] != storage_file_size(file)) break;
+        success = true;
+    } while(0);
+
+    storage_file_free(file);
+    if(!success) {
+        animation_storage_free_stream(stream);
+        stream = NULL;
+    }
+
+    return stream;
+}
+
+static bool animation_storage_stream_frames(
+    Storage* storage,
+    const char* name,
+    BubbleAnimation* animation,
+    uint32_t* frame_order,
+    uint8_t width,
+    uint8_t height) {
+    size_t max_frame_count = 0;
+    if(!animation_storage_max_frame(animation, frame_order, &max_frame_count)) return false;
+
+    AnimationPackHeader header;
+    if(!animation_storage_pack_header(storage, name, max_frame_count + 1, &header)) return false;
+    size_t max_frame_size = ROUND_UP_TO(width, 8) * height + 1;
+
+    animation->frame_stream =
+        animation_storage_open_stream(storage, name, &header, max_frame_size);
+    if(!animation->frame_stream &&
+       animation_storage_build_pack(storage, name, &header, max_frame_size)) {
+        animation->frame_stream =
+            animation_storage_open_stream(storage, name, &header, max_frame_size);
+    }
+    if(!animation->frame_stream) return false;
+
+    Icon* icon = (Icon*)&animation->icon_animation;
+    FURI_CONST_ASSIGN(icon->frame_count, max_frame_count + 1);
+    FURI_CONST_ASSIGN(icon->frame_rate, 0);
+    FURI_CONST_ASSIGN(icon->height, height);
+    FURI_CONST_ASSIGN(icon->width, width);
+    icon->frames = NULL;
+
+    return true;
+}
+
+static bool animation_storage_window_has(const AnimationFrameWindow* window, uint16_t index) {
+    return window->data && (index >= window->start) && (index < window->start + window->count);
+}
+
+// Read frames starting from index into new window
+static bool animation_storage_stream_read(
+    AnimationFrameStream* stream,
+    uint16_t index,
+    AnimationFrameWindow* window) {
+    uint16_t count = MIN(ANIMATION_PACK_WINDOW, stream->frame_count - index);
+    uint32_t offset = stream->offsets[index];
+    uint32_t size = stream->offsets[index + count] - offset;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(size);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(stream->path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(!storage_file_seek(file, offset, true)) break;
+        if(storage_file_read(file, data, size) != size) break;
+        success = true;
+    } while(0);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(success) {
+        window->start = index;
+        window->count = count;
+        window->data = data;
+    } else {
+        FURI_LOG_E(TAG, "Failed to read frame %u", index);
+        free(data);
+    }
+
+    return success;
+}
+
+bool animation_storage_prefetch_frame(const BubbleAnimation* animation, uint8_t index) {
+    furi_assert(animation);
+    furi_check(index < animation->icon_animation.frame_count);
+
+    AnimationFrameStream* stream = animation->frame_stream;
+    if(!stream) return true;
+
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+    bool loaded = animation_storage_window_has(&stream->window, index) ||
+                  animation_storage_window_has(&stream->prefetched, index);
+    furi_check(furi_mutex_release(stream->mutex) == FuriStatusOk);
+    if(loaded) return true;
+
+    AnimationFrameWindow window;
+    if(!animation_storage_stream_read(stream, index, &window)) return false;
+
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+    uint8_t* unused = stream->prefetched.data;
+    stream->prefetched = window;
+    furi_check(furi_mutex_release(stream->mutex) == FuriStatusOk);
+    free(unused);
+
+    return true;
+}
+
+const uint8_t* animation_storage_get_frame(const BubbleAnimation* animation, uint8_t index) {
+    furi_assert(animation);
+    furi_check(index < animation->icon_animation.frame_count);
+
+    AnimationFrameStream* stream = animation->frame_stream;
+    if(!stream) return animation->icon_animation.frames[index];
+
+    const uint8_t* frame = NULL;
+    uint8_t* unused = NULL;
+
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+    if(!animation_storage_window_has(&stream->window, index) &&
+       animation_storage_window_has(&stream->prefetched, index)) {
+        unused = stream->window.data;
+        stream->window = stream->prefetched;
+        stream->prefetched.data = NULL;
+    }
+    if(animation_storage_window_has(&stream->window, index)) {
+        frame = stream->window.data + stream->offsets[index] -
+                stream->offsets[stream->window.start];
+    }
+    furi_check(furi_mutex_release(stream->mutex) == FuriStatusOk);
+    free(unused);
+
+    if(!frame) {
+        FURI_LOG_D(TAG, "Frame %u is not prefetched", index);
+    }
+
+    return frame;
+}
+
 static bool animation_storage_load_bubbles(BubbleAnimation* animation, FlipperFormat* ff) {
     uint32_t u32value;
     FuriString* str;
@@ -498,7 +872,8 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
         }
 
         /* passive and active frames must be loaded up to this point */
-        if(!animation_storage_load_frames(storage, name, animation, u32array, width, height))
+        if(!animation_storage_stream_frames(storage, name, animation, u32array, width, height) &&
+           !animation_storage_load_frames(storage, name, animation, u32array, width, height))
             break;
 
         if(!flipper_format_read_uint32(ff, "Active cycles", &u32value, 1)) break; //-V779
@@ -524,6 +899,9 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
         if(animation->frame_order) {
             free((void*)animation->frame_order);
         }
+        if(animation->frame_stream) {
+            animation_storage_free_stream(animation->frame_stream);
+        }
         free(animation);
         animation = NULL;
     }
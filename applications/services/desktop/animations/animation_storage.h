@@ -54,6 +54,30 @@ const BubbleAnimation* animation_storage_get_bubble_animation(StorageAnimation*
  */
 void animation_storage_cache_animation(StorageAnimation* storage_animation);
 
+/**
+ * Read frame of bubble animation into memory ahead of drawing.
+ * Frames of external animations are streamed from SD card,
+ * this is the only call which reads them. Don't call it
+ * from draw callback.
+ *
+ * @animation   bubble animation
+ * @index       frame index
+ * @return      true if frame is in memory
+ */
+bool animation_storage_prefetch_frame(const BubbleAnimation* animation, uint8_t index);
+
+/**
+ * Get frame data of bubble animation.
+ * Never reads storage: frame of external animation has to be
+ * prefetched before, returned data is valid until next call
+ * for the same animation.
+ *
+ * @animation   bubble animation
+ * @index       frame index
+ * @return      frame data, NULL if frame is not prefetched
+ */
+const uint8_t* animation_storage_get_frame(const BubbleAnimation* animation, uint8_t index);
+
 /**
  * Find animation by name.
  * Search through the inner flash, and SD-card if has.
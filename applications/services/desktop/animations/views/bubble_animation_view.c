@@ -14,6 +14,16 @@
 
 #define ACTIVE_SHIFT 2
 
+#define PREFETCH_THREAD_STACK_SIZE 1024
+
+typedef enum {
+    BubbleAnimationPrefetchEvtNext = (1 << 0),
+    BubbleAnimationPrefetchEvtStop = (1 << 1),
+} BubbleAnimationPrefetchEvt;
+
+#define BUBBLE_ANIMATION_PREFETCH_EVT_ALL \
+    (BubbleAnimationPrefetchEvtNext | BubbleAnimationPrefetchEvtStop)
+
 typedef struct {
     const BubbleAnimation* current;
     const FrameBubble* current_bubble;
@@ -29,6 +39,8 @@ typedef struct {
 struct BubbleAnimationView {
     View* view;
     FuriTimer* timer;
+    FuriThread* prefetch_thread; ///< Reads frames ahead, timer daemon must not wait for SD card
+    FuriMutex* prefetch_mutex; ///< Keeps current animation alive while its frames are read
     BubbleAnimationInteractCallback interact_callback;
     void* interact_callback_context;
 };
@@ -76,8 +88,10 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    const uint8_t* frame = animation_storage_get_frame(animation, index);
+    if(frame) {
+        canvas_draw_bitmap(canvas, 0, y_offset, width, height, frame);
+    }
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -223,6 +237,70 @@ static void bubble_animation_next_frame(BubbleAnimationViewModel* model) {
     }
 }
 
+static void bubble_animation_prefetch_lock(BubbleAnimationView* view) {
+    furi_check(furi_mutex_acquire(view->prefetch_mutex, FuriWaitForever) == FuriStatusOk);
+}
+
+static void bubble_animation_prefetch_unlock(BubbleAnimationView* view) {
+    furi_check(furi_mutex_release(view->prefetch_mutex) == FuriStatusOk);
+}
+
+/* Frame index which timer tick is going to show, found by
+ * playing the tick on a copy of the model
+ */
+static uint8_t bubble_animation_get_next_frame_index(const BubbleAnimationViewModel* model) {
+    BubbleAnimationViewModel next = *model;
+
+    if((next.active_shift == 1) && (next.current->active_frames > 0)) {
+        next.current_frame = next.current->passive_frames;
+    } else {
+        bubble_animation_next_frame(&next);
+    }
+
+    return bubble_animation_get_frame_index(&next);
+}
+
+/* Read frame of the next tick while current one is shown,
+ * so that draw callback never waits for SD card
+ */
+static void bubble_animation_prefetch_next_frame(BubbleAnimationView* view) {
+    const BubbleAnimation* animation = NULL;
+    uint8_t index = 0;
+
+    BubbleAnimationViewModel* model = view_get_model(view->view);
+    if(model->current && !model->freeze_frame) {
+        animation = model->current;
+        index = bubble_animation_get_next_frame_index(model);
+    }
+    view_commit_model(view->view, false);
+
+    if(animation) {
+        animation_storage_prefetch_frame(animation, index);
+    }
+}
+
+static int32_t bubble_animation_prefetch_worker(void* context) {
+    BubbleAnimationView* view = context;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            BUBBLE_ANIMATION_PREFETCH_EVT_ALL, FuriFlagWaitAny, FuriWaitForever);
+        furi_check((flags & FuriFlagError) == 0);
+        if(flags & BubbleAnimationPrefetchEvtStop) break;
+
+        bubble_animation_prefetch_lock(view);
+        bubble_animation_prefetch_next_frame(view);
+        bubble_animation_prefetch_unlock(view);
+    }
+
+    return 0;
+}
+
+static void bubble_animation_prefetch_request(BubbleAnimationView* view) {
+    furi_thread_flags_set(
+        furi_thread_get_id(view->prefetch_thread), BubbleAnimationPrefetchEvtNext);
+}
+
 static void bubble_animation_timer_callback(void* context) {
     furi_assert(context);
     BubbleAnimationView* view = context;
@@ -243,16 +321,18 @@ static void bubble_animation_timer_callback(void* context) {
     if(activate) {
         bubble_animation_activate_right_now(view);
     }
+
+    bubble_animation_prefetch_request(view);
 }
 
 /* always freeze first passive frame, because
  * animation is always activated at unfreezing and played
  * passive frame first, and 2 frames after - active
  */
-static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
-    furi_assert(icon_orig);
-    furi_assert(icon_orig->frames);
-    furi_assert(icon_orig->frames[0]);
+static Icon* bubble_animation_clone_first_frame(const BubbleAnimation* animation) {
+    furi_assert(animation);
+    const Icon* icon_orig = &animation->icon_animation;
+    const uint8_t* frame = animation_storage_get_frame(animation, 0);
 
     Icon* icon_clone = malloc(sizeof(Icon));
     memcpy(icon_clone, icon_orig, sizeof(Icon));
@@ -265,7 +345,8 @@ static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
      */
     size_t max_bitmap_size = ROUND_UP_TO(icon_orig->width, 8) * icon_orig->height + 1;
     FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], malloc(max_bitmap_size));
-    memcpy((void*)icon_clone->frames[0], icon_orig->frames[0], max_bitmap_size);
+    /* zeroed buffer is a blank uncompressed bitmap if frame can't be read */
+    if(frame) memcpy((void*)icon_clone->frames[0], frame, max_bitmap_size);
     FURI_CONST_ASSIGN(icon_clone->frame_count, 1);
 
     return icon_clone;
@@ -309,6 +390,9 @@ BubbleAnimationView* bubble_animation_view_alloc(void) {
     view->view = view_alloc();
     view->interact_callback = NULL;
     view->timer = furi_timer_alloc(bubble_animation_timer_callback, FuriTimerTypePeriodic, view);
+    view->prefetch_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    view->prefetch_thread = furi_thread_alloc_ex(
+        "AnimPrefetch", PREFETCH_THREAD_STACK_SIZE, bubble_animation_prefetch_worker, view);
 
     view_allocate_model(view->view, ViewModelTypeLocking, sizeof(BubbleAnimationViewModel));
     view_set_context(view->view, view);
@@ -316,6 +400,7 @@ BubbleAnimationView* bubble_animation_view_alloc(void) {
     view_set_input_callback(view->view, bubble_animation_input_callback);
     view_set_enter_callback(view->view, bubble_animation_enter);
     view_set_exit_callback(view->view, bubble_animation_exit);
+    furi_thread_start(view->prefetch_thread);
 
     return view;
 }
@@ -323,12 +408,20 @@ BubbleAnimationView* bubble_animation_view_alloc(void) {
 void bubble_animation_view_free(BubbleAnimationView* view) {
     furi_assert(view);
 
+    // Timer callback wakes prefetch thread, stop it first
+    furi_timer_free(view->timer);
+    furi_thread_flags_set(
+        furi_thread_get_id(view->prefetch_thread), BubbleAnimationPrefetchEvtStop);
+    furi_thread_join(view->prefetch_thread);
+    furi_thread_free(view->prefetch_thread);
+
     view_set_draw_callback(view->view, NULL);
     view_set_input_callback(view->view, NULL);
     view_set_context(view->view, NULL);
 
     view_free(view->view);
     view->view = NULL;
+    furi_mutex_free(view->prefetch_mutex);
     free(view);
 }
 
@@ -348,6 +441,10 @@ void bubble_animation_view_set_animation(
     furi_assert(view);
     furi_assert(new_animation);
 
+    // Previous animation may be freed after return, wait for its frames to be read
+    bubble_animation_prefetch_lock(view);
+    animation_storage_prefetch_frame(new_animation, new_animation->frame_order[0]);
+
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model);
     model->current = new_animation;
@@ -368,6 +465,8 @@ void bubble_animation_view_set_animation(
     model->current_frame = 0;
     model->active_cycle = 0;
     view_commit_model(view->view, true);
+    bubble_animation_prefetch_unlock(view);
+    bubble_animation_prefetch_request(view);
 
     furi_timer_start(view->timer, 1000 / new_animation->icon_animation.frame_rate);
 }
@@ -375,12 +474,21 @@ void bubble_animation_view_set_animation(
 void bubble_animation_freeze(BubbleAnimationView* view) {
     furi_assert(view);
 
+    // Animation is freed after freeze, wait for its frames to be read
+    bubble_animation_prefetch_lock(view);
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model->current);
     furi_assert(!model->freeze_frame);
-    model->freeze_frame = bubble_animation_clone_first_frame(&model->current->icon_animation);
+    const BubbleAnimation* animation = model->current;
+    view_commit_model(view->view, false);
+
+    animation_storage_prefetch_frame(animation, 0);
+
+    model = view_get_model(view->view);
+    model->freeze_frame = bubble_animation_clone_first_frame(model->current);
     model->current = NULL;
     view_commit_model(view->view, false);
+    bubble_animation_prefetch_unlock(view);
     furi_timer_stop(view->timer);
 }
 
@@ -394,6 +502,7 @@ void bubble_animation_unfreeze(BubbleAnimationView* view) {
     furi_assert(model->current);
     frame_rate = model->current->icon_animation.frame_rate;
     view_commit_model(view->view, true);
+    bubble_animation_prefetch_request(view);
 
     furi_timer_start(view->timer, 1000 / frame_rate);
     bubble_animation_activate(view, false);
@@ -18,6 +18,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init(void) {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc();
+    compress_icon_set_cache_size(canvas->compress_icon, CANVAS_ICON_CACHE_SIZE);
 
     // Initialize mutex
     canvas->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
@@ -32,6 +33,9 @@ Canvas* canvas_init(void) {
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
     u8g2_SetPowerSave(&canvas->fb, 0);
+    // Display content is unknown, first commit sends every page
+    canvas->committed_buffer = malloc(canvas_get_buffer_size(canvas));
+    canvas->commit_full = true;
 
     // Clear buffer and send to device
     canvas_clear(canvas);
@@ -45,6 +49,7 @@ void canvas_free(Canvas* canvas) {
     compress_icon_free(canvas->compress_icon);
     CanvasCallbackPairArray_clear(canvas->canvas_callback_pair);
     furi_mutex_free(canvas->mutex);
+    free(canvas->committed_buffer);
     free(canvas);
 }
 
@@ -70,10 +75,38 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_check(canvas);
-    u8g2_SendBuffer(&canvas->fb);
 
-    // Iterate over callbacks
+    u8g2_t* fb = &canvas->fb;
+    const uint8_t* buffer = u8g2_GetBufferPtr(fb);
+    const uint8_t tile_width = u8g2_GetBufferTileWidth(fb);
+    const size_t page_size = tile_width * 8;
+
     canvas_lock(canvas);
+    bool full = canvas->commit_full || canvas->committed_orientation != canvas->orientation;
+    canvas->commit_full = false;
+    canvas->committed_orientation = canvas->orientation;
+    canvas->commit_stats.commits++;
+
+    // Send changed pages only
+    uint32_t pages = 0;
+    for(uint8_t page = 0; page < u8g2_GetBufferTileHeight(fb); page++) {
+        const uint8_t* data = &buffer[page * page_size];
+        uint8_t* committed = &canvas->committed_buffer[page * page_size];
+        if(!full && memcmp(data, committed, page_size) == 0) continue;
+
+        memcpy(committed, data, page_size);
+        u8x8_DrawTile(u8g2_GetU8x8(fb), 0, page, tile_width, (uint8_t*)data);
+        pages++;
+    }
+
+    canvas->commit_stats.pages += pages;
+    if(pages) {
+        u8x8_RefreshDisplay(u8g2_GetU8x8(fb));
+    } else {
+        canvas->commit_stats.skipped++;
+    }
+
+    // Callbacks see every commit, screen streaming relies on it for keyframes
     for
         M_EACH(p, canvas->canvas_callback_pair, CanvasCallbackPairArray_t) {
             p->callback(
@@ -90,6 +123,33 @@ uint8_t* canvas_get_buffer(Canvas* canvas) {
     return u8g2_GetBufferPtr(&canvas->fb);
 }
 
+void canvas_get_committed_frame(Canvas* canvas, uint8_t* data, CanvasOrientation* orientation) {
+    furi_check(canvas);
+    furi_check(data);
+    furi_check(orientation);
+
+    canvas_lock(canvas);
+    memcpy(data, canvas->committed_buffer, canvas_get_buffer_size(canvas));
+    *orientation = canvas->committed_orientation;
+    canvas_unlock(canvas);
+}
+
+void canvas_get_commit_stats(Canvas* canvas, CanvasCommitStats* stats) {
+    furi_check(canvas);
+    furi_check(stats);
+
+    canvas_lock(canvas);
+    *stats = canvas->commit_stats;
+    canvas_unlock(canvas);
+}
+
+void canvas_get_icon_cache_stats(Canvas* canvas, CompressIconCacheStats* stats) {
+    furi_check(canvas);
+    furi_check(stats);
+
+    compress_icon_get_cache_stats(canvas->compress_icon, stats);
+}
+
 size_t canvas_get_buffer_size(const Canvas* canvas) {
     furi_check(canvas);
     return u8g2_GetBufferTileWidth(&canvas->fb) * u8g2_GetBufferTileHeight(&canvas->fb) * 8;
@@ -302,6 +362,192 @@ void canvas_draw_icon_animation(
         IconRotation0);
 }
 
+/*
+ * Native 1bpp blitter
+ *
+ * Writes bitmap straight into page organized frame buffer, where each byte
+ * holds 8 vertical pixels with LSB on top. Pixels land exactly where
+ * canvas_draw_u8g2_bitmap_int() puts them, clipped against u8g2 user window.
+ * Only used with full frame buffer and no display rotation, otherwise the
+ * per pixel path is taken.
+ */
+#define CANVAS_BLIT_MAX_SIZE 0x4000U
+
+typedef struct {
+    uint8_t* buffer;
+    uint16_t stride; ///< Bytes per page
+    uint8_t color;
+    bool transparent;
+    int32_t x0;
+    int32_t x1;
+    int32_t y0;
+    int32_t y1;
+} CanvasBlit;
+
+static bool canvas_blit_init(CanvasBlit* blit, u8g2_t* u8g2) {
+    if(u8g2->cb != U8G2_R0 || u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb) return false;
+    if(u8g2->tile_curr_row != 0) return false;
+
+    blit->buffer = u8g2->tile_buf_ptr;
+    blit->stride = u8g2->pixel_buf_width;
+    blit->color = u8g2->draw_color;
+    blit->transparent = u8g2->bitmap_transparency != 0;
+    blit->x0 = u8g2->user_x0;
+    blit->x1 = u8g2->user_x1;
+    blit->y0 = u8g2->user_y0;
+    blit->y1 = MIN(u8g2->user_y1, u8g2->pixel_buf_height);
+    return true;
+}
+
+// Set pixels are drawn with draw color, clear ones with its inverse unless transparent
+static inline void
+    canvas_blit_byte(const CanvasBlit* blit, uint8_t* dst, uint8_t bits, uint8_t mask) {
+    uint8_t set = bits & mask;
+    uint8_t clear = blit->transparent ? 0 : (uint8_t)(~bits & mask);
+    if(blit->color == 1) {
+        *dst = (*dst | set) & ~clear;
+    } else if(blit->color == 0) {
+        *dst = (*dst & ~set) | clear;
+    } else {
+        *dst = (*dst ^ set) & ~clear;
+    }
+}
+
+// Transpose 8x8 bit block: bit c of byte r becomes bit r of byte c
+static inline uint64_t canvas_blit_transpose(uint64_t block) {
+    uint64_t t;
+    t = (block ^ (block >> 7)) & 0x00AA00AA00AA00AAULL;
+    block ^= t ^ (t << 7);
+    t = (block ^ (block >> 14)) & 0x0000CCCC0000CCCCULL;
+    block ^= t ^ (t << 14);
+    t = (block ^ (block >> 28)) & 0x00000000F0F0F0F0ULL;
+    block ^= t ^ (t << 28);
+    return block;
+}
+
+/*
+ * Bitmap rows go horizontally, row n is drawn at y + n * dy
+ * Bitmap bytes of 8 rows falling into one page are transposed into 8 columns
+ */
+static void canvas_blit_rows(
+    const CanvasBlit* blit,
+    int32_t x,
+    int32_t y,
+    int32_t dy,
+    int32_t w,
+    int32_t h,
+    const uint8_t* bitmap) {
+    const int32_t blen = (w + 7) / 8;
+    const int32_t col_start = MAX(0, blit->x0 - x);
+    const int32_t col_end = MIN(w, blit->x1 - x);
+    const int32_t top = dy > 0 ? y : y - h + 1;
+    const int32_t row_start = MAX(blit->y0, top);
+    const int32_t row_end = MIN(blit->y1, top + h);
+    if(col_start >= col_end || row_start >= row_end) return;
+
+    for(int32_t page = row_start / 8; page * 8 < row_end; page++) {
+        const uint8_t* rows[8];
+        uint8_t mask = 0;
+        for(int32_t bit = 0; bit < 8; bit++) {
+            int32_t row = page * 8 + bit;
+            if(row >= row_start && row < row_end) {
+                rows[bit] = bitmap + (row - y) * dy * blen;
+                mask |= 1 << bit;
+            } else {
+                rows[bit] = NULL;
+            }
+        }
+
+        uint8_t* dst = blit->buffer + page * blit->stride;
+        for(int32_t byte = col_start / 8; byte * 8 < col_end; byte++) {
+            uint64_t block = 0;
+            for(size_t bit = 0; bit < 8; bit++) {
+                if(rows[bit]) block |= (uint64_t)u8x8_pgm_read(rows[bit] + byte) << (bit * 8);
+            }
+            block = canvas_blit_transpose(block);
+
+            int32_t col = byte * 8;
+            int32_t end = MIN(col + 8, col_end);
+            for(; col < col_start; col++) {
+                block >>= 8;
+            }
+            for(; col < end; col++) {
+                canvas_blit_byte(blit, &dst[x + col], block, mask);
+                block >>= 8;
+            }
+        }
+    }
+}
+
+/*
+ * Bitmap rows go vertically, row n is drawn at x + n * dx
+ * Row bits already have frame buffer order and are shifted into pages
+ */
+static void canvas_blit_columns(
+    const CanvasBlit* blit,
+    int32_t x,
+    int32_t dx,
+    int32_t y,
+    int32_t w,
+    int32_t h,
+    const uint8_t* bitmap) {
+    const int32_t blen = (w + 7) / 8;
+    const int32_t top = MAX(blit->y0, y);
+    const int32_t bottom = MIN(blit->y1, y + w);
+    if(top >= bottom) return;
+
+    for(int32_t n = 0; n < h; n++) {
+        int32_t col = x + n * dx;
+        if(col < blit->x0 || col >= blit->x1) continue;
+
+        const uint8_t* row = bitmap + n * blen;
+        uint8_t* dst = blit->buffer + col;
+        for(int32_t page = top / 8; page * 8 < bottom; page++) {
+            int32_t start = page * 8 - y; // Bitmap bit at top of the page
+            uint8_t bits;
+            if(start < 0) {
+                bits = u8x8_pgm_read(row) << -start;
+            } else {
+                int32_t byte = start / 8;
+                uint16_t word = u8x8_pgm_read(row + byte);
+                if(byte + 1 < blen) word |= u8x8_pgm_read(row + byte + 1) << 8;
+                bits = word >> (start % 8);
+            }
+
+            uint8_t mask = 0xFF;
+            if(page * 8 < top) mask &= 0xFF << (top - page * 8);
+            if(page * 8 + 8 > bottom) mask &= 0xFF >> (page * 8 + 8 - bottom);
+
+            canvas_blit_byte(blit, &dst[page * blit->stride], bits, mask);
+        }
+    }
+}
+
+static bool canvas_blit(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    bool mirror,
+    bool rotation,
+    const uint8_t* bitmap) {
+    CanvasBlit blit;
+    if(w >= CANVAS_BLIT_MAX_SIZE || h >= CANVAS_BLIT_MAX_SIZE) return false;
+    if(!canvas_blit_init(&blit, u8g2)) return false;
+    if(!u8g2->is_page_clip_window_intersection) return true;
+
+    // Same origins as per pixel path, wrapped to 16 bit and sign extended
+    if(rotation) {
+        int32_t x0 = (int16_t)(u8g2_uint_t)(mirror ? x : x + w + 1);
+        canvas_blit_columns(&blit, x0, mirror ? 1 : -1, (int16_t)y, w, h, bitmap);
+    } else {
+        int32_t y0 = (int16_t)(u8g2_uint_t)(mirror ? y + h - 1 : y);
+        canvas_blit_rows(&blit, (int16_t)x, y0, mirror ? -1 : 1, w, h, bitmap);
+    }
+    return true;
+}
+
 static void canvas_draw_u8g2_bitmap_int(
     u8g2_t* u8g2,
     u8g2_uint_t x,
@@ -311,6 +557,8 @@ static void canvas_draw_u8g2_bitmap_int(
     bool mirror,
     bool rotation,
     const uint8_t* bitmap) {
+    if(canvas_blit(u8g2, x, y, w, h, mirror, rotation, bitmap)) return;
+
     u8g2_uint_t blen;
     blen = w;
     blen += 7;
@@ -603,6 +851,8 @@ void canvas_add_framebuffer_callback(Canvas* canvas, CanvasCommitCallback callba
     canvas_lock(canvas);
     furi_check(!CanvasCallbackPairArray_count(canvas->canvas_callback_pair, p));
     CanvasCallbackPairArray_push_back(canvas->canvas_callback_pair, p);
+    // New callback gets current frame even if it does not change
+    canvas->commit_full = true;
     canvas_unlock(canvas);
 }
 
@@ -95,6 +95,10 @@ typedef struct Canvas Canvas;
 void canvas_reset(Canvas* canvas);
 
 /** Commit canvas. Send buffer to display
+ *
+ * Only pages changed since previous commit are sent, frame identical to the
+ * previous one is not sent at all. Framebuffer callbacks are called on every
+ * commit.
  *
  * @param      canvas  Canvas instance
  */
@@ -16,6 +16,11 @@
 extern "C" {
 #endif
 
+/** Decoded icon cache size, holds status bar and menu icons */
+#ifndef CANVAS_ICON_CACHE_SIZE
+#define CANVAS_ICON_CACHE_SIZE (4096u)
+#endif
+
 typedef void (*CanvasCommitCallback)(
     uint8_t* data,
     size_t size,
@@ -33,6 +38,12 @@ ARRAY_DEF(CanvasCallbackPairArray, CanvasCallbackPair, M_POD_OPLIST);
 
 ALGO_DEF(CanvasCallbackPairArray, CanvasCallbackPairArray_t);
 
+typedef struct {
+    uint32_t commits;
+    uint32_t skipped; ///< Commits identical to the previous frame
+    uint32_t pages; ///< Display pages sent
+} CanvasCommitStats;
+
 /** Canvas structure
  */
 struct Canvas {
@@ -45,6 +56,10 @@ struct Canvas {
     CompressIcon* compress_icon;
     CanvasCallbackPairArray_t canvas_callback_pair;
     FuriMutex* mutex;
+    uint8_t* committed_buffer; ///< Copy of the last frame sent to display
+    CanvasOrientation committed_orientation;
+    bool commit_full; ///< Send every page on next commit
+    CanvasCommitStats commit_stats;
 };
 
 /** Allocate memory and initialize canvas
@@ -75,6 +90,28 @@ uint8_t* canvas_get_buffer(Canvas* canvas);
  */
 size_t canvas_get_buffer_size(const Canvas* canvas);
 
+/** Copy last committed frame
+ *
+ * @param      canvas       Canvas instance
+ * @param      data         buffer of canvas_get_buffer_size() bytes to fill
+ * @param      orientation  pointer to orientation of the frame to fill
+ */
+void canvas_get_committed_frame(Canvas* canvas, uint8_t* data, CanvasOrientation* orientation);
+
+/** Get canvas commit counters
+ *
+ * @param      canvas  Canvas instance
+ * @param      stats   pointer to counters to fill
+ */
+void canvas_get_commit_stats(Canvas* canvas, CanvasCommitStats* stats);
+
+/** Get decoded icon cache counters
+ *
+ * @param      canvas  Canvas instance
+ * @param      stats   pointer to counters to fill
+ */
+void canvas_get_icon_cache_stats(Canvas* canvas, CompressIconCacheStats* stats);
+
 /** Set drawing region relative to real screen buffer
  *
  * @param      canvas    Canvas instance
@@ -365,6 +365,7 @@ static void gui_redraw(Gui* gui) {
         }
 
         canvas_commit(gui->canvas);
+        gui->redraws++;
     } while(false);
 
     gui_unlock(gui);
@@ -603,6 +604,31 @@ size_t gui_get_framebuffer_size(const Gui* gui) {
     return canvas_get_buffer_size(gui->canvas);
 }
 
+void gui_get_stats(Gui* gui, GuiStats* stats) {
+    furi_check(gui);
+    furi_check(stats);
+
+    CanvasCommitStats commit_stats;
+    canvas_get_commit_stats(gui->canvas, &commit_stats);
+
+    gui_lock(gui);
+    stats->redraws = gui->redraws;
+    gui_unlock(gui);
+    stats->flushes = commit_stats.commits - commit_stats.skipped;
+    stats->skipped = commit_stats.skipped;
+    stats->pages = commit_stats.pages;
+}
+
+void gui_get_icon_cache_stats(Gui* gui, CompressIconCacheStats* stats) {
+    furi_check(gui);
+    furi_check(stats);
+
+    // Icons are decoded while drawing, which is done under gui lock
+    gui_lock(gui);
+    canvas_get_icon_cache_stats(gui->canvas, stats);
+    gui_unlock(gui);
+}
+
 void gui_set_hide_statusbar(Gui* gui, bool hidden) {
     furi_assert(gui);
 
@@ -8,6 +8,8 @@
 #include "view_port.h"
 #include "canvas.h"
 
+#include <toolbox/compress.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,6 +38,14 @@ typedef void (*GuiCanvasCommitCallback)(
     CanvasOrientation orientation,
     void* context);
 
+/** Gui redraw and display flush counters */
+typedef struct {
+    uint32_t redraws; /**< Frames rendered by GUI service */
+    uint32_t flushes; /**< Frames sent to display */
+    uint32_t skipped; /**< Frames identical to the previous one, not sent */
+    uint32_t pages; /**< Display pages sent, full frame is 8 pages */
+} GuiStats;
+
 #define RECORD_GUI "gui"
 
 typedef struct Gui Gui;
@@ -103,6 +113,20 @@ void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback,
  */
 size_t gui_get_framebuffer_size(const Gui* gui);
 
+/** Get gui redraw and display flush counters
+ *
+ * @param      gui       Gui instance
+ * @param      stats     pointer to counters to fill
+ */
+void gui_get_stats(Gui* gui, GuiStats* stats);
+
+/** Get gui canvas decoded icon cache counters
+ *
+ * @param      gui       Gui instance
+ * @param      stats     pointer to counters to fill
+ */
+void gui_get_icon_cache_stats(Gui* gui, CompressIconCacheStats* stats);
+
 /** Set hidden statusbar
  *
  * Hide the statusbar (stacks if called multiple times).
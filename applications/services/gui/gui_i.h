@@ -55,6 +55,7 @@ struct Gui {
     bool direct_draw;
     ViewPortArray_t layers[GuiLayerMAX];
     Canvas* canvas;
+    uint32_t redraws;
 
     // Input
     FuriMessageQueue* input_queue;
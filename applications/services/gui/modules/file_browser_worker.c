@@ -18,6 +18,12 @@
 #define BROWSER_ROOT STORAGE_ANY_PATH_PREFIX
 #define FILE_NAME_LEN_MAX 256
 #define LONG_LOAD_THRESHOLD 100
+#define DIR_BATCH_COUNT 16
+#define DIR_BATCH_NAMES_SIZE 1024
+#define DIR_CACHE_COUNT 2
+#define DIR_CACHE_SIZE_MIN 1024
+#define DIR_CACHE_SIZE_MAX (8 * 1024)
+#define DIR_CACHE_FLAG_DIR (1 << 0)
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -35,6 +41,36 @@ typedef enum {
 ARRAY_DEF(IdxLastArray, int32_t)
 ARRAY_DEF(ExtFilterArray, FuriString*, FURI_STRING_OPLIST)
 
+/**
+ * Unfiltered listing of a folder, in storage order
+ *
+ * Shared by all workers and kept after they are freed, so a file dialog
+ * opened again does not read the folder from storage. Valid while storage
+ * reports the same folder version: it changes whenever an entry is created
+ * or removed in that folder and on remount.
+ */
+typedef struct {
+    char* path;
+    uint32_t version;
+    uint32_t last_use;
+    uint32_t readers; ///< Workers reading entries, cache is not replaced while nonzero
+    bool valid;
+    bool filling; ///< Owned by the worker reading the folder from storage
+    uint8_t* data; ///< Entries packed as flags byte followed by zero-terminated name
+    size_t size;
+    size_t capacity;
+    size_t size_max;
+} BrowserDirCache;
+
+typedef struct {
+    BrowserDirCache entries[DIR_CACHE_COUNT];
+    uint32_t clock; ///< Incremented on every use, orders entries for LRU
+    BrowserWorkerCacheStats stats;
+} BrowserDirCacheStore;
+
+// Entry table is updated in critical sections, data is accessed outside of them
+static BrowserDirCacheStore dir_cache_store;
+
 struct BrowserWorker {
     FuriThread* thread;
 
@@ -56,6 +92,257 @@ struct BrowserWorker {
     BrowserWorkerLongLoadCallback long_load_cb;
 };
 
+/** Directory entries read from storage in batches, one storage call per DIR_BATCH_COUNT items */
+typedef struct {
+    File* directory;
+    FileInfo info[DIR_BATCH_COUNT];
+    char names[DIR_BATCH_NAMES_SIZE];
+    size_t count;
+    size_t index;
+    size_t name_offset;
+} BrowserDirBatch;
+
+/** Directory entries, from listing cache when it is valid and from storage otherwise */
+typedef struct {
+    File* directory;
+    BrowserDirBatch* batch;
+    BrowserDirCache* cache; ///< Cache being read or filled, NULL if not used
+    size_t cache_offset;
+    bool cached; ///< Entries come from cache
+} BrowserDirReader;
+
+static BrowserDirBatch* browser_dir_batch_alloc(File* directory) {
+    BrowserDirBatch* batch = malloc(sizeof(BrowserDirBatch));
+    batch->directory = directory;
+    return batch;
+}
+
+static bool browser_dir_batch_read(BrowserDirBatch* batch, FileInfo* fileinfo, const char** name) {
+    if(batch->index == batch->count) {
+        batch->index = 0;
+        batch->name_offset = 0;
+        batch->count = storage_dir_read_batch(
+            batch->directory,
+            batch->info,
+            batch->names,
+            DIR_BATCH_NAMES_SIZE,
+            FILE_NAME_LEN_MAX,
+            DIR_BATCH_COUNT);
+        if(!batch->count) return false;
+    }
+
+    *fileinfo = batch->info[batch->index++];
+    *name = batch->names + batch->name_offset;
+    batch->name_offset += strlen(*name) + 1;
+    return true;
+}
+
+static uint8_t* browser_dir_cache_detach(BrowserDirCache* cache) {
+    uint8_t* data = cache->data;
+    cache->data = NULL;
+    cache->size = 0;
+    cache->capacity = 0;
+    cache->valid = false;
+    return data;
+}
+
+static BrowserDirCache* browser_dir_cache_find(Storage* storage, FuriString* path) {
+    uint32_t version = 0;
+    if(storage_common_dir_version(storage, furi_string_get_cstr(path), &version) != FSE_OK) {
+        return NULL;
+    }
+
+    BrowserDirCache* found = NULL;
+    uint8_t* stale[DIR_CACHE_COUNT] = {NULL};
+
+    FURI_CRITICAL_ENTER();
+    for(size_t i = 0; i < DIR_CACHE_COUNT; i++) {
+        BrowserDirCache* cache = &dir_cache_store.entries[i];
+        if(!cache->valid || strcmp(cache->path, furi_string_get_cstr(path)) != 0) continue;
+
+        if(cache->version == version) {
+            cache->readers++;
+            cache->last_use = ++dir_cache_store.clock;
+            found = cache;
+        } else if(!cache->readers) {
+            stale[i] = browser_dir_cache_detach(cache);
+        }
+    }
+    if(found) {
+        dir_cache_store.stats.hits++;
+    } else {
+        dir_cache_store.stats.misses++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    for(size_t i = 0; i < DIR_CACHE_COUNT; i++) {
+        free(stale[i]);
+    }
+
+    return found;
+}
+
+static void browser_dir_cache_release(BrowserDirCache* cache) {
+    FURI_CRITICAL_ENTER();
+    cache->readers--;
+    FURI_CRITICAL_EXIT();
+}
+
+static BrowserDirCache* browser_dir_cache_begin(Storage* storage, FuriString* path) {
+    uint32_t version = 0;
+    if(storage_common_dir_version(storage, furi_string_get_cstr(path), &version) != FSE_OK) {
+        return NULL;
+    }
+
+    size_t size_max = MIN((size_t)DIR_CACHE_SIZE_MAX, memmgr_heap_get_max_free_block() / 4);
+    if(size_max < DIR_CACHE_SIZE_MIN) return NULL;
+
+    char* path_copy = strdup(furi_string_get_cstr(path));
+    char* old_path = NULL;
+    uint8_t* old_data = NULL;
+    BrowserDirCache* cache = NULL;
+
+    FURI_CRITICAL_ENTER();
+    // Replace listing of the same path or the least recently used one, unless it is in use
+    for(size_t i = 0; i < DIR_CACHE_COUNT; i++) {
+        BrowserDirCache* entry = &dir_cache_store.entries[i];
+        if(entry->readers || entry->filling) continue;
+        if(entry->path && strcmp(entry->path, path_copy) == 0) {
+            cache = entry;
+            break;
+        }
+        if(!cache || (int32_t)(entry->last_use - cache->last_use) < 0) cache = entry;
+    }
+    if(cache) {
+        old_data = browser_dir_cache_detach(cache);
+        old_path = cache->path;
+        cache->path = path_copy;
+        cache->version = version;
+        cache->size_max = size_max;
+        cache->filling = true;
+        cache->last_use = ++dir_cache_store.clock;
+    }
+    FURI_CRITICAL_EXIT();
+
+    free(old_data);
+    free(old_path);
+    if(!cache) free(path_copy);
+
+    return cache;
+}
+
+static void browser_dir_cache_abort(BrowserDirCache* cache) {
+    FURI_CRITICAL_ENTER();
+    uint8_t* data = browser_dir_cache_detach(cache);
+    cache->filling = false;
+    FURI_CRITICAL_EXIT();
+
+    free(data);
+}
+
+static bool browser_dir_cache_add(BrowserDirCache* cache, const char* name, bool is_dir) {
+    size_t entry_size = strlen(name) + 2;
+
+    if(cache->size + entry_size > cache->capacity) {
+        size_t capacity = MAX(cache->capacity * 2, (size_t)DIR_CACHE_SIZE_MIN);
+        capacity = MIN(MAX(capacity, cache->size + entry_size), cache->size_max);
+        if(capacity < cache->size + entry_size) {
+            // Listing is too big to keep, folder will be read from storage every time
+            browser_dir_cache_abort(cache);
+            return false;
+        }
+        cache->data = realloc(cache->data, capacity); //-V701
+        cache->capacity = capacity;
+    }
+
+    cache->data[cache->size] = is_dir ? DIR_CACHE_FLAG_DIR : 0;
+    memcpy(&cache->data[cache->size + 1], name, entry_size - 1);
+    cache->size += entry_size;
+
+    return true;
+}
+
+static void browser_dir_cache_commit(BrowserDirCache* cache, Storage* storage, bool complete) {
+    uint32_t version = 0;
+    if(!complete ||
+       storage_common_dir_version(storage, cache->path, &version) != FSE_OK ||
+       version != cache->version) {
+        browser_dir_cache_abort(cache);
+        return;
+    }
+
+    // Cache outlives the worker, do not keep the slack
+    if(cache->size && cache->size < cache->capacity) {
+        cache->data = realloc(cache->data, cache->size); //-V701
+        cache->capacity = cache->size;
+    }
+
+    FURI_CRITICAL_ENTER();
+    cache->valid = true;
+    cache->filling = false;
+    FURI_CRITICAL_EXIT();
+}
+
+static bool browser_dir_open(Storage* storage, FuriString* path, BrowserDirReader* reader) {
+    memset(reader, 0, sizeof(BrowserDirReader));
+
+    reader->cache = browser_dir_cache_find(storage, path);
+    if(reader->cache) {
+        reader->cached = true;
+        return true;
+    }
+
+    reader->directory = storage_file_alloc(storage);
+    reader->batch = browser_dir_batch_alloc(reader->directory);
+    if(!storage_dir_open(reader->directory, furi_string_get_cstr(path))) {
+        return false;
+    }
+
+    // Fill cache while reading, it becomes valid once the whole folder is read
+    reader->cache = browser_dir_cache_begin(storage, path);
+    return true;
+}
+
+static bool browser_dir_read(BrowserDirReader* reader, const char** name, bool* is_dir) {
+    if(reader->cached) {
+        BrowserDirCache* cache = reader->cache;
+        if(reader->cache_offset >= cache->size) return false;
+
+        *is_dir = cache->data[reader->cache_offset] & DIR_CACHE_FLAG_DIR;
+        *name = (const char*)&cache->data[reader->cache_offset + 1];
+        reader->cache_offset += strlen(*name) + 2;
+        return true;
+    }
+
+    FileInfo file_info;
+    if(!browser_dir_batch_read(reader->batch, &file_info, name)) {
+        return false;
+    }
+
+    *is_dir = file_info_is_dir(&file_info);
+    if(reader->cache && !browser_dir_cache_add(reader->cache, *name, *is_dir)) {
+        reader->cache = NULL;
+    }
+    return true;
+}
+
+static void browser_dir_close(BrowserDirReader* reader, Storage* storage) {
+    if(reader->cached) {
+        browser_dir_cache_release(reader->cache);
+        return;
+    }
+
+    if(reader->cache) {
+        // Storage reports FSE_NOT_EXIST once there are no more entries
+        bool complete = (storage_file_get_error(reader->directory) == FSE_NOT_EXIST);
+        browser_dir_cache_commit(reader->cache, storage, complete);
+    }
+
+    free(reader->batch);
+    storage_dir_close(reader->directory);
+    storage_file_free(reader->directory);
+}
+
 static bool browser_path_is_file(FuriString* path) {
     bool state = false;
     FileInfo file_info;
@@ -175,50 +462,46 @@ static bool browser_folder_init(
     uint32_t* item_cnt,
     int32_t* file_idx) {
     bool state = false;
-    FileInfo file_info;
     uint32_t total_files_cnt = 0;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
+    BrowserDirReader reader;
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    const char* name_temp;
+    bool is_dir;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
     *item_cnt = 0;
     *file_idx = -1;
 
-    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+    if(browser_dir_open(storage, path, &reader)) {
         state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
+        while(browser_dir_read(&reader, &name_temp, &is_dir)) {
+            if(name_temp[0] == '\0') {
+                continue;
             }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
-                total_files_cnt++;
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    if(!furi_string_empty(filename)) {
-                        if(furi_string_cmp(name_str, filename) == 0) {
-                            *file_idx = *item_cnt;
-                        }
+            total_files_cnt++;
+            furi_string_set(name_str, name_temp);
+            if(browser_filter_by_name(browser, name_str, is_dir)) {
+                if(!furi_string_empty(filename)) {
+                    if(furi_string_cmp(name_str, filename) == 0) {
+                        *file_idx = *item_cnt;
                     }
-                    (*item_cnt)++;
                 }
-                if(total_files_cnt == LONG_LOAD_THRESHOLD) {
-                    // There are too many files in folder and counting them will take some time - send callback to app
-                    if(browser->long_load_cb) {
-                        browser->long_load_cb(browser->cb_ctx);
-                    }
+                (*item_cnt)++;
+            }
+            if((total_files_cnt == LONG_LOAD_THRESHOLD) && !reader.cached) {
+                // There are too many files in folder and counting them will take some time - send callback to app
+                if(browser->long_load_cb) {
+                    browser->long_load_cb(browser->cb_ctx);
                 }
             }
         }
     }
 
     furi_string_free(name_str);
-
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_close(&reader, storage);
 
     furi_record_close(RECORD_STORAGE);
 
@@ -231,34 +514,29 @@ static bool browser_folder_load_chunked(
     FuriString* path,
     uint32_t offset,
     uint32_t count) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
+    BrowserDirReader reader;
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    const char* name_temp;
+    bool is_dir;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
     uint32_t items_cnt = 0;
 
     do {
-        if(!storage_dir_open(directory, furi_string_get_cstr(path))) {
+        if(!browser_dir_open(storage, path, &reader)) {
             break;
         }
 
         items_cnt = 0;
         while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(!browser_dir_read(&reader, &name_temp, &is_dir)) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
-                break;
+            furi_string_set(name_str, name_temp);
+            if(browser_filter_by_name(browser, name_str, is_dir)) {
+                items_cnt++;
             }
         }
         if(items_cnt != offset) {
@@ -271,25 +549,16 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(!browser_dir_read(&reader, &name_temp, &is_dir)) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx,
-                            name_str,
-                            items_cnt,
-                            file_info_is_dir(&file_info),
-                            false);
-                    }
-                    items_cnt++;
+            furi_string_set(name_str, name_temp);
+            if(browser_filter_by_name(browser, name_str, is_dir)) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(browser->cb_ctx, name_str, items_cnt, is_dir, false);
                 }
-            } else {
-                break;
+                items_cnt++;
             }
         }
         if(browser->list_item_cb) {
@@ -298,9 +567,7 @@ static bool browser_folder_load_chunked(
     } while(0);
 
     furi_string_free(name_str);
-
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_close(&reader, storage);
 
     furi_record_close(RECORD_STORAGE);
 
@@ -309,12 +576,11 @@ static bool browser_folder_load_chunked(
 
 // Load all files at once, may cause memory overflow so need to limit that to about 400 files
 static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
+    BrowserDirReader reader;
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    const char* name_temp;
+    bool is_dir;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -322,20 +588,18 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
 
     bool ret = false;
     do {
-        if(!storage_dir_open(directory, furi_string_get_cstr(path))) {
+        if(!browser_dir_open(storage, path, &reader)) {
             break;
         }
         if(browser->list_load_cb) {
             browser->list_load_cb(browser->cb_ctx, 0);
         }
-        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX) &&
-              storage_file_get_error(directory) == FSE_OK) {
+        while(browser_dir_read(&reader, &name_temp, &is_dir)) {
             furi_string_set(name_str, name_temp);
-            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+            if(browser_filter_by_name(browser, name_str, is_dir)) {
                 furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
                 if(browser->list_item_cb) {
-                    browser->list_item_cb(
-                        browser->cb_ctx, name_str, items_cnt, file_info_is_dir(&file_info), false);
+                    browser->list_item_cb(browser->cb_ctx, name_str, items_cnt, is_dir, false);
                 }
                 items_cnt++;
             }
@@ -347,9 +611,7 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
     } while(0);
 
     furi_string_free(name_str);
-
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_close(&reader, storage);
 
     furi_record_close(RECORD_STORAGE);
 
@@ -593,3 +855,11 @@ void file_browser_worker_load(BrowserWorker* browser, uint32_t offset, uint32_t
     browser->load_count = count;
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtLoad);
 }
+
+void file_browser_worker_get_cache_stats(BrowserWorkerCacheStats* stats) {
+    furi_check(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = dir_cache_store.stats;
+    FURI_CRITICAL_EXIT();
+}
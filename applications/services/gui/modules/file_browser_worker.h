@@ -24,6 +24,11 @@ typedef void (*BrowserWorkerListItemCallback)(
     bool is_last);
 typedef void (*BrowserWorkerLongLoadCallback)(void* context);
 
+typedef struct {
+    uint32_t hits; ///< Folders listed from the listing cache
+    uint32_t misses; ///< Folders read from storage
+} BrowserWorkerCacheStats;
+
 BrowserWorker* file_browser_worker_alloc(
     FuriString* path,
     const char* base_path,
@@ -68,6 +73,12 @@ void file_browser_worker_folder_refresh(BrowserWorker* browser, int32_t item_idx
 
 void file_browser_worker_load(BrowserWorker* browser, uint32_t offset, uint32_t count);
 
+/** Get folder listing cache counters, shared by all workers
+ *
+ * @param      stats  pointer to stats to fill
+ */
+void file_browser_worker_get_cache_stats(BrowserWorkerCacheStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,20 +10,28 @@
 
 static_assert(!has_hash_collisions(elf_api_table), "Detected API method hash collision!");
 
+static constexpr auto elf_api_perfect_table = perfect_hash_table(elf_api_table);
+static_assert(
+    is_perfect_hash_valid(elf_api_perfect_table, elf_api_table),
+    "Failed to build API perfect hash table!");
+
 #ifdef APP_UNIT_TESTS
-constexpr HashtableApiInterface mock_elf_api_interface{
+constexpr PerfectHashApiInterface mock_elf_api_interface{
     {
         .api_version_major = 0,
         .api_version_minor = 0,
-        .resolver_callback = &elf_resolve_from_hashtable,
+        .resolver_callback = &elf_resolve_from_perfect_hashtable,
     },
     nullptr,
     nullptr,
+    0,
+    0,
 };
 
 const ElfApiInterface* const firmware_api_interface = &mock_elf_api_interface;
-#else
-constexpr HashtableApiInterface elf_api_interface{
+
+/* Real table behind both resolvers, for unit tests comparing them */
+constexpr HashtableApiInterface unit_tests_sorted_api_interface{
     {
         .api_version_major = (elf_api_version >> 16),
         .api_version_minor = (elf_api_version & 0xFFFF),
@@ -32,6 +40,37 @@ constexpr HashtableApiInterface elf_api_interface{
     elf_api_table.cbegin(),
     elf_api_table.cend(),
 };
+
+constexpr PerfectHashApiInterface unit_tests_perfect_api_interface{
+    {
+        .api_version_major = (elf_api_version >> 16),
+        .api_version_minor = (elf_api_version & 0xFFFF),
+        .resolver_callback = &elf_resolve_from_perfect_hashtable,
+    },
+    elf_api_perfect_table.slots.data(),
+    elf_api_perfect_table.displacements.data(),
+    elf_api_perfect_table.slots.size(),
+    elf_api_perfect_table.displacements.size(),
+};
+
+const sym_entry* const firmware_api_unit_tests_symbols = elf_api_table.data();
+const size_t firmware_api_unit_tests_symbol_count = elf_api_table.size();
+const ElfApiInterface* const firmware_api_unit_tests_sorted_interface =
+    &unit_tests_sorted_api_interface;
+const ElfApiInterface* const firmware_api_unit_tests_perfect_interface =
+    &unit_tests_perfect_api_interface;
+#else
+constexpr PerfectHashApiInterface elf_api_interface{
+    {
+        .api_version_major = (elf_api_version >> 16),
+        .api_version_minor = (elf_api_version & 0xFFFF),
+        .resolver_callback = &elf_resolve_from_perfect_hashtable,
+    },
+    elf_api_perfect_table.slots.data(),
+    elf_api_perfect_table.displacements.data(),
+    elf_api_perfect_table.slots.size(),
+    elf_api_perfect_table.displacements.size(),
+};
 const ElfApiInterface* const firmware_api_interface = &elf_api_interface;
 #endif
 
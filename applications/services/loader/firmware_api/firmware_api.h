@@ -3,3 +3,15 @@
 #include <flipper_application/elf/elf_api_interface.h>
 
 extern const ElfApiInterface* const firmware_api_interface;
+
+#ifdef APP_UNIT_TESTS
+#include <stddef.h>
+
+struct sym_entry;
+
+/* Unit test builds have no firmware API, these expose the table for resolver tests */
+extern const struct sym_entry* const firmware_api_unit_tests_symbols;
+extern const size_t firmware_api_unit_tests_symbol_count;
+extern const ElfApiInterface* const firmware_api_unit_tests_sorted_interface;
+extern const ElfApiInterface* const firmware_api_unit_tests_perfect_interface;
+#endif
@@ -27,6 +27,12 @@ typedef enum {
 
 #define RPC_ALL_EVENTS (RpcEvtNewData | RpcEvtDisconnect)
 
+// Room for the varint length prefix in front of the encoded message
+#define RPC_TX_HEADER_SIZE 5U
+#define RPC_TX_BUFFER_SIZE 640U
+// Buffers grown for bigger messages are freed after sending, big storage chunks still fit
+#define RPC_TX_BUFFER_RETAIN_SIZE 2560U
+
 DICT_DEF2(RpcHandlerDict, pb_size_t, M_DEFAULT_OPLIST, RpcHandler, M_POD_OPLIST)
 
 typedef struct {
@@ -78,6 +84,10 @@ struct RpcSession {
     void** system_contexts;
     bool decode_error;
 
+    FuriMutex* tx_mutex;
+    uint8_t* tx_buffer; ///< Reused by every rpc_send, guarded by tx_mutex
+    size_t tx_buffer_size;
+
     FuriMutex* callbacks_mutex;
     RpcSendBytesCallback send_bytes_callback;
     RpcBufferIsEmptyCallback buffer_is_empty_callback;
@@ -371,6 +381,8 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     furi_mutex_release(session->callbacks_mutex);
 
     furi_mutex_free(session->callbacks_mutex);
+    furi_mutex_free(session->tx_mutex);
+    free(session->tx_buffer);
     furi_thread_join(session->thread);
     furi_thread_free(session->thread);
     free(session);
@@ -387,6 +399,7 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
 
     RpcSession* session = malloc(sizeof(RpcSession));
     session->callbacks_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    session->tx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     session->stream = furi_stream_buffer_alloc(RPC_BUFFER_SIZE, 1);
     session->rpc = rpc;
     session->terminate = false;
@@ -453,36 +466,75 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
+static void rpc_session_tx_buffer_reserve(RpcSession* session, size_t size) {
+    if(session->tx_buffer_size >= size) return;
+
+    // Content is not kept, no need to realloc
+    free(session->tx_buffer);
+    session->tx_buffer = malloc(size);
+    session->tx_buffer_size = size;
+}
+
+static bool rpc_session_tx_encode(RpcSession* session, PB_Main* message, size_t* size) {
+    pb_ostream_t ostream = pb_ostream_from_buffer(
+        session->tx_buffer + RPC_TX_HEADER_SIZE, session->tx_buffer_size - RPC_TX_HEADER_SIZE);
+
+    if(!pb_encode(&ostream, &PB_Main_msg, message)) return false;
+
+    *size = ostream.bytes_written;
+    return true;
+}
+
 void rpc_send(RpcSession* session, PB_Main* message) {
     furi_assert(session);
     furi_assert(message);
 
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
-
 #if SRV_RPC_DEBUG
     FURI_LOG_I(TAG, "OUTPUT:");
     rpc_debug_print_message(message);
 #endif
 
-    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
-    furi_check(result && ostream.bytes_written);
+    furi_mutex_acquire(session->tx_mutex, FuriWaitForever);
+    rpc_session_tx_buffer_reserve(session, RPC_TX_BUFFER_SIZE);
 
-    uint8_t* buffer = malloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
+    // Encode once, sizing pass is only needed when message doesn't fit
+    size_t message_size = 0;
+    if(!rpc_session_tx_encode(session, message, &message_size)) {
+        pb_ostream_t ostream = PB_OSTREAM_SIZING;
+        bool result = pb_encode(&ostream, &PB_Main_msg, message);
+        furi_check(result);
 
-    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+        rpc_session_tx_buffer_reserve(session, ostream.bytes_written + RPC_TX_HEADER_SIZE);
+        result = rpc_session_tx_encode(session, message, &message_size);
+        furi_check(result);
+    }
+
+    // Length prefix goes right before the message, same as PB_ENCODE_DELIMITED
+    uint8_t header[RPC_TX_HEADER_SIZE];
+    pb_ostream_t header_stream = pb_ostream_from_buffer(header, sizeof(header));
+    pb_encode_varint(&header_stream, message_size);
+
+    uint8_t* buffer = session->tx_buffer + RPC_TX_HEADER_SIZE - header_stream.bytes_written;
+    size_t buffer_size = header_stream.bytes_written + message_size;
+    memcpy(buffer, header, header_stream.bytes_written);
 
 #if SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
+    rpc_debug_print_data("OUTPUT", buffer, buffer_size);
 #endif
 
+    // Send callback blocks until transport takes the data, buffer is free after it returns
     furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
     if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
+        session->send_bytes_callback(session->context, buffer, buffer_size);
     }
     furi_mutex_release(session->callbacks_mutex);
 
-    free(buffer);
+    if(session->tx_buffer_size > RPC_TX_BUFFER_RETAIN_SIZE) {
+        free(session->tx_buffer);
+        session->tx_buffer = NULL;
+        session->tx_buffer_size = 0;
+    }
+    furi_mutex_release(session->tx_mutex);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -18,7 +18,9 @@ typedef struct Rpc Rpc;
 /** Rpc session interface */
 typedef struct RpcSession RpcSession;
 
-/** Callback to send to client any data (e.g. response to command) */
+/** Callback to send to client any data (e.g. response to command)
+ *  Bytes are valid only during the call, block until transport takes them
+ */
 typedef void (*RpcSendBytesCallback)(void* context, uint8_t* bytes, size_t bytes_len);
 /** Callback to notify client that buffer is empty */
 typedef void (*RpcBufferIsEmptyCallback)(void* context);
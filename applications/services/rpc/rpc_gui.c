@@ -52,6 +52,10 @@ typedef enum {
 
 #define RPC_GUI_INPUT_RESET (0u)
 
+// Unchanged frame is still sent after this many ms, so clients see the stream is alive.
+// Static screen has no commits, transmit thread wakes up on its own for it.
+#define RPC_GUI_KEYFRAME_INTERVAL_MS (1000u)
+
 typedef struct {
     RpcSession* session;
     Gui* gui;
@@ -61,8 +65,15 @@ typedef struct {
     uint8_t* virtual_display_buffer;
 
     // Transmit
-    PB_Main* transmit_frame;
+    PB_Main* transmit_frame; ///< Last sent frame, only touched by transmit thread
     FuriThread* transmit_thread;
+    FuriMutex* pending_mutex;
+    uint8_t* pending_frame; ///< Latest committed frame, newer commits overwrite it
+    PB_Gui_ScreenOrientation pending_orientation;
+    bool transmit_frame_valid;
+    uint32_t transmit_tick;
+    uint32_t frames_sent;
+    uint32_t frames_skipped;
 
     bool virtual_display_not_empty;
     bool is_streaming;
@@ -92,17 +103,37 @@ static void rpc_system_gui_screen_stream_frame_callback(
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
 
     furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
 
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
-        rpc_system_gui_screen_orientation_map[orientation];
+    // Commits coming faster than the link drains overwrite each other here
+    furi_mutex_acquire(rpc_gui->pending_mutex, FuriWaitForever);
+    memcpy(rpc_gui->pending_frame, data, size);
+    rpc_gui->pending_orientation = rpc_system_gui_screen_orientation_map[orientation];
+    furi_mutex_release(rpc_gui->pending_mutex);
 
     furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
 }
 
+static bool rpc_system_gui_screen_stream_take_frame(RpcGuiSystem* rpc_gui) {
+    PB_Gui_ScreenFrame* frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    bool keyframe_due = (furi_get_tick() - rpc_gui->transmit_tick) >=
+                        furi_ms_to_ticks(RPC_GUI_KEYFRAME_INTERVAL_MS);
+
+    furi_mutex_acquire(rpc_gui->pending_mutex, FuriWaitForever);
+    bool changed = !rpc_gui->transmit_frame_valid ||
+                   (frame->orientation != rpc_gui->pending_orientation) ||
+                   memcmp(frame->data->bytes, rpc_gui->pending_frame, frame->data->size);
+    if(changed) {
+        memcpy(frame->data->bytes, rpc_gui->pending_frame, frame->data->size);
+        frame->orientation = rpc_gui->pending_orientation;
+    }
+    furi_mutex_release(rpc_gui->pending_mutex);
+
+    rpc_gui->transmit_frame_valid = true;
+    return changed || keyframe_due;
+}
+
 static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context) {
     furi_assert(context);
 
@@ -110,18 +141,30 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
 
     uint32_t transmit_time = 0;
     while(true) {
-        uint32_t flags =
-            furi_thread_flags_wait(RpcGuiWorkerFlagAny, FuriFlagWaitAny, FuriWaitForever);
+        uint32_t flags = furi_thread_flags_wait(
+            RpcGuiWorkerFlagAny,
+            FuriFlagWaitAny,
+            furi_ms_to_ticks(RPC_GUI_KEYFRAME_INTERVAL_MS));
+        if(flags == (unsigned)FuriFlagErrorTimeout) {
+            flags = RpcGuiWorkerFlagTransmit;
+        }
 
         if(flags & RpcGuiWorkerFlagTransmit) {
-            transmit_time = furi_get_tick();
-            rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
-            transmit_time = furi_get_tick() - transmit_time;
-
-            // Guaranteed bandwidth reserve
-            uint32_t extra_delay = transmit_time / 20;
-            if(extra_delay > 500) extra_delay = 500;
-            if(extra_delay) furi_delay_tick(extra_delay);
+            if(rpc_system_gui_screen_stream_take_frame(rpc_gui)) {
+                transmit_time = furi_get_tick();
+                rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
+                rpc_gui->transmit_tick = furi_get_tick();
+                rpc_gui->frames_sent++;
+                transmit_time = rpc_gui->transmit_tick - transmit_time;
+
+                // Guaranteed bandwidth reserve
+                uint32_t extra_delay = transmit_time / 20;
+                if(extra_delay > 500) extra_delay = 500;
+                if(extra_delay) furi_delay_tick(extra_delay);
+            } else {
+                // Client already has this picture
+                rpc_gui->frames_skipped++;
+            }
         }
 
         if(flags & RpcGuiWorkerFlagExit) {
@@ -157,10 +200,22 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
             malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
         rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+        rpc_gui->transmit_frame_valid = false;
+        rpc_gui->frames_sent = 0;
+        rpc_gui->frames_skipped = 0;
+        // Frame handoff from GUI thread
+        rpc_gui->pending_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        rpc_gui->pending_frame = malloc(framebuffer_size);
+        // Client gets current screen right away, not on next commit
+        CanvasOrientation orientation;
+        canvas_get_committed_frame(rpc_gui->gui->canvas, rpc_gui->pending_frame, &orientation);
+        rpc_gui->pending_orientation = rpc_system_gui_screen_orientation_map[orientation];
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
             "GuiRpcWorker", 1024, rpc_system_gui_screen_stream_frame_transmit_thread, rpc_gui);
         furi_thread_start(rpc_gui->transmit_thread);
+        furi_thread_flags_set(
+            furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
         // GUI framebuffer callback
         gui_add_framebuffer_callback(
             rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
@@ -186,10 +241,19 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
         furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
         furi_thread_join(rpc_gui->transmit_thread);
         furi_thread_free(rpc_gui->transmit_thread);
+        FURI_LOG_D(
+            TAG,
+            "Frames sent: %lu, unchanged and skipped: %lu",
+            rpc_gui->frames_sent,
+            rpc_gui->frames_skipped);
         // Release frame
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
         rpc_gui->transmit_frame = NULL;
+        free(rpc_gui->pending_frame);
+        rpc_gui->pending_frame = NULL;
+        furi_mutex_free(rpc_gui->pending_mutex);
+        rpc_gui->pending_mutex = NULL;
     }
 
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
@@ -523,6 +587,8 @@ void rpc_system_gui_free(void* context) {
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
         rpc_gui->transmit_frame = NULL;
+        free(rpc_gui->pending_frame);
+        furi_mutex_free(rpc_gui->pending_mutex);
     }
     furi_record_close(RECORD_GUI);
     free(rpc_gui);
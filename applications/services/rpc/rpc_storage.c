@@ -19,19 +19,51 @@
 
 static const size_t MAX_DATA_SIZE = 512;
 
+// Chunk size for transports that are known to handle big messages
+#define RPC_STORAGE_CHUNK_SIZE_MAX 2048U
+// Chunks in flight during pipelined read: one being read, one being sent
+#define RPC_STORAGE_READ_QUEUE_SIZE 2U
+
 typedef enum {
     RpcStorageStateIdle = 0,
     RpcStorageStateWriting,
 } RpcStorageState;
 
+/** Throughput counters, for the whole session */
+typedef struct {
+    uint32_t read_bytes;
+    uint32_t read_ticks;
+    uint32_t write_bytes;
+    uint32_t write_ticks;
+} RpcStorageStats;
+
 typedef struct {
     RpcSession* session;
     Storage* api;
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+
+    uint8_t* write_buffer; ///< Small incoming chunks are collected here
+    size_t write_buffer_size;
+    size_t write_buffer_used;
+    uint32_t write_start_tick;
+    uint32_t write_size; ///< Bytes received in current write
+
+    RpcStorageStats stats;
 } RpcStorageSystem;
 
+typedef struct {
+    File* file;
+    size_t size;
+    size_t chunk_size;
+    FuriMessageQueue* free_queue; ///< Empty chunks, pb_bytes_array_t*
+    FuriMessageQueue* ready_queue; ///< Chunks with data, pb_bytes_array_t*
+} RpcStorageReader;
+
+static bool rpc_system_storage_write_flush(RpcStorageSystem* rpc_storage);
+static void rpc_system_storage_log_throughput(const char* name, uint32_t bytes, uint32_t ticks);
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -48,9 +80,18 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            rpc_system_storage_write_flush(rpc_storage);
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
             furi_record_close(RECORD_STORAGE);
+
+            free(rpc_storage->write_buffer);
+            rpc_storage->write_buffer = NULL;
+
+            uint32_t ticks = furi_get_tick() - rpc_storage->write_start_tick;
+            rpc_storage->stats.write_bytes += rpc_storage->write_size;
+            rpc_storage->stats.write_ticks += ticks;
+            rpc_system_storage_log_throughput("Write", rpc_storage->write_size, ticks);
         }
 
         rpc_storage->state = RpcStorageStateIdle;
@@ -354,6 +395,118 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     furi_record_close(RECORD_STORAGE);
 }
 
+static size_t rpc_system_storage_get_chunk_size(RpcSession* session) {
+    // Other transports get the chunk size every client handles
+    RpcOwner owner = rpc_session_get_owner(session);
+    if(owner != RpcOwnerUsb && owner != RpcOwnerUart) {
+        return MAX_DATA_SIZE;
+    }
+
+    // Leave room for chunks in flight and for the rest of the system
+    size_t chunk_size = RPC_STORAGE_CHUNK_SIZE_MAX;
+    while(chunk_size > MAX_DATA_SIZE && chunk_size * 8 > memmgr_heap_get_max_free_block()) {
+        chunk_size /= 2;
+    }
+
+    return chunk_size;
+}
+
+static void rpc_system_storage_log_throughput(const char* name, uint32_t bytes, uint32_t ticks) {
+    uint32_t ms = ticks * 1000 / furi_kernel_get_tick_frequency();
+    FURI_LOG_D(TAG, "%s %lu bytes in %lu ms", name, bytes, ms);
+}
+
+static int32_t rpc_system_storage_reader_thread(void* context) {
+    RpcStorageReader* reader = context;
+
+    size_t size_left = reader->size;
+    while(size_left) {
+        pb_bytes_array_t* data = NULL;
+        furi_check(
+            furi_message_queue_get(reader->free_queue, &data, FuriWaitForever) == FuriStatusOk);
+
+        size_t read_size = MIN(size_left, reader->chunk_size);
+        data->size = storage_file_read(reader->file, data->bytes, read_size);
+        // Short chunk tells the sender to stop
+        size_left = (data->size == read_size) ? (size_left - read_size) : 0;
+
+        furi_check(
+            furi_message_queue_put(reader->ready_queue, &data, FuriWaitForever) == FuriStatusOk);
+    }
+
+    return 0;
+}
+
+/* Next chunk is read by a helper thread while the current one is being encoded and sent */
+static bool rpc_system_storage_read_pipelined(
+    RpcSession* session,
+    uint32_t command_id,
+    File* file,
+    size_t size,
+    size_t chunk_size) {
+    RpcStorageReader reader = {
+        .file = file,
+        .size = size,
+        .chunk_size = chunk_size,
+        .free_queue =
+            furi_message_queue_alloc(RPC_STORAGE_READ_QUEUE_SIZE, sizeof(pb_bytes_array_t*)),
+        .ready_queue =
+            furi_message_queue_alloc(RPC_STORAGE_READ_QUEUE_SIZE, sizeof(pb_bytes_array_t*)),
+    };
+
+    for(size_t i = 0; i < RPC_STORAGE_READ_QUEUE_SIZE; i++) {
+        pb_bytes_array_t* data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(chunk_size));
+        furi_message_queue_put(reader.free_queue, &data, 0);
+    }
+
+    FuriThread* thread =
+        furi_thread_alloc_ex("RpcStorageReader", 1024, rpc_system_storage_reader_thread, &reader);
+    furi_thread_start(thread);
+
+    PB_Main* response = malloc(sizeof(PB_Main));
+    bool success = true;
+    size_t size_left = size;
+
+    while(success && size_left) {
+        pb_bytes_array_t* data = NULL;
+        furi_check(
+            furi_message_queue_get(reader.ready_queue, &data, FuriWaitForever) == FuriStatusOk);
+
+        size_t read_size = MIN(size_left, chunk_size);
+        success = (data->size == read_size);
+        if(success) {
+            size_left -= read_size;
+
+            response->command_id = command_id;
+            response->which_content = PB_Main_storage_read_response_tag;
+            response->command_status = PB_CommandStatus_OK;
+            response->content.storage_read_response.has_file = true;
+            response->content.storage_read_response.file.data = data;
+            response->has_next = (size_left > 0);
+
+            // Chunk memory is reused, so no release here
+            rpc_send(session, response);
+        }
+
+        furi_check(furi_message_queue_put(reader.free_queue, &data, 0) == FuriStatusOk);
+    }
+
+    // Reader is done after a short chunk or the last one, all chunks are back in free queue
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    pb_bytes_array_t* data = NULL;
+    while(furi_message_queue_get(reader.free_queue, &data, 0) == FuriStatusOk) {
+        free(data);
+    }
+
+    furi_message_queue_free(reader.free_queue);
+    furi_message_queue_free(reader.ready_queue);
+    free(response);
+
+    return success;
+}
+
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -374,14 +527,25 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     File* file = storage_file_alloc(fs_api);
     bool fs_operation_success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
 
+    uint32_t start_tick = furi_get_tick();
+    size_t chunk_size = rpc_system_storage_get_chunk_size(session);
+    size_t file_size = 0;
+
     if(fs_operation_success) {
-        size_t size_left = storage_file_size(file);
+        file_size = storage_file_size(file);
+    }
+
+    if(fs_operation_success && (file_size > chunk_size)) {
+        fs_operation_success = rpc_system_storage_read_pipelined(
+            session, request->command_id, file, file_size, chunk_size);
+    } else if(fs_operation_success) {
+        size_t size_left = file_size;
         do {
             response->command_id = request->command_id;
             response->which_content = PB_Main_storage_read_response_tag;
             response->command_status = PB_CommandStatus_OK;
 
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
+            size_t read_size = MIN(size_left, chunk_size);
             if(read_size) {
                 response->content.storage_read_response.has_file = true;
                 response->content.storage_read_response.file.data =
@@ -412,7 +576,12 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
         } while((size_left != 0) && fs_operation_success);
     }
 
-    if(!fs_operation_success) {
+    if(fs_operation_success) {
+        uint32_t ticks = furi_get_tick() - start_tick;
+        rpc_storage->stats.read_bytes += file_size;
+        rpc_storage->stats.read_ticks += ticks;
+        rpc_system_storage_log_throughput("Read", file_size, ticks);
+    } else {
         rpc_send_and_release_empty(
             session, request->command_id, rpc_system_storage_get_file_error(file));
     }
@@ -424,6 +593,44 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     furi_record_close(RECORD_STORAGE);
 }
 
+static bool rpc_system_storage_write_flush(RpcStorageSystem* rpc_storage) {
+    size_t size = rpc_storage->write_buffer_used;
+    if(!size) return true;
+
+    rpc_storage->write_buffer_used = 0;
+    return storage_file_write(rpc_storage->file, rpc_storage->write_buffer, size) == size;
+}
+
+/* Incoming chunks are collected into chunk size writes, so small chunks don't cost a storage
+   round trip each */
+static bool rpc_system_storage_write_data(
+    RpcStorageSystem* rpc_storage,
+    const uint8_t* data,
+    size_t size) {
+    bool success = true;
+    rpc_storage->write_size += size;
+
+    while(success && size) {
+        // Big enough chunks go directly to the file
+        if(!rpc_storage->write_buffer_used && size >= rpc_storage->write_buffer_size) {
+            return storage_file_write(rpc_storage->file, data, size) == size;
+        }
+
+        size_t copy_size =
+            MIN(size, rpc_storage->write_buffer_size - rpc_storage->write_buffer_used);
+        memcpy(rpc_storage->write_buffer + rpc_storage->write_buffer_used, data, copy_size);
+        rpc_storage->write_buffer_used += copy_size;
+        data += copy_size;
+        size -= copy_size;
+
+        if(rpc_storage->write_buffer_used == rpc_storage->write_buffer_size) {
+            success = rpc_system_storage_write_flush(rpc_storage);
+        }
+    }
+
+    return success;
+}
+
 static void rpc_system_storage_write_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -455,6 +662,11 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
+        rpc_storage->write_buffer_size = rpc_system_storage_get_chunk_size(session);
+        rpc_storage->write_buffer = malloc(rpc_storage->write_buffer_size);
+        rpc_storage->write_buffer_used = 0;
+        rpc_storage->write_start_tick = furi_get_tick();
+        rpc_storage->write_size = 0;
         const char* path = request->content.storage_write_request.path;
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
@@ -469,8 +681,11 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            size_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+            fs_operation_success = rpc_system_storage_write_data(rpc_storage, buffer, buffer_size);
+        }
+
+        if(fs_operation_success && !request->has_next) {
+            fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
         }
 
         send_response = !request->has_next;
@@ -771,5 +986,12 @@ void rpc_system_storage_free(void* context) {
     furi_assert(session);
 
     rpc_system_storage_reset_state(rpc_storage, session, false);
+    FURI_LOG_D(
+        TAG,
+        "Session read %lu bytes in %lu ticks, wrote %lu bytes in %lu ticks",
+        rpc_storage->stats.read_bytes,
+        rpc_storage->stats.read_ticks,
+        rpc_storage->stats.write_bytes,
+        rpc_storage->stats.write_ticks);
     free(rpc_storage);
 }
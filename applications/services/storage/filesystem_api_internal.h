@@ -153,6 +153,13 @@ typedef struct {
  *      @param name_length name buffer length
  *      @return FS_Error error info
  * 
+ *  @var FS_Common_Api::mtime
+ *      @brief Get modification time of file/directory
+ *      @param path path to file/directory
+ *      @param fileinfo pointer to read FileInfo, can be NULL
+ *      @param timestamp pointer to modification time in UNIX format
+ *      @return FS_Error error info, FSE_NOT_IMPLEMENTED if fs has no timestamps
+ * 
  *  @var FS_Common_Api::remove
  *      @brief Remove file/directory from storage, 
  *          directory must be empty,
@@ -182,6 +189,11 @@ typedef struct {
  */
 typedef struct {
     FS_Error (*const stat)(void* context, const char* path, FileInfo* fileinfo);
+    FS_Error (*const mtime)(
+        void* context,
+        const char* path,
+        FileInfo* fileinfo,
+        uint32_t* timestamp);
     FS_Error (*const remove)(void* context, const char* path);
     FS_Error (*const mkdir)(void* context, const char* path);
     FS_Error (*const fs_info)(
@@ -149,6 +149,27 @@ size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write);
  */
 bool storage_file_seek(File* file, uint32_t offset, bool from_start);
 
+/** Single read of storage_file_read_batch() */
+typedef struct {
+    uint32_t offset; /**< Access position to read from, relative to the file start */
+    void* buff; /**< Buffer to be filled with read data */
+    size_t size; /**< Number of bytes to read */
+    size_t bytes_read; /**< Actual number of bytes read, set by storage_file_read_batch() */
+} StorageReadRequest;
+
+/**
+ * @brief Perform several seek and read operations in one storage call.
+ *
+ * Requests are processed in order, processing stops at the first failed or short read.
+ * The access position is left after the last processed request.
+ *
+ * @param file pointer to the file instance to read from.
+ * @param requests pointer to the array of read requests.
+ * @param count number of requests in the array.
+ * @return number of requests that were read completely.
+ */
+size_t storage_file_read_batch(File* file, StorageReadRequest* requests, size_t count);
+
 /**
  * @brief Get the current access position.
  *
@@ -259,6 +280,30 @@ bool storage_dir_close(File* file);
  */
 bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length);
 
+/**
+ * @brief Get several next items in the directory in one storage call.
+ *
+ * Names are stored one after another in the names buffer, each one zero-terminated.
+ * Reading stops after count items, or when less than name_length bytes are left in the buffer.
+ * If no item was read, the file error id tells the reason, FSE_NOT_EXIST meaning the end
+ * of the directory.
+ *
+ * @param file pointer to a file instance representing the directory in question.
+ * @param fileinfo pointer to the array of at least count FileInfo structures (may be NULL).
+ * @param names pointer to the buffer to contain the names.
+ * @param names_size capacity of the names buffer, in bytes.
+ * @param name_length maximum capacity for a single name, in bytes.
+ * @param count maximum number of items to read.
+ * @return number of items read.
+ */
+size_t storage_dir_read_batch(
+    File* file,
+    FileInfo* fileinfo,
+    char* names,
+    size_t names_size,
+    uint16_t name_length,
+    size_t count);
+
 /**
  * @brief Change the access position to first item in the directory.
  *
@@ -288,6 +333,53 @@ bool storage_dir_exists(Storage* storage, const char* path);
  */
 FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t* timestamp);
 
+/**
+ * @brief Get the modification time of a file or a directory in UNIX format.
+ *
+ * Only SD card keeps modification time, with 2 second resolution.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path of the item in question.
+ * @param timestamp pointer to a value to contain the timestamp.
+ * @return FSE_OK if the timestamp has been successfully received,
+ * FSE_NOT_IMPLEMENTED if the storage does not keep it, any other error code on failure.
+ */
+FS_Error storage_common_mtime(Storage* storage, const char* path, uint32_t* timestamp);
+
+/**
+ * @brief Get information and the modification time of a file or a directory in one call.
+ *
+ * Same as storage_common_stat() followed by storage_common_mtime(), with a single lookup.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path of the item in question.
+ * @param fileinfo pointer to the FileInfo structure to contain the info (may be NULL).
+ * @param timestamp pointer to a value to contain the timestamp.
+ * @return FSE_OK if both have been successfully received,
+ * FSE_NOT_IMPLEMENTED if the storage does not keep the timestamp, any other error code on failure.
+ */
+FS_Error storage_common_stat_mtime(
+    Storage* storage,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp);
+
+/**
+ * @brief Get the change counter of a directory.
+ *
+ * The counter grows whenever an entry is created or removed directly in the directory
+ * and whenever the volume is mounted, unmounted or formatted. Unlike the modification
+ * time, it is kept for every storage and never misses changes within the same second.
+ * Several directories may share a counter, so a different value means "may have changed"
+ * and an equal value means "unchanged".
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path of the directory.
+ * @param version pointer to a value to contain the counter.
+ * @return FSE_OK if the counter has been successfully received, any other error code on failure.
+ */
+FS_Error storage_common_dir_version(Storage* storage, const char* path, uint32_t* version);
+
 /**
  * @brief Get information about a file or a directory.
  *
@@ -298,6 +390,23 @@ FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t*
  */
 FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo);
 
+/**
+ * @brief Get information about several files or directories in one storage call.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param paths pointer to the array of zero-terminated strings containing the paths.
+ * @param fileinfo pointer to the array of count FileInfo structures to contain the info (may be NULL).
+ * @param errors pointer to the array of count error codes, one for each path (may be NULL).
+ * @param count number of paths.
+ * @return number of items whose info has been successfully received.
+ */
+size_t storage_common_stat_batch(
+    Storage* storage,
+    const char* const* paths,
+    FileInfo* fileinfo,
+    FS_Error* errors,
+    size_t count);
+
 /**
  * @brief Remove a file or a directory.
  *
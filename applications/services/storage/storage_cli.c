@@ -80,6 +80,16 @@ static void storage_cli_info(Cli* cli, FuriString* path) {
                 sd_info.product_serial_number,
                 sd_info.manufacturing_month,
                 sd_info.manufacturing_year);
+
+            FuriHalSdCacheStats cache_stats;
+            furi_hal_sd_get_cache_stats(&cache_stats);
+            printf(
+                "Cache: %lu hits, %lu misses, %lu evictions, %lu write-backs, %lu dirty\r\n",
+                cache_stats.hits,
+                cache_stats.misses,
+                cache_stats.evictions,
+                cache_stats.write_backs,
+                cache_stats.dirty);
         }
     } else {
         storage_cli_print_usage();
@@ -44,6 +44,7 @@
 #define S_RETURN_BOOL (return_data.bool_value);
 #define S_RETURN_UINT16 (return_data.uint16_value);
 #define S_RETURN_UINT64 (return_data.uint64_value);
+#define S_RETURN_SIZE (return_data.size_value);
 #define S_RETURN_ERROR (return_data.error_value);
 #define S_RETURN_CSTRING (return_data.cstring_value);
 
@@ -235,6 +236,28 @@ bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     return S_RETURN_BOOL;
 }
 
+size_t storage_file_read_batch(File* file, StorageReadRequest* requests, size_t count) {
+    S_FILE_API_PROLOGUE;
+    furi_check(requests || !count);
+
+    for(size_t i = 0; i < count; i++) {
+        requests[i].bytes_read = 0;
+    }
+
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .freadbatch = {
+            .file = file,
+            .requests = requests,
+            .count = count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileReadBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 uint64_t storage_file_tell(File* file) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -419,6 +442,33 @@ bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_
     return S_RETURN_BOOL;
 }
 
+size_t storage_dir_read_batch(
+    File* file,
+    FileInfo* fileinfo,
+    char* names,
+    size_t names_size,
+    uint16_t name_length,
+    size_t count) {
+    S_FILE_API_PROLOGUE;
+    furi_check(names);
+    furi_check(name_length);
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .dreadbatch = {
+            .file = file,
+            .fileinfo = fileinfo,
+            .names = names,
+            .names_size = names_size,
+            .name_length = name_length,
+            .count = count,
+        }};
+
+    S_API_MESSAGE(StorageCommandDirReadBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 bool storage_dir_rewind(File* file) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -459,6 +509,59 @@ FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t*
     return S_RETURN_ERROR;
 }
 
+FS_Error storage_common_mtime(Storage* storage, const char* path, uint32_t* timestamp) {
+    furi_check(storage);
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .ctimestamp = {
+            .path = path,
+            .timestamp = timestamp,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonMtime);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
+FS_Error storage_common_stat_mtime(
+    Storage* storage,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp) {
+    furi_check(storage);
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .ctimestamp = {
+            .path = path,
+            .timestamp = timestamp,
+            .fileinfo = fileinfo,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonMtime);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
+FS_Error storage_common_dir_version(Storage* storage, const char* path, uint32_t* version) {
+    furi_check(storage);
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .ctimestamp = {
+            .path = path,
+            .timestamp = version,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonDirVersion);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
 FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
     furi_check(storage);
 
@@ -475,6 +578,30 @@ FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* filei
     return S_RETURN_ERROR;
 }
 
+size_t storage_common_stat_batch(
+    Storage* storage,
+    const char* const* paths,
+    FileInfo* fileinfo,
+    FS_Error* errors,
+    size_t count) {
+    furi_check(storage);
+    furi_check(paths || !count);
+
+    S_API_PROLOGUE;
+    SAData data = {
+        .cstatbatch = {
+            .paths = paths,
+            .fileinfo = fileinfo,
+            .errors = errors,
+            .count = count,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonStatBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 FS_Error storage_common_remove(Storage* storage, const char* path) {
     furi_check(storage);
 
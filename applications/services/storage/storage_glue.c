@@ -1,5 +1,6 @@
 #include "storage_glue.h"
 #include <furi_hal.h>
+#include <ctype.h>
 
 #define TAG "StorageGlue"
 
@@ -73,6 +74,42 @@ uint32_t storage_data_get_timestamp(StorageData* storage) {
     return storage->timestamp;
 }
 
+static size_t storage_dir_version_slot(const char* path, size_t length) {
+    while(length > 0 && path[length - 1] == '/') {
+        length--;
+    }
+
+    // FNV-1a, case-insensitive to match FAT
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)tolower((unsigned char)path[i]);
+        hash *= 16777619UL;
+    }
+
+    return hash % STORAGE_DIR_VERSION_COUNT;
+}
+
+void storage_data_volume_changed(StorageData* storage) {
+    storage->volume_version = ++storage->generation;
+}
+
+void storage_data_dir_changed(StorageData* storage, const char* path) {
+    size_t length = strlen(path);
+    while(length > 0 && path[length - 1] == '/') {
+        length--;
+    }
+    while(length > 0 && path[length - 1] != '/') {
+        length--;
+    }
+
+    storage->dir_version[storage_dir_version_slot(path, length)] = ++storage->generation;
+}
+
+uint32_t storage_data_get_dir_version(StorageData* storage, const char* path) {
+    uint32_t version = storage->dir_version[storage_dir_version_slot(path, strlen(path))];
+    return MAX(version, storage->volume_version);
+}
+
 /****************** storage glue ******************/
 
 static StorageFile* storage_get_file(const File* file, StorageData* storage) {
@@ -10,6 +10,8 @@ extern "C" {
 
 typedef enum { ST_EXT = 0, ST_INT = 1, ST_MNT = 2, ST_ANY, ST_ERROR } StorageType;
 
+#define STORAGE_DIR_VERSION_COUNT 16
+
 typedef struct StorageData StorageData;
 
 typedef struct {
@@ -42,6 +44,9 @@ StorageStatus storage_data_status(StorageData* storage);
 const char* storage_data_status_text(StorageData* storage);
 void storage_data_timestamp(StorageData* storage);
 uint32_t storage_data_get_timestamp(StorageData* storage);
+void storage_data_volume_changed(StorageData* storage);
+void storage_data_dir_changed(StorageData* storage, const char* path);
+uint32_t storage_data_get_dir_version(StorageData* storage, const char* path);
 
 LIST_DEF(
     StorageFileList,
@@ -58,6 +63,9 @@ struct StorageData {
     StorageStatus status;
     StorageFileList_t files;
     uint32_t timestamp;
+    uint32_t generation;
+    uint32_t volume_version;
+    uint32_t dir_version[STORAGE_DIR_VERSION_COUNT];
 };
 
 bool storage_has_file(const File* file, StorageData* storage_data);
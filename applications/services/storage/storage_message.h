@@ -20,6 +20,12 @@ typedef struct {
     uint16_t bytes_to_read;
 } SADataFRead;
 
+typedef struct {
+    File* file;
+    StorageReadRequest* requests;
+    size_t count;
+} SADataFReadBatch;
+
 typedef struct {
     File* file;
     const void* buff;
@@ -50,9 +56,19 @@ typedef struct {
     uint16_t name_length;
 } SADataDRead;
 
+typedef struct {
+    File* file;
+    FileInfo* fileinfo;
+    char* names;
+    size_t names_size;
+    uint16_t name_length;
+    size_t count;
+} SADataDReadBatch;
+
 typedef struct {
     const char* path;
     uint32_t* timestamp;
+    FileInfo* fileinfo;
     FuriThreadId thread_id;
 } SADataCTimestamp;
 
@@ -62,6 +78,14 @@ typedef struct {
     FuriThreadId thread_id;
 } SADataCStat;
 
+typedef struct {
+    const char* const* paths;
+    FileInfo* fileinfo;
+    FS_Error* errors;
+    size_t count;
+    FuriThreadId thread_id;
+} SADataCStatBatch;
+
 typedef struct {
     const char* fs_path;
     uint64_t* total_space;
@@ -111,15 +135,18 @@ typedef struct {
 typedef union {
     SADataFOpen fopen;
     SADataFRead fread;
+    SADataFReadBatch freadbatch;
     SADataFWrite fwrite;
     SADataFSeek fseek;
     SADataFExpand fexpand;
 
     SADataDOpen dopen;
     SADataDRead dread;
+    SADataDReadBatch dreadbatch;
 
     SADataCTimestamp ctimestamp;
     SADataCStat cstat;
+    SADataCStatBatch cstatbatch;
     SADataCFSInfo cfsinfo;
     SADataCResolvePath cresolvepath;
     SADataCEquivPath cequivpath;
@@ -139,6 +166,7 @@ typedef union {
     bool bool_value;
     uint16_t uint16_value;
     uint64_t uint64_value;
+    size_t size_value;
     FS_Error error_value;
     const char* cstring_value;
 } SAReturn;
@@ -177,6 +205,12 @@ typedef enum {
     StorageCommandVirtualMount,
     StorageCommandVirtualUnmount,
     StorageCommandVirtualQuit,
+
+    StorageCommandFileReadBatch,
+    StorageCommandDirReadBatch,
+    StorageCommandCommonStatBatch,
+    StorageCommandCommonMtime,
+    StorageCommandCommonDirVersion,
 } StorageCommand;
 
 typedef struct {
@@ -128,6 +128,10 @@ bool storage_process_file_open(
 
             const char* path_cstr_no_vfs = cstr_path_without_vfs_prefix(path);
             FS_CALL(storage, file.open(storage, file, path_cstr_no_vfs, access_mode, open_mode));
+
+            if((access_mode & FSAM_WRITE) && open_mode != FSOM_OPEN_EXISTING) {
+                storage_data_dir_changed(storage, furi_string_get_cstr(path));
+            }
         }
     }
 
@@ -361,6 +365,18 @@ static FS_Error
     return ret;
 }
 
+static FS_Error
+    storage_process_common_dir_version(Storage* app, FuriString* path, uint32_t* version) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+
+    if(ret == FSE_OK) {
+        *version = storage_data_get_dir_version(storage, furi_string_get_cstr(path));
+    }
+
+    return ret;
+}
+
 static FS_Error storage_process_common_stat(Storage* app, FuriString* path, FileInfo* fileinfo) {
     StorageData* storage;
     FS_Error ret = storage_get_data(app, path, &storage);
@@ -372,6 +388,23 @@ static FS_Error storage_process_common_stat(Storage* app, FuriString* path, File
     return ret;
 }
 
+static FS_Error storage_process_common_mtime(
+    Storage* app,
+    FuriString* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+
+    if(ret == FSE_OK) {
+        FS_CALL(
+            storage,
+            common.mtime(storage, cstr_path_without_vfs_prefix(path), fileinfo, timestamp));
+    }
+
+    return ret;
+}
+
 static FS_Error storage_process_common_remove(Storage* app, FuriString* path) {
     StorageData* storage;
     FS_Error ret = storage_get_data(app, path, &storage);
@@ -386,6 +419,7 @@ static FS_Error storage_process_common_remove(Storage* app, FuriString* path) {
 
         storage_data_timestamp(storage);
         FS_CALL(storage, common.remove(storage, cstr_path_without_vfs_prefix(path)));
+        storage_data_dir_changed(storage, furi_string_get_cstr(path));
     } while(false);
 
     return ret;
@@ -398,6 +432,7 @@ static FS_Error storage_process_common_mkdir(Storage* app, FuriString* path) {
     if(ret == FSE_OK) {
         storage_data_timestamp(storage);
         FS_CALL(storage, common.mkdir(storage, cstr_path_without_vfs_prefix(path)));
+        storage_data_dir_changed(storage, furi_string_get_cstr(path));
     }
 
     return ret;
@@ -457,6 +492,7 @@ static FS_Error storage_process_sd_format(Storage* app) {
     } else {
         ret = sd_format_card(&app->storage[ST_EXT]);
         storage_data_timestamp(&app->storage[ST_EXT]);
+        storage_data_volume_changed(&app->storage[ST_EXT]);
     }
 
     return ret;
@@ -479,6 +515,7 @@ static FS_Error storage_process_sd_unmount(Storage* app) {
 
         sd_unmount_card(storage);
         storage_data_timestamp(storage);
+        storage_data_volume_changed(storage);
     } while(false);
 
     return ret;
@@ -583,6 +620,82 @@ void storage_process_alias(
     }
 }
 
+/******************** Batched operations *******************/
+
+static size_t storage_process_file_read_batch(Storage* app, SADataFReadBatch* batch) {
+    File* file = batch->file;
+    size_t done = 0;
+
+    for(; done < batch->count; done++) {
+        StorageReadRequest* request = &batch->requests[done];
+        if(!storage_process_file_seek(app, file, request->offset, true)) break;
+
+        while(request->bytes_read < request->size) {
+            uint16_t chunk = MIN(request->size - request->bytes_read, UINT16_MAX);
+            uint16_t read = storage_process_file_read(
+                app, file, (uint8_t*)request->buff + request->bytes_read, chunk);
+            request->bytes_read += read;
+            if(read != chunk) break;
+        }
+
+        if(request->bytes_read != request->size) break;
+    }
+
+    return done;
+}
+
+static size_t storage_process_dir_read_batch(Storage* app, SADataDReadBatch* batch) {
+    File* file = batch->file;
+    StorageData* storage = get_storage_by_file(file, app->storage);
+    size_t done = 0;
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+        return done;
+    }
+
+    size_t names_used = 0;
+    while((done < batch->count) && (batch->names_size - names_used >= batch->name_length)) {
+        FileInfo* fileinfo = batch->fileinfo ? &batch->fileinfo[done] : NULL;
+        char* name = batch->names + names_used;
+        bool ret = false;
+        FS_CALL(storage, dir.read(storage, file, fileinfo, name, batch->name_length));
+        if(!ret) break;
+
+        names_used += strlen(name) + 1;
+        done++;
+    }
+
+    // Items read so far are fine, the error will be reported by the next call
+    if(done) {
+        file->error_id = FSE_OK;
+    }
+
+    return done;
+}
+
+static size_t storage_process_common_stat_batch(Storage* app, SADataCStatBatch* batch) {
+    FuriString* path = furi_string_alloc();
+    size_t done = 0;
+
+    for(size_t i = 0; i < batch->count; i++) {
+        furi_string_set(path, batch->paths[i]);
+        storage_process_alias(app, path, batch->thread_id, false);
+
+        FileInfo* fileinfo = batch->fileinfo ? &batch->fileinfo[i] : NULL;
+        FS_Error error = storage_process_common_stat(app, path, fileinfo);
+        if(batch->errors) {
+            batch->errors[i] = error;
+        }
+        if(error == FSE_OK) {
+            done++;
+        }
+    }
+
+    furi_string_free(path);
+    return done;
+}
+
 /****************** API calls processing ******************/
 
 void storage_process_message_internal(Storage* app, StorageMessage* message) {
@@ -686,6 +799,23 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         message->return_data->error_value =
             storage_process_common_stat(app, path, message->data->cstat.fileinfo);
         break;
+    case StorageCommandCommonMtime:
+        path = furi_string_alloc_set(message->data->ctimestamp.path);
+        storage_process_alias(app, path, message->data->ctimestamp.thread_id, false);
+        message->return_data->error_value =
+            storage_process_common_mtime(
+                app,
+                path,
+                message->data->ctimestamp.fileinfo,
+                message->data->ctimestamp.timestamp);
+        break;
+    case StorageCommandCommonDirVersion:
+        path = furi_string_alloc_set(message->data->ctimestamp.path);
+        storage_process_alias(app, path, message->data->ctimestamp.thread_id, false);
+        storage_path_trim_trailing_slashes(path);
+        message->return_data->error_value =
+            storage_process_common_dir_version(app, path, message->data->ctimestamp.timestamp);
+        break;
     case StorageCommandCommonRemove:
         path = furi_string_alloc_set(message->data->path.path);
         storage_process_alias(app, path, message->data->path.thread_id, false);
@@ -764,6 +894,20 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
     case StorageCommandVirtualQuit:
         message->return_data->error_value = storage_process_virtual_quit(&app->storage[ST_MNT]);
         break;
+
+    // Batched operations
+    case StorageCommandFileReadBatch:
+        message->return_data->size_value =
+            storage_process_file_read_batch(app, &message->data->freadbatch);
+        break;
+    case StorageCommandDirReadBatch:
+        message->return_data->size_value =
+            storage_process_dir_read_batch(app, &message->data->dreadbatch);
+        break;
+    case StorageCommandCommonStatBatch:
+        message->return_data->size_value =
+            storage_process_common_stat_batch(app, &message->data->cstatbatch);
+        break;
     }
 
     if(path != NULL) { //-V547
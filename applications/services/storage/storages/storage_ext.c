@@ -90,6 +90,7 @@ static bool sd_mount_card_internal(StorageData* storage, bool notify) {
     }
 
     storage_data_timestamp(storage);
+    storage_data_volume_changed(storage);
 
     return result;
 }
@@ -568,6 +569,40 @@ static FS_Error storage_ext_common_stat(void* ctx, const char* path, FileInfo* f
     return storage_ext_parse_error(result);
 }
 
+static FS_Error storage_ext_common_mtime(
+    void* ctx,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp) {
+    StorageData* storage = ctx;
+    SDFileInfo _fileinfo;
+    char* drive_path = storage_ext_drive_path(storage, path);
+    SDError result = f_stat(drive_path, &_fileinfo);
+    free(drive_path);
+
+    if(result == FR_OK) {
+        if(fileinfo != NULL) {
+            fileinfo->size = _fileinfo.fsize;
+            fileinfo->flags = 0;
+
+            if(_fileinfo.fattrib & AM_DIR) fileinfo->flags |= FSF_DIRECTORY;
+        }
+
+        // FAT date and time, local time with 2 second resolution
+        DateTime datetime = {
+            .year = (_fileinfo.fdate >> 9) + 1980,
+            .month = (_fileinfo.fdate >> 5) & 0x0F,
+            .day = _fileinfo.fdate & 0x1F,
+            .hour = _fileinfo.ftime >> 11,
+            .minute = (_fileinfo.ftime >> 5) & 0x3F,
+            .second = (_fileinfo.ftime & 0x1F) * 2,
+        };
+        *timestamp = datetime_datetime_to_timestamp(&datetime);
+    }
+
+    return storage_ext_parse_error(result);
+}
+
 static FS_Error storage_ext_common_remove(void* ctx, const char* path) {
     StorageData* storage = ctx;
 #ifdef FURI_RAM_EXEC
@@ -673,6 +708,7 @@ static const FS_Api fs_api = {
     .common =
         {
             .stat = storage_ext_common_stat,
+            .mtime = storage_ext_common_mtime,
             .mkdir = storage_ext_common_mkdir,
             .remove = storage_ext_common_remove,
             .fs_info = storage_ext_common_fs_info,
@@ -657,6 +657,19 @@ static FS_Error storage_int_common_stat(void* ctx, const char* path, FileInfo* f
     return storage_int_parse_error(result);
 }
 
+static FS_Error storage_int_common_mtime(
+    void* ctx,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp) {
+    UNUSED(ctx);
+    UNUSED(path);
+    UNUSED(fileinfo);
+    UNUSED(timestamp);
+    // LittleFS does not keep modification time
+    return FSE_NOT_IMPLEMENTED;
+}
+
 static FS_Error storage_int_common_remove(void* ctx, const char* path) {
     StorageData* storage = ctx;
     lfs_t* lfs = lfs_get_from_storage(storage);
@@ -724,6 +737,7 @@ static const FS_Api fs_api = {
     .common =
         {
             .stat = storage_int_common_stat,
+            .mtime = storage_int_common_mtime,
             .mkdir = storage_int_common_mkdir,
             .remove = storage_int_common_remove,
             .fs_info = storage_int_common_fs_info,
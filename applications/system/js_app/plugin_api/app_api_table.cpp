@@ -10,16 +10,23 @@
 
 static_assert(!has_hash_collisions(app_api_table), "Detected API method hash collision!");
 
-constexpr HashtableApiInterface applicaton_hashtable_api_interface{
+static constexpr auto app_api_perfect_table = perfect_hash_table(app_api_table);
+static_assert(
+    is_perfect_hash_valid(app_api_perfect_table, app_api_table),
+    "Failed to build API perfect hash table!");
+
+constexpr PerfectHashApiInterface applicaton_hashtable_api_interface{
     {
         .api_version_major = 0,
         .api_version_minor = 0,
-        /* generic resolver using pre-sorted array */
-        .resolver_callback = &elf_resolve_from_hashtable,
+        /* generic resolver using perfect hash table */
+        .resolver_callback = &elf_resolve_from_perfect_hashtable,
     },
-    /* pointers to application's API table boundaries */
-    app_api_table.cbegin(),
-    app_api_table.cend(),
+    /* application's API perfect hash table */
+    app_api_perfect_table.slots.data(),
+    app_api_perfect_table.displacements.data(),
+    app_api_perfect_table.slots.size(),
+    app_api_perfect_table.displacements.size(),
 };
 
 /* Casting to generic resolver to use in Composite API resolver */
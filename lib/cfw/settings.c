@@ -35,6 +35,8 @@ void CFW_SETTINGS_LOAD(void) {
     CfwSettings* x = &cfw_settings;
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* file = flipper_format_file_alloc(storage);
+    // Every setting is read after rewind
+    flipper_format_set_key_index(file, true);
     FuriString* manifest_name = furi_string_alloc();
 
     if(flipper_format_file_open_existing(file, CFW_SETTINGS_PATH)) {
@@ -72,6 +72,14 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 #define ATA_GET_MODEL		21	/* Get model name */
 #define ATA_GET_SN			22	/* Get serial number */
 
+/* Sector cache ioctl command */
+#define CTRL_HINT			64	/* Kind of the next single sector transfer (BYTE: HINT_*), drivers may ignore it */
+
+/* Sector kinds for CTRL_HINT */
+#define HINT_DATA			0	/* File data */
+#define HINT_META			1	/* Directory, boot record, allocation bitmap */
+#define HINT_FAT			2	/* FAT */
+
 #ifdef __cplusplus
 }
 #endif
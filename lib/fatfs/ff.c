@@ -875,6 +875,24 @@ void clear_lock (	/* Clear lock entries of the volume */
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Tell the driver what the next window transfer is, for sector caching  */
+/*-----------------------------------------------------------------------*/
+
+static
+void hint_window (
+	FATFS* fs,			/* File system object */
+	DWORD sector		/* Sector number of the window transfer */
+)
+{
+	BYTE hint = (sector - fs->fatbase < fs->fsize) ? HINT_FAT : HINT_META;
+
+
+	disk_ioctl(fs->drv, CTRL_HINT, &hint);
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Move/Flush disk access window in the file system object               */
 /*-----------------------------------------------------------------------*/
@@ -891,6 +909,7 @@ FRESULT sync_window (	/* Returns FR_OK or FR_DISK_ERROR */
 
 	if (fs->wflag) {	/* Write back the sector if it is dirty */
 		wsect = fs->winsect;	/* Current sector number */
+		hint_window(fs, wsect);
 		if (disk_write(fs->drv, fs->win, wsect, 1) != RES_OK) {
 			res = FR_DISK_ERR;
 		} else {
@@ -898,6 +917,7 @@ FRESULT sync_window (	/* Returns FR_OK or FR_DISK_ERROR */
 			if (wsect - fs->fatbase < fs->fsize) {		/* Is it in the FAT area? */
 				for (nf = fs->n_fats; nf >= 2; nf--) {	/* Reflect the change to all FAT copies */
 					wsect += fs->fsize;
+					hint_window(fs, fs->winsect);	/* Copies are FAT too */
 					disk_write(fs->drv, fs->win, wsect, 1);
 				}
 			}
@@ -922,6 +942,7 @@ FRESULT move_window (	/* Returns FR_OK or FR_DISK_ERROR */
 		res = sync_window(fs);		/* Write-back changes */
 #endif
 		if (res == FR_OK) {			/* Fill sector window with new data */
+			hint_window(fs, sector);
 			if (disk_read(fs->drv, fs->win, sector, 1) != RES_OK) {
 				sector = 0xFFFFFFFF;	/* Invalidate window if data is not reliable */
 				res = FR_DISK_ERR;
@@ -36,6 +36,36 @@ bool elf_resolve_from_hashtable(
     return result;
 }
 
+bool elf_resolve_from_perfect_hashtable(
+    const ElfApiInterface* interface,
+    uint32_t hash,
+    Elf32_Addr* address) {
+    furi_check(interface);
+    furi_check(address);
+
+    const PerfectHashApiInterface* hashtable_interface =
+        static_cast<const PerfectHashApiInterface*>(interface);
+
+    if(!hashtable_interface->slot_count) {
+        return false;
+    }
+
+    uint16_t displacement = hashtable_interface->displacements[perfect_hash_bucket(
+        hash, hashtable_interface->bucket_count)];
+    const sym_entry* entry = &hashtable_interface->slots[perfect_hash_slot(
+        hash, displacement, hashtable_interface->slot_count)];
+
+    // Every key of the table has its own slot, other hashes land on a random one
+    if(entry->hash != hash) {
+        FURI_LOG_T(
+            TAG, "Can't find symbol with hash %lx @ %p!", hash, hashtable_interface->slots);
+        return false;
+    }
+
+    *address = entry->address;
+    return true;
+}
+
 uint32_t elf_symbolname_hash(const char* s) {
     furi_check(s);
     return elf_gnu_hash(s);
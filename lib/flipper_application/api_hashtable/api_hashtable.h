@@ -28,6 +28,18 @@ bool elf_resolve_from_hashtable(
     uint32_t hash,
     Elf32_Addr* address);
 
+/**
+ * @brief Resolver for API entries using a minimal perfect hash table
+ * @param interface pointer to PerfectHashApiInterface
+ * @param hash gnu hash of function name
+ * @param address output for function address
+ * @return true if the table contains a function
+ */
+bool elf_resolve_from_perfect_hashtable(
+    const ElfApiInterface* interface,
+    uint32_t hash,
+    Elf32_Addr* address);
+
 uint32_t elf_symbolname_hash(const char* s);
 
 #ifdef __cplusplus
@@ -45,6 +57,50 @@ struct HashtableApiInterface : public ElfApiInterface {
     const sym_entry *table_cbegin, *table_cend;
 };
 
+/**
+ * @brief  PerfectHashApiInterface is an implementation of ElfApiInterface
+ * that uses a minimal perfect hash table to resolve function addresses.
+ * slots and displacements must point to a table built with perfect_hash_table
+ */
+struct PerfectHashApiInterface : public ElfApiInterface {
+    const sym_entry* slots;
+    const uint16_t* displacements;
+    uint16_t slot_count;
+    uint16_t bucket_count;
+};
+
+/** Displacement flag, bucket has a single key and the rest of value is its slot */
+#define PERFECT_HASH_DIRECT_SLOT (0x8000U)
+
+/** Average number of keys in perfect hash bucket */
+#define PERFECT_HASH_BUCKET_LOAD (3U)
+
+constexpr uint32_t perfect_hash_mix(uint32_t h) {
+    // MurmurHash3 finalizer, GNU hash has weak low bits
+    h ^= h >> 16;
+    h *= 0x85EBCA6BU;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35U;
+    h ^= h >> 16;
+    return h;
+}
+
+constexpr std::size_t perfect_hash_bucket_count(std::size_t slot_count) {
+    return (slot_count + PERFECT_HASH_BUCKET_LOAD - 1) / PERFECT_HASH_BUCKET_LOAD;
+}
+
+constexpr std::size_t perfect_hash_bucket(uint32_t hash, std::size_t bucket_count) {
+    return perfect_hash_mix(hash) % bucket_count;
+}
+
+constexpr std::size_t
+    perfect_hash_slot(uint32_t hash, uint16_t displacement, std::size_t slot_count) {
+    if(displacement & PERFECT_HASH_DIRECT_SLOT) {
+        return displacement & ~PERFECT_HASH_DIRECT_SLOT;
+    }
+    return perfect_hash_mix(hash ^ (displacement * 0x9E3779B9U)) % slot_count;
+}
+
 #define API_METHOD(x, ret_type, args_type)                                                     \
     sym_entry {                                                                                \
         .hash = elf_gnu_hash(#x), .address = (uint32_t)(static_cast<ret_type(*) args_type>(x)) \
@@ -6,8 +6,11 @@
 
 #ifdef __cplusplus
 
+#include "api_hashtable.h"
+
 #include <iterator>
 #include <array>
+#include <algorithm>
 
 namespace cstd {
 
@@ -112,4 +115,102 @@ constexpr auto create_array_t(const Ts&&... values) {
     return std::array<array_type, sizeof...(Ts)>{static_cast<T>(values)...};
 }
 
+/**
+ * Compile-time minimal perfect hash of symbol table entries.
+ *
+ * Keys are split into buckets by hash. Buckets are placed from the largest one,
+ * each gets the first displacement that maps all of its keys to free slots.
+ * Single key buckets take remaining slots directly. Lookup of any hash costs
+ * one displacement read and one comparison.
+ */
+template <std::size_t N>
+struct PerfectHashTable {
+    static_assert(N < PERFECT_HASH_DIRECT_SLOT, "Too many entries for perfect hash");
+
+    std::array<sym_entry, N> slots;
+    std::array<uint16_t, perfect_hash_bucket_count(N)> displacements;
+};
+
+template <std::size_t N>
+constexpr auto perfect_hash_table(const std::array<sym_entry, N>& entries) {
+    constexpr std::size_t bucket_count = perfect_hash_bucket_count(N);
+    PerfectHashTable<N> table{};
+
+    // Entries grouped by bucket
+    std::array<uint16_t, bucket_count + 1> bucket_start{};
+    std::array<uint16_t, N> bucket_entries{};
+    for(std::size_t i = 0; i < N; i++) {
+        bucket_start[perfect_hash_bucket(entries[i].hash, bucket_count) + 1]++;
+    }
+    std::size_t max_bucket_size = 0;
+    for(std::size_t b = 0; b < bucket_count; b++) {
+        max_bucket_size = std::max<std::size_t>(max_bucket_size, bucket_start[b + 1]);
+        bucket_start[b + 1] += bucket_start[b];
+    }
+    std::array<uint16_t, bucket_count> bucket_fill{};
+    for(std::size_t i = 0; i < N; i++) {
+        std::size_t b = perfect_hash_bucket(entries[i].hash, bucket_count);
+        bucket_entries[bucket_start[b] + bucket_fill[b]++] = i;
+    }
+
+    std::array<bool, N> taken{};
+    std::size_t free_slot = 0;
+    for(std::size_t size = max_bucket_size; size > 0; size--) {
+        for(std::size_t b = 0; b < bucket_count; b++) {
+            if(bucket_fill[b] != size) continue;
+            const uint16_t* keys = &bucket_entries[bucket_start[b]];
+
+            if(size == 1) {
+                while(taken[free_slot]) free_slot++;
+                table.displacements[b] = PERFECT_HASH_DIRECT_SLOT | free_slot;
+                taken[free_slot] = true;
+                table.slots[free_slot] = entries[keys[0]];
+                continue;
+            }
+
+            for(uint16_t d = 1; d < PERFECT_HASH_DIRECT_SLOT; d++) {
+                bool fits = true;
+                for(std::size_t k = 0; k < size && fits; k++) {
+                    std::size_t slot = perfect_hash_slot(entries[keys[k]].hash, d, N);
+                    fits = !taken[slot];
+                    for(std::size_t j = 0; j < k && fits; j++) {
+                        fits = perfect_hash_slot(entries[keys[j]].hash, d, N) != slot;
+                    }
+                }
+                if(!fits) continue;
+
+                table.displacements[b] = d;
+                for(std::size_t k = 0; k < size; k++) {
+                    std::size_t slot = perfect_hash_slot(entries[keys[k]].hash, d, N);
+                    taken[slot] = true;
+                    table.slots[slot] = entries[keys[k]];
+                }
+                break;
+            }
+        }
+    }
+
+    return table;
+}
+
+/* Compile-time check that every entry is found in perfect hash table.
+ * Usage: static_assert(is_perfect_hash_valid(table, api_methods), "Invalid perfect hash");
+ */
+template <std::size_t N>
+constexpr bool is_perfect_hash_valid(
+    const PerfectHashTable<N>& table,
+    const std::array<sym_entry, N>& entries) {
+    for(std::size_t i = 0; i < N; i++) {
+        uint32_t hash = entries[i].hash;
+        uint16_t displacement =
+            table.displacements[perfect_hash_bucket(hash, table.displacements.size())];
+        const sym_entry& entry = table.slots[perfect_hash_slot(hash, displacement, N)];
+        if(entry.hash != hash) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 #endif
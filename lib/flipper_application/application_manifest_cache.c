@@ -0,0 +1,204 @@
+#include "application_manifest_cache.h"
+
+#include <furi.h>
+#include <string.h>
+
+#define TAG "FapManifestCache"
+
+#define MANIFEST_CACHE_PATH CFG_PATH("fap_manifest.cache")
+#define MANIFEST_CACHE_MAGIC 0x4D434146 // "FACM"
+#define MANIFEST_CACHE_VERSION 1
+#define MANIFEST_CACHE_SLOTS 512
+#define MANIFEST_CACHE_PROBE 4
+// Probe never wraps around, table has MANIFEST_CACHE_PROBE - 1 extra entries at the end
+#define MANIFEST_CACHE_ENTRIES (MANIFEST_CACHE_SLOTS + MANIFEST_CACHE_PROBE - 1)
+#define MANIFEST_CACHE_FILL_BLOCK 512
+
+/*
+ * Persistent cache of FAP manifests
+ *
+ * Open addressing hash table on SD card, entry home slot is picked by path
+ * hash and MANIFEST_CACHE_PROBE consecutive slots are probed. Entry is valid
+ * while size and modification time of FAP file match the recorded ones.
+ * Lookup costs one read instead of parsing ELF sections of FAP file.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t slots;
+} FURI_PACKED ManifestCacheHeader;
+
+typedef struct {
+    uint64_t path_hash; ///< 0 for empty slot
+    uint32_t file_size;
+    uint32_t file_mtime;
+    uint8_t has_icon;
+    char name[FAP_MANIFEST_MAX_APP_NAME_LENGTH];
+    char icon[FAP_MANIFEST_MAX_ICON_SIZE];
+} FURI_PACKED ManifestCacheEntry;
+
+static uint64_t manifest_cache_hash(const char* path) {
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    while(*path) {
+        hash ^= (uint8_t)*path++;
+        hash *= 0x100000001B3ULL;
+    }
+    // Zero marks empty slot
+    return hash ? hash : 1;
+}
+
+static size_t manifest_cache_entry_offset(const FlipperApplicationManifestCacheKey* key) {
+    size_t slot = key->path_hash % MANIFEST_CACHE_SLOTS;
+    return sizeof(ManifestCacheHeader) + slot * sizeof(ManifestCacheEntry);
+}
+
+static bool manifest_cache_header_valid(File* file) {
+    ManifestCacheHeader header;
+    return storage_file_read(file, &header, sizeof(header)) == sizeof(header) &&
+           header.magic == MANIFEST_CACHE_MAGIC && header.version == MANIFEST_CACHE_VERSION &&
+           header.slots == MANIFEST_CACHE_SLOTS;
+}
+
+static bool manifest_cache_create(File* file) {
+    const ManifestCacheHeader header = {
+        .magic = MANIFEST_CACHE_MAGIC,
+        .version = MANIFEST_CACHE_VERSION,
+        .slots = MANIFEST_CACHE_SLOTS,
+    };
+
+    if(!storage_file_seek(file, 0, true) || !storage_file_truncate(file)) return false;
+    if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) return false;
+
+    uint8_t* zero = malloc(MANIFEST_CACHE_FILL_BLOCK);
+    size_t left = MANIFEST_CACHE_ENTRIES * sizeof(ManifestCacheEntry);
+    bool success = true;
+    while(left && success) {
+        size_t chunk = MIN(left, (size_t)MANIFEST_CACHE_FILL_BLOCK);
+        success = (storage_file_write(file, zero, chunk) == chunk);
+        left -= chunk;
+    }
+    free(zero);
+
+    if(success) FURI_LOG_I(TAG, "Created");
+    return success;
+}
+
+static bool manifest_cache_read_probe(
+    File* file,
+    const FlipperApplicationManifestCacheKey* key,
+    ManifestCacheEntry* entries) {
+    const size_t size = MANIFEST_CACHE_PROBE * sizeof(ManifestCacheEntry);
+    return storage_file_seek(file, manifest_cache_entry_offset(key), true) &&
+           storage_file_read(file, entries, size) == size;
+}
+
+bool flipper_application_manifest_cache_key(
+    Storage* storage,
+    const char* path,
+    FlipperApplicationManifestCacheKey* key) {
+    furi_check(storage);
+    furi_check(path);
+    furi_check(key);
+
+    FileInfo file_info;
+    if(storage_common_stat_mtime(storage, path, &file_info, &key->file_mtime) != FSE_OK)
+        return false;
+    if(file_info_is_dir(&file_info) || file_info.size > UINT32_MAX) return false;
+
+    key->path_hash = manifest_cache_hash(path);
+    key->file_size = file_info.size;
+    return true;
+}
+
+bool flipper_application_manifest_cache_get(
+    Storage* storage,
+    const FlipperApplicationManifestCacheKey* key,
+    FlipperApplicationManifest* manifest) {
+    furi_check(storage);
+    furi_check(key);
+    furi_check(manifest);
+
+    File* file = storage_file_alloc(storage);
+    ManifestCacheEntry* entries = malloc(MANIFEST_CACHE_PROBE * sizeof(ManifestCacheEntry));
+    bool found = false;
+
+    do {
+        if(!storage_file_open(file, MANIFEST_CACHE_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(!manifest_cache_header_valid(file)) break;
+        if(!manifest_cache_read_probe(file, key, entries)) break;
+
+        for(size_t i = 0; i < MANIFEST_CACHE_PROBE; i++) {
+            const ManifestCacheEntry* entry = &entries[i];
+            if(entry->path_hash != key->path_hash) continue;
+
+            // Older version of the file is replaced on put
+            if(entry->file_size == key->file_size && entry->file_mtime == key->file_mtime) {
+                memcpy(manifest->name, entry->name, sizeof(manifest->name));
+                manifest->has_icon = entry->has_icon;
+                memcpy(manifest->icon, entry->icon, sizeof(manifest->icon));
+                found = true;
+            }
+            break;
+        }
+    } while(false);
+
+    free(entries);
+    storage_file_free(file);
+
+    return found;
+}
+
+void flipper_application_manifest_cache_put(
+    Storage* storage,
+    const FlipperApplicationManifestCacheKey* key,
+    const FlipperApplicationManifest* manifest) {
+    furi_check(storage);
+    furi_check(key);
+    furi_check(manifest);
+
+    File* file = storage_file_alloc(storage);
+    ManifestCacheEntry* entries = malloc(MANIFEST_CACHE_PROBE * sizeof(ManifestCacheEntry));
+
+    do {
+        // Waits while cache is used by another thread
+        if(!storage_file_open(file, MANIFEST_CACHE_PATH, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS)) {
+            break;
+        }
+        if(!manifest_cache_header_valid(file) && !manifest_cache_create(file)) {
+            FURI_LOG_E(TAG, "Unable to create");
+            break;
+        }
+        if(!manifest_cache_read_probe(file, key, entries)) break;
+
+        // Slot of the same path, first empty one, or home slot if all are taken
+        size_t slot = 0;
+        for(size_t i = 0; i < MANIFEST_CACHE_PROBE; i++) {
+            if(entries[i].path_hash == key->path_hash) {
+                slot = i;
+                break;
+            }
+            if(entries[i].path_hash == 0 && entries[slot].path_hash != 0) {
+                slot = i;
+            }
+        }
+
+        ManifestCacheEntry* entry = &entries[slot];
+        entry->path_hash = key->path_hash;
+        entry->file_size = key->file_size;
+        entry->file_mtime = key->file_mtime;
+        entry->has_icon = manifest->has_icon;
+        memcpy(entry->name, manifest->name, sizeof(entry->name));
+        memcpy(entry->icon, manifest->icon, sizeof(entry->icon));
+
+        size_t offset = manifest_cache_entry_offset(key) + slot * sizeof(ManifestCacheEntry);
+        if(!storage_file_seek(file, offset, true) ||
+           storage_file_write(file, entry, sizeof(ManifestCacheEntry)) !=
+               sizeof(ManifestCacheEntry)) {
+            FURI_LOG_E(TAG, "Unable to write entry");
+        }
+    } while(false);
+
+    free(entries);
+    storage_file_free(file);
+}
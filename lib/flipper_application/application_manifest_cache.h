@@ -0,0 +1,55 @@
+#pragma once
+
+#include "application_manifest.h"
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Identity of a FAP file version in manifest cache */
+typedef struct {
+    uint64_t path_hash;
+    uint32_t file_size;
+    uint32_t file_mtime;
+} FlipperApplicationManifestCacheKey;
+
+/**
+ * @brief Get cache key of a FAP file
+ * @param storage Storage instance
+ * @param path Path to FAP file
+ * @param key Key to fill
+ * @return false if file can not be cached, e.g. its storage has no modification time
+ */
+bool flipper_application_manifest_cache_key(
+    Storage* storage,
+    const char* path,
+    FlipperApplicationManifestCacheKey* key);
+
+/**
+ * @brief Get manifest from cache
+ * Only name, has_icon and icon are stored, other fields are left untouched
+ * @param storage Storage instance
+ * @param key Cache key of FAP file
+ * @param manifest Manifest to fill
+ * @return true if cache has an entry for this version of FAP file
+ */
+bool flipper_application_manifest_cache_get(
+    Storage* storage,
+    const FlipperApplicationManifestCacheKey* key,
+    FlipperApplicationManifest* manifest);
+
+/**
+ * @brief Store manifest in cache, replacing entry of older version of FAP file
+ * @param storage Storage instance
+ * @param key Cache key of FAP file
+ * @param manifest Manifest to store
+ */
+void flipper_application_manifest_cache_put(
+    Storage* storage,
+    const FlipperApplicationManifestCacheKey* key,
+    const FlipperApplicationManifest* manifest);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,6 +2,7 @@
 #include "elf/elf_file.h"
 #include <notification/notification_messages.h>
 #include "application_assets.h"
+#include "application_manifest_cache.h"
 #include <loader/firmware_api/firmware_api.h>
 #include <storage/storage_processing.h>
 
@@ -15,6 +16,7 @@ struct FlipperApplication {
     ELFFile* elf;
     FuriThread* thread;
     void* ep_thread_args;
+    uint32_t preload_ticks; ///< Time spent in full preload, for load time log
 };
 
 /********************** Debugger access to loader state **********************/
@@ -161,6 +163,8 @@ static FlipperApplicationPreloadStatus
 
     // if we are loading full file
     if(load_full) {
+        app->preload_ticks = furi_get_tick();
+
         // load section table
         if(!elf_file_load_section_table(app->elf)) {
             return FlipperApplicationPreloadStatusInvalidFile;
@@ -184,6 +188,10 @@ static FlipperApplicationPreloadStatus
         return FlipperApplicationPreloadStatusInvalidFile;
     }
 
+    if(load_full) {
+        app->preload_ticks = furi_get_tick() - app->preload_ticks;
+    }
+
     return flipper_application_validate_manifest(app);
 }
 
@@ -213,7 +221,13 @@ const FlipperApplicationManifest* flipper_application_get_manifest(FlipperApplic
 FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplication* app) {
     furi_check(app);
 
+    uint32_t start_tick = furi_get_tick();
     ELFFileLoadStatus status = elf_file_load_sections(app->elf);
+    FURI_LOG_I(
+        TAG,
+        "Load time: preload %lums, relocation %lums",
+        app->preload_ticks,
+        furi_get_tick() - start_tick);
 
     switch(status) {
     case ELFFileLoadStatusSuccess:
@@ -334,6 +348,16 @@ const FlipperAppPluginDescriptor*
     return lib_descriptor;
 }
 
+static void flipper_application_manifest_get_name_and_icon(
+    const FlipperApplicationManifest* manifest,
+    uint8_t** icon_ptr,
+    FuriString* item_name) {
+    if(manifest->has_icon) {
+        memcpy(*icon_ptr, manifest->icon, FAP_MANIFEST_MAX_ICON_SIZE);
+    }
+    furi_string_set(item_name, manifest->name);
+}
+
 bool flipper_application_load_name_and_icon(
     FuriString* path,
     Storage* storage,
@@ -344,17 +368,29 @@ bool flipper_application_load_name_and_icon(
     furi_check(icon_ptr);
     furi_check(item_name);
 
-    bool load_success = true;
+    bool load_success = false;
+    bool can_load = true;
 
     StorageData* storage_data;
     if(storage_get_data(storage, path, &storage_data) == FSE_OK &&
        storage_path_already_open(path, storage_data)) {
-        load_success = false;
+        can_load = false;
     }
 
-    if(load_success) {
-        load_success = false;
+    FlipperApplicationManifestCacheKey cache_key;
+    bool cache_key_valid = can_load && flipper_application_manifest_cache_key(
+                                           storage, furi_string_get_cstr(path), &cache_key);
+
+    if(cache_key_valid) {
+        FlipperApplicationManifest* manifest = malloc(sizeof(FlipperApplicationManifest));
+        if(flipper_application_manifest_cache_get(storage, &cache_key, manifest)) {
+            flipper_application_manifest_get_name_and_icon(manifest, icon_ptr, item_name);
+            load_success = true;
+        }
+        free(manifest);
+    }
 
+    if(can_load && !load_success) {
         FlipperApplication* app = flipper_application_alloc(storage, firmware_api_interface);
 
         FlipperApplicationPreloadStatus preload_res =
@@ -364,14 +400,13 @@ bool flipper_application_load_name_and_icon(
            preload_res == FlipperApplicationPreloadStatusApiTooOld ||
            preload_res == FlipperApplicationPreloadStatusApiTooNew) {
             const FlipperApplicationManifest* manifest = flipper_application_get_manifest(app);
-            if(manifest->has_icon) {
-                memcpy(*icon_ptr, manifest->icon, FAP_MANIFEST_MAX_ICON_SIZE);
+            flipper_application_manifest_get_name_and_icon(manifest, icon_ptr, item_name);
+            if(cache_key_valid) {
+                flipper_application_manifest_cache_put(storage, &cache_key, manifest);
             }
-            furi_string_set(item_name, manifest->name);
             load_success = true;
         } else {
             FURI_LOG_E(TAG, "Failed to preload %s", furi_string_get_cstr(path));
-            load_success = false;
         }
 
         flipper_application_free(app);
@@ -208,6 +208,18 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/** Enable key index.
+ *
+ * The index of key lines is built on the first read and lets reads skip lines
+ * with other keys, which makes rewind-and-read access patterns cheap on big
+ * files. It is dropped by every write through FlipperFormat and rebuilt when
+ * the stream size changes. Files too big for the index are read as usual.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      enabled         True to enable the index. False by default.
+ */
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool enabled);
+
 /** Rewind the RW pointer.
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
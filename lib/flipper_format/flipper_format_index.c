@@ -0,0 +1,175 @@
+#include <furi.h>
+#include "flipper_format_index.h"
+#include "flipper_format_stream_i.h"
+
+#define TAG "FlipperFormatIndex"
+
+#define FLIPPER_FORMAT_INDEX_CAPACITY_MIN (32U)
+#define FLIPPER_FORMAT_INDEX_MAX_SIZE (32U * 1024U)
+#define FLIPPER_FORMAT_INDEX_LINE_SIZE_UNKNOWN (UINT16_MAX)
+
+typedef struct {
+    uint32_t line_start;
+    uint16_t line_size; ///< Offset of the line end, UNKNOWN for too long lines
+    uint16_t key_hash;
+} FlipperFormatIndexEntry;
+
+typedef enum {
+    FlipperFormatIndexStateEmpty,
+    FlipperFormatIndexStateReady,
+    FlipperFormatIndexStateDisabled, ///< Stream is too big to be indexed
+} FlipperFormatIndexState;
+
+struct FlipperFormatIndex {
+    FlipperFormatIndexEntry* entries;
+    size_t count;
+    size_t capacity;
+    size_t stream_size; ///< Stream size at build time, changes invalidate the index
+    FlipperFormatIndexState state;
+};
+
+FlipperFormatIndex* flipper_format_index_alloc(void) {
+    FlipperFormatIndex* index = malloc(sizeof(FlipperFormatIndex));
+    index->entries = NULL;
+    index->count = 0;
+    index->capacity = 0;
+    index->stream_size = 0;
+    index->state = FlipperFormatIndexStateEmpty;
+    return index;
+}
+
+void flipper_format_index_free(FlipperFormatIndex* index) {
+    furi_check(index);
+    free(index->entries);
+    free(index);
+}
+
+void flipper_format_index_reset(FlipperFormatIndex* index) {
+    furi_check(index);
+    free(index->entries);
+    index->entries = NULL;
+    index->count = 0;
+    index->capacity = 0;
+    index->state = FlipperFormatIndexStateEmpty;
+}
+
+static bool flipper_format_index_add(
+    void* context,
+    uint16_t key_hash,
+    size_t line_start,
+    size_t line_end) {
+    FlipperFormatIndex* index = context;
+
+    if(line_start > UINT32_MAX) return false;
+
+    if(index->count == index->capacity) {
+        const size_t capacity = MAX(index->capacity * 2, FLIPPER_FORMAT_INDEX_CAPACITY_MIN);
+        const size_t size = capacity * sizeof(FlipperFormatIndexEntry);
+        // Index is an optimization, never take memory needed by the rest of the system
+        if(size > FLIPPER_FORMAT_INDEX_MAX_SIZE || size > memmgr_heap_get_max_free_block() / 2) {
+            return false;
+        }
+        index->entries = realloc(index->entries, size); //-V701
+        index->capacity = capacity;
+    }
+
+    const size_t line_size = line_end - line_start;
+    FlipperFormatIndexEntry* entry = &index->entries[index->count++];
+    entry->line_start = line_start;
+    entry->line_size = MIN(line_size, (size_t)FLIPPER_FORMAT_INDEX_LINE_SIZE_UNKNOWN);
+    entry->key_hash = key_hash;
+
+    return true;
+}
+
+static bool flipper_format_index_build(FlipperFormatIndex* index, Stream* stream) {
+    const size_t position = stream_tell(stream);
+    bool success = false;
+
+    do {
+        if(!stream_rewind(stream)) break;
+        if(!flipper_format_stream_scan_keys(stream, flipper_format_index_add, index)) break;
+        success = true;
+    } while(false);
+
+    if(success) {
+        index->stream_size = stream_size(stream);
+        index->state = FlipperFormatIndexStateReady;
+        FURI_LOG_D(TAG, "Indexed %zu keys", index->count);
+    } else {
+        flipper_format_index_reset(index);
+        index->state = FlipperFormatIndexStateDisabled;
+        FURI_LOG_D(TAG, "Stream is not indexed");
+    }
+
+    return stream_seek(stream, position, StreamOffsetFromStart) && success;
+}
+
+// First entry with line start at or after position
+static size_t flipper_format_index_lower_bound(FlipperFormatIndex* index, size_t position) {
+    size_t low = 0;
+    size_t high = index->count;
+    while(low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if(index->entries[middle].line_start < position) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static bool flipper_format_index_is_line_boundary(
+    FlipperFormatIndex* index,
+    size_t entry_id,
+    size_t position) {
+    if(position == 0) return true;
+    if(entry_id < index->count && index->entries[entry_id].line_start == position) return true;
+    if(entry_id > 0) {
+        const FlipperFormatIndexEntry* previous = &index->entries[entry_id - 1];
+        if(previous->line_size != FLIPPER_FORMAT_INDEX_LINE_SIZE_UNKNOWN &&
+           previous->line_start + previous->line_size == position) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void flipper_format_index_seek(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    const char* key,
+    bool strict_mode) {
+    furi_check(index);
+
+    if(index->state == FlipperFormatIndexStateReady && stream_size(stream) != index->stream_size) {
+        flipper_format_index_reset(index);
+    }
+    if(index->state == FlipperFormatIndexStateEmpty) {
+        if(!flipper_format_index_build(index, stream)) return;
+    }
+    if(index->state != FlipperFormatIndexStateReady) return;
+
+    // Keys can only be skipped safely if scan would start at the beginning of a line
+    const size_t position = stream_tell(stream);
+    size_t entry_id = flipper_format_index_lower_bound(index, position);
+    if(!flipper_format_index_is_line_boundary(index, entry_id, position)) return;
+
+    // In strict mode the next key must match, the stream parser will check it
+    if(!strict_mode) {
+        const uint16_t key_hash = flipper_format_stream_key_hash(key);
+        while(entry_id < index->count && index->entries[entry_id].key_hash != key_hash) {
+            entry_id++;
+        }
+    }
+
+    if(entry_id < index->count) {
+        // Seeking to the current position would drop stream cache
+        if(index->entries[entry_id].line_start != position) {
+            stream_seek(stream, index->entries[entry_id].line_start, StreamOffsetFromStart);
+        }
+    } else {
+        stream_seek(stream, 0, StreamOffsetFromEnd);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FlipperFormatIndex FlipperFormatIndex;
+
+/**
+ * Allocate key index. Index is built on first seek.
+ * @return FlipperFormatIndex* 
+ */
+FlipperFormatIndex* flipper_format_index_alloc(void);
+
+/**
+ * Free key index.
+ * @param index 
+ */
+void flipper_format_index_free(FlipperFormatIndex* index);
+
+/**
+ * Drop index data, must be called when stream content is changed.
+ * @param index 
+ */
+void flipper_format_index_reset(FlipperFormatIndex* index);
+
+/**
+ * Move stream forward to the line start of the next candidate for the key.
+ * Stream is not moved if its position is not a line boundary known to the index,
+ * so flipper_format_stream_seek_to_key finds the same key with or without this call.
+ * @param index 
+ * @param stream 
+ * @param key 
+ * @param strict_mode 
+ */
+void flipper_format_index_seek(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    const char* key,
+    bool strict_mode);
+
+#ifdef __cplusplus
+}
+#endif
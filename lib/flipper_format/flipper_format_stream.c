@@ -1,9 +1,15 @@
 #include <inttypes.h>
+#include <string.h>
 #include <toolbox/hex.h>
 #include <core/check.h>
+#include <core/common_defines.h>
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
 
+#define FLIPPER_FORMAT_STREAM_BUFFER_SIZE 32U
+// Fits any float written with "%f", longer hex values are parsed by prefix
+#define FLIPPER_FORMAT_STREAM_TOKEN_SIZE 64U
+
 static inline bool flipper_format_stream_is_space(char c) {
     return c == ' ' || c == '\t' || c == flipper_format_eolr;
 }
@@ -30,233 +36,351 @@ bool flipper_format_stream_write_eol(Stream* stream) {
     return flipper_format_stream_write(stream, &flipper_format_eoln, 1);
 }
 
-static bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key) {
-    furi_string_reset(key);
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
+/** Window over stream data. Points into the stream memory if the stream supports peeking,
+ * otherwise into the local buffer */
+typedef struct {
+    Stream* stream;
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    bool peeked;
+    uint8_t buffer[FLIPPER_FORMAT_STREAM_BUFFER_SIZE];
+} FlipperFormatStreamWindow;
+
+/** Single value, truncated to the buffer size */
+typedef struct {
+    char data[FLIPPER_FORMAT_STREAM_TOKEN_SIZE];
+    size_t size; ///< Full value size, may be bigger than data
+} FlipperFormatStreamToken;
+
+static void flipper_format_stream_window_init(FlipperFormatStreamWindow* window, Stream* stream) {
+    window->stream = stream;
+    window->data = NULL;
+    window->size = 0;
+    window->position = 0;
+    window->peeked = false;
+}
+
+// Consume the current window and load the next one
+static bool flipper_format_stream_window_next(FlipperFormatStreamWindow* window) {
+    if(window->peeked && !stream_seek(window->stream, window->size, StreamOffsetFromCurrent)) {
+        window->size = 0;
+        window->peeked = false;
+        return false;
+    }
+
+    window->position = 0;
+    window->size = stream_peek(window->stream, &window->data);
+    window->peeked = (window->size > 0);
+    if(!window->peeked) {
+        window->data = window->buffer;
+        window->size = stream_read(window->stream, window->buffer, sizeof(window->buffer));
+    }
+
+    return window->size > 0;
+}
+
+// Move the stream RW pointer to the window position
+static bool flipper_format_stream_window_release(FlipperFormatStreamWindow* window) {
+    int32_t offset = window->peeked ? (int32_t)window->position :
+                                      (int32_t)window->position - (int32_t)window->size;
+    window->size = 0;
+    window->position = 0;
+    window->peeked = false;
+    return (offset == 0) || stream_seek(window->stream, offset, StreamOffsetFromCurrent);
+}
+
+static inline bool flipper_format_stream_window_at_end(FlipperFormatStreamWindow* window) {
+    return window->position == window->size;
+}
+
+static void flipper_format_stream_token_append(
+    FlipperFormatStreamToken* token,
+    const uint8_t* data,
+    size_t size) {
+    if(token->size + 1 < sizeof(token->data)) {
+        const size_t copy_size = MIN(size, sizeof(token->data) - token->size - 1);
+        memcpy(token->data + token->size, data, copy_size);
+        token->data[token->size + copy_size] = '\0';
+    }
+    token->size += size;
+}
+
+static inline bool flipper_format_stream_token_truncated(FlipperFormatStreamToken* token) {
+    return token->size >= sizeof(token->data);
+}
+
+// furi_string_set_strn expects a null-terminated source, window data is not
+static void
+    flipper_format_stream_string_append(FuriString* string, const uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        furi_string_push_back(string, data[i]);
+    }
+}
+
+bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
+    const size_t key_size = strlen(key);
+    size_t key_position = 0;
+    bool key_match = true;
 
     bool found = false;
-    bool error = false;
+    bool mismatch = false;
     bool accumulate = true;
     bool new_line = true;
 
-    while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-        if(was_read == 0) break;
+    FlipperFormatStreamWindow window;
+    flipper_format_stream_window_init(&window, stream);
 
-        for(size_t i = 0; i < was_read; i++) {
-            uint8_t data = buffer[i];
+    // Keys are compared in place, without copying them out of the stream
+    while(!found && !mismatch && flipper_format_stream_window_next(&window)) {
+        for(; window.position < window.size; window.position++) {
+            const uint8_t data = window.data[window.position];
             if(data == flipper_format_eoln) {
-                // EOL found, clean data, start accumulating data and set the new_line flag
-                furi_string_reset(key);
+                // EOL found, start matching a new key and set the new_line flag
+                key_position = 0;
+                key_match = true;
                 accumulate = true;
                 new_line = true;
             } else if(data == flipper_format_eolr) {
                 // ignore
             } else if(data == flipper_format_comment && new_line) {
                 // if there is a comment character and we are at the beginning of a new line
-                // do not accumulate comment data and reset the new_line flag
+                // do not match comment data and reset the new_line flag
                 accumulate = false;
                 new_line = false;
             } else if(data == flipper_format_delimiter) {
                 if(new_line) {
-                    // we are on a "new line" and found the delimiter
-                    // this can only be if we have previously found some kind of key, so
-                    // clear the data, set the flag that we no longer want to accumulate data
-                    // and reset the new_line flag
-                    furi_string_reset(key);
+                    // delimiter without a key, skip the rest of the line
+                    key_position = 0;
+                    key_match = true;
                     accumulate = false;
                     new_line = false;
-                } else {
-                    // parse the delimiter only if we are accumulating data
-                    if(accumulate) {
-                        // we found the delimiter, move the rw pointer to the delimiter location
-                        // and signal that we have found something
-                        if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                            error = true;
-                            break;
-                        }
-
+                } else if(accumulate) {
+                    // end of the key, stop at the delimiter if it is the one we are looking for
+                    if(key_match && key_position == key_size) {
                         found = true;
                         break;
+                    } else if(strict_mode) {
+                        mismatch = true;
+                        break;
                     }
+                    accumulate = false;
                 }
             } else {
                 // just new symbol, reset the new_line flag
                 new_line = false;
-                if(accumulate) {
-                    // and accumulate data if we want
-                    furi_string_push_back(key, data);
+                if(accumulate && key_match) {
+                    key_match = (key_position < key_size) && (key[key_position] == data);
+                    key_position++;
                 }
             }
         }
-
-        if(found || error) break;
     }
 
+    if(!flipper_format_stream_window_release(&window)) return false;
+    if(found && !stream_seek(stream, 2, StreamOffsetFromCurrent)) return false;
+
     return found;
 }
 
-bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
-    bool found = false;
-    FuriString* read_key;
+uint16_t flipper_format_stream_key_hash_push(uint16_t hash, char c) {
+    // FNV-1a folded to 16 bits
+    uint32_t folded = ((hash ^ (uint8_t)c) * 0x01000193UL);
+    return (uint16_t)(folded ^ (folded >> 16));
+}
+
+uint16_t flipper_format_stream_key_hash(const char* key) {
+    uint16_t hash = FLIPPER_FORMAT_STREAM_KEY_HASH_INIT;
+    while(*key) {
+        hash = flipper_format_stream_key_hash_push(hash, *key++);
+    }
+    return hash;
+}
 
-    read_key = furi_string_alloc();
+bool flipper_format_stream_scan_keys(
+    Stream* stream,
+    FlipperFormatStreamKeyCallback callback,
+    void* context) {
+    size_t offset = stream_tell(stream);
+    size_t line_start = offset;
+    uint16_t key_hash = FLIPPER_FORMAT_STREAM_KEY_HASH_INIT;
+
+    bool result = true;
+    bool key_found = false;
+    bool accumulate = true;
+    bool new_line = true;
 
-    while(!stream_eof(stream)) {
-        if(flipper_format_stream_read_valid_key(stream, read_key)) {
-            if(furi_string_cmp_str(read_key, key) == 0) {
-                if(!stream_seek(stream, 2, StreamOffsetFromCurrent)) break;
+    FlipperFormatStreamWindow window;
+    flipper_format_stream_window_init(&window, stream);
 
-                found = true;
-                break;
-            } else if(strict_mode) {
-                found = false;
-                break;
+    // Same rules as flipper_format_stream_seek_to_key, one key per line at most
+    while(result && flipper_format_stream_window_next(&window)) {
+        for(; window.position < window.size; window.position++, offset++) {
+            const uint8_t data = window.data[window.position];
+            if(data == flipper_format_eoln) {
+                if(key_found && !callback(context, key_hash, line_start, offset)) {
+                    result = false;
+                    break;
+                }
+                line_start = offset + 1;
+                key_hash = FLIPPER_FORMAT_STREAM_KEY_HASH_INIT;
+                key_found = false;
+                accumulate = true;
+                new_line = true;
+            } else if(data == flipper_format_eolr) {
+                // ignore
+            } else if(data == flipper_format_comment && new_line) {
+                accumulate = false;
+                new_line = false;
+            } else if(data == flipper_format_delimiter) {
+                if(!new_line && accumulate) {
+                    key_found = true;
+                }
+                accumulate = false;
+                new_line = false;
+            } else {
+                new_line = false;
+                if(accumulate) {
+                    key_hash = flipper_format_stream_key_hash_push(key_hash, data);
+                }
             }
         }
     }
-    furi_string_free(read_key);
 
-    return found;
+    if(result && key_found) {
+        result = callback(context, key_hash, line_start, offset);
+    }
+
+    if(!flipper_format_stream_window_release(&window)) {
+        result = false;
+    }
+
+    return result;
 }
 
-static bool flipper_format_stream_read_value(Stream* stream, FuriString* value, bool* last) {
+static bool flipper_format_stream_read_value(
+    FlipperFormatStreamWindow* window,
+    FlipperFormatStreamToken* token,
+    bool* last) {
     enum { LeadingSpace, ReadValue, TrailingSpace } state = LeadingSpace;
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
     bool result = false;
     bool error = false;
 
-    furi_string_reset(value);
+    token->size = 0;
+    token->data[0] = '\0';
 
-    while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-
-        if(was_read == 0) {
-            if(state != LeadingSpace && stream_eof(stream)) {
+    while(!result && !error) {
+        if(flipper_format_stream_window_at_end(window) &&
+           !flipper_format_stream_window_next(window)) {
+            if(state != LeadingSpace && stream_eof(window->stream)) {
                 result = true;
                 *last = true;
             } else {
                 error = true;
             }
+            break;
         }
 
-        for(uint16_t i = 0; i < was_read; i++) {
-            const uint8_t data = buffer[i];
+        // Value is appended as one slice of the window
+        size_t value_start = window->position;
+        for(; window->position < window->size; window->position++) {
+            const uint8_t data = window->data[window->position];
 
             if(state == LeadingSpace) {
                 if(flipper_format_stream_is_space(data)) {
                     continue;
                 } else if(data == flipper_format_eoln) {
-                    stream_seek(stream, i - was_read, StreamOffsetFromCurrent);
                     error = true;
                     break;
                 } else {
                     state = ReadValue;
-                    furi_string_push_back(value, data);
+                    value_start = window->position;
                 }
             } else if(state == ReadValue) {
-                if(flipper_format_stream_is_space(data)) {
+                if(flipper_format_stream_is_space(data) || data == flipper_format_eoln) {
+                    flipper_format_stream_token_append(
+                        token, &window->data[value_start], window->position - value_start);
                     state = TrailingSpace;
-                } else if(data == flipper_format_eoln) {
-                    if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                        error = true;
-                    } else {
+                    if(data == flipper_format_eoln) {
                         result = true;
                         *last = true;
+                        break;
                     }
-                    break;
-                } else {
-                    furi_string_push_back(value, data);
                 }
             } else if(state == TrailingSpace) {
                 if(flipper_format_stream_is_space(data)) {
                     continue;
-                } else if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
-                } else {
-                    *last = (data == flipper_format_eoln);
-                    result = true;
                 }
+                *last = (data == flipper_format_eoln);
+                result = true;
                 break;
             }
         }
 
-        if(error || result) break;
+        // Value continues in the next window
+        if(state == ReadValue) {
+            flipper_format_stream_token_append(
+                token, &window->data[value_start], window->size - value_start);
+        }
     }
 
     return result;
 }
 
-static bool flipper_format_stream_read_line(Stream* stream, FuriString* str_result) {
+static bool
+    flipper_format_stream_read_line(FlipperFormatStreamWindow* window, FuriString* str_result) {
     furi_string_reset(str_result);
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
-
-    do {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-        if(was_read == 0) break;
-
-        bool result = false;
-        bool error = false;
+    bool found = false;
 
-        for(size_t i = 0; i < was_read; i++) {
-            uint8_t data = buffer[i];
-            if(data == flipper_format_eoln) {
-                if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
+    while(!found && (!flipper_format_stream_window_at_end(window) ||
+                     flipper_format_stream_window_next(window))) {
+        size_t slice_start = window->position;
+        for(; window->position < window->size; window->position++) {
+            const uint8_t data = window->data[window->position];
+            if(data == flipper_format_eoln || data == flipper_format_eolr) {
+                flipper_format_stream_string_append(
+                    str_result, &window->data[slice_start], window->position - slice_start);
+                slice_start = window->position + 1;
+                if(data == flipper_format_eoln) {
+                    found = true;
                     break;
                 }
-
-                result = true;
-                break;
-            } else if(data == flipper_format_eolr) {
-                // Ignore
-            } else {
-                furi_string_push_back(str_result, data);
             }
         }
 
-        if(result || error) {
-            break;
+        if(!found) {
+            flipper_format_stream_string_append(
+                str_result, &window->data[slice_start], window->size - slice_start);
         }
-    } while(true);
+    }
 
     return furi_string_size(str_result) != 0;
 }
 
 static bool flipper_format_stream_seek_to_next_line(Stream* stream) {
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
     bool result = false;
-    bool error = false;
 
-    do {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-        if(was_read == 0) {
-            if(stream_eof(stream)) {
-                result = true;
-                break;
-            }
-        }
-
-        for(size_t i = 0; i < was_read; i++) {
-            if(buffer[i] == flipper_format_eoln) {
-                if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
-                    break;
-                }
+    FlipperFormatStreamWindow window;
+    flipper_format_stream_window_init(&window, stream);
 
-                result = true;
-                break;
-            }
+    while(!result) {
+        if(!flipper_format_stream_window_next(&window)) {
+            result = stream_eof(stream);
+            break;
         }
 
-        if(result || error) {
-            break;
+        const uint8_t* eol = memchr(window.data, flipper_format_eoln, window.size);
+        if(eol) {
+            window.position = eol - window.data;
+            result = true;
+        } else {
+            window.position = window.size;
         }
-    } while(true);
+    }
+
+    if(!flipper_format_stream_window_release(&window)) {
+        result = false;
+    }
 
     return result;
 }
@@ -344,35 +468,36 @@ bool flipper_format_stream_read_value_line(
     bool strict_mode) {
     bool result = false;
 
+    FlipperFormatStreamWindow window;
+    flipper_format_stream_window_init(&window, stream);
+
     do {
         if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
 
         if(type == FlipperStreamValueStr) {
             FuriString* data = (FuriString*)_data;
-            if(flipper_format_stream_read_line(stream, data)) {
+            if(flipper_format_stream_read_line(&window, data)) {
                 result = true;
                 break;
             }
         } else {
             result = true;
-            FuriString* value;
-            value = furi_string_alloc();
+            // Values are parsed from the stack, whole array is read through one window
+            FlipperFormatStreamToken value;
 
             for(size_t i = 0; i < data_size; i++) {
                 bool last = false;
-                result = flipper_format_stream_read_value(stream, value, &last);
+                result = flipper_format_stream_read_value(&window, &value, &last);
                 if(result) {
                     int scan_values = 0;
+                    const bool truncated = flipper_format_stream_token_truncated(&value);
 
                     switch(type) {
                     case FlipperStreamValueHex: {
                         uint8_t* data = _data;
-                        if(furi_string_size(value) >= 2) {
+                        if(value.size >= 2) {
                             // sscanf "%02X" does not work here
-                            if(hex_char_to_uint8(
-                                   furi_string_get_char(value, 0),
-                                   furi_string_get_char(value, 1),
-                                   &data[i])) {
+                            if(hex_char_to_uint8(value.data[0], value.data[1], &data[i])) {
                                 scan_values = 1;
                             }
                         }
@@ -381,10 +506,10 @@ bool flipper_format_stream_read_value_line(
                     case FlipperStreamValueFloat: {
                         float* data = _data;
                         // newlib-nano does not have sscanf for floats
-                        // scan_values = sscanf(furi_string_get_cstr(value), "%f", &data[i]);
+                        // scan_values = sscanf(value.data, "%f", &data[i]);
                         char* end_char;
-                        data[i] = strtof(furi_string_get_cstr(value), &end_char);
-                        if(*end_char == 0) {
+                        data[i] = strtof(value.data, &end_char);
+                        if(*end_char == 0 && !truncated) {
                             // most likely ok
                             scan_values = 1;
                         }
@@ -392,23 +517,33 @@ bool flipper_format_stream_read_value_line(
 #endif
                     case FlipperStreamValueInt32: {
                         int32_t* data = _data;
-                        scan_values = sscanf(furi_string_get_cstr(value), "%" PRIi32, &data[i]);
+                        // Same as sscanf "%" PRIi32, without format parsing
+                        char* end_char;
+                        data[i] = strtol(value.data, &end_char, 0);
+                        if(end_char != value.data) {
+                            scan_values = 1;
+                        }
                     }; break;
                     case FlipperStreamValueUint32: {
                         uint32_t* data = _data;
-                        scan_values = sscanf(furi_string_get_cstr(value), "%" PRIu32, &data[i]);
+                        // Same as sscanf "%" PRIu32, without format parsing
+                        char* end_char;
+                        data[i] = strtoul(value.data, &end_char, 10);
+                        if(end_char != value.data) {
+                            scan_values = 1;
+                        }
                     }; break;
                     case FlipperStreamValueHexUint64: {
                         uint64_t* data = _data;
-                        if(furi_string_size(value) >= 16) {
-                            if(hex_chars_to_uint64(furi_string_get_cstr(value), &data[i])) {
+                        if(value.size >= 16) {
+                            if(hex_chars_to_uint64(value.data, &data[i])) {
                                 scan_values = 1;
                             }
                         }
                     }; break;
                     case FlipperStreamValueBool: {
                         bool* data = _data;
-                        data[i] = !furi_string_cmpi(value, "true");
+                        data[i] = !truncated && !strcasecmp(value.data, "true");
                         scan_values = 1;
                     }; break;
                     default:
@@ -428,11 +563,13 @@ bool flipper_format_stream_read_value_line(
                     break;
                 }
             }
-
-            furi_string_free(value);
         }
     } while(false);
 
+    if(!flipper_format_stream_window_release(&window)) {
+        result = false;
+    }
+
     return result;
 }
 
@@ -444,8 +581,9 @@ bool flipper_format_stream_get_value_count(
     bool result = false;
     bool last = false;
 
-    FuriString* value;
-    value = furi_string_alloc();
+    FlipperFormatStreamWindow window;
+    flipper_format_stream_window_init(&window, stream);
+    FlipperFormatStreamToken value;
 
     uint32_t position = stream_tell(stream);
     do {
@@ -454,7 +592,7 @@ bool flipper_format_stream_get_value_count(
 
         result = true;
         while(true) {
-            if(!flipper_format_stream_read_value(stream, value, &last)) {
+            if(!flipper_format_stream_read_value(&window, &value, &last)) {
                 result = false;
                 break;
             }
@@ -465,11 +603,11 @@ bool flipper_format_stream_get_value_count(
 
     } while(false);
 
-    if(!stream_seek(stream, position, StreamOffsetFromStart)) {
+    if(!flipper_format_stream_window_release(&window) ||
+       !stream_seek(stream, position, StreamOffsetFromStart)) {
         result = false;
     }
 
-    furi_string_free(value);
     return result;
 }
 
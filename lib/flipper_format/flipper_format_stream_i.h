@@ -29,6 +29,50 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+#define FLIPPER_FORMAT_STREAM_KEY_HASH_INIT (0x9DC5U)
+
+/**
+ * Key line callback for flipper_format_stream_scan_keys.
+ * @param context callback context
+ * @param key_hash key hash, see flipper_format_stream_key_hash
+ * @param line_start offset of the line start
+ * @param line_end offset of the line end, EOL character or end of the stream
+ * @return true to continue scan
+ */
+typedef bool (*FlipperFormatStreamKeyCallback)(
+    void* context,
+    uint16_t key_hash,
+    size_t line_start,
+    size_t line_end);
+
+/**
+ * Add key character to the hash.
+ * @param hash current hash, FLIPPER_FORMAT_STREAM_KEY_HASH_INIT for an empty key
+ * @param c key character
+ * @return uint16_t new hash
+ */
+uint16_t flipper_format_stream_key_hash_push(uint16_t hash, char c);
+
+/**
+ * Calculate key hash, as reported by flipper_format_stream_scan_keys.
+ * @param key 
+ * @return uint16_t 
+ */
+uint16_t flipper_format_stream_key_hash(const char* key);
+
+/**
+ * Find all keys from the current position of the stream to its end.
+ * Position is after the last scanned character.
+ * @param stream 
+ * @param callback called for every line with a key, in stream order
+ * @param context callback context
+ * @return true if the whole stream was scanned
+ */
+bool flipper_format_stream_scan_keys(
+    Stream* stream,
+    FlipperFormatStreamKeyCallback callback,
+    void* context);
+
 #ifdef __cplusplus
 }
 #endif
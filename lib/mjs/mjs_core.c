@@ -88,6 +88,8 @@ struct mjs* mjs_create(void* context) {
     mbuf_init(&mjs->array_buffers, 0);
 
     mjs->bcode_len = 0;
+    /* Zeroed cache entries never match */
+    mjs->cache_epoch = 1;
 
     /*
    * The compacting GC exploits the null terminator of the previous string as a
@@ -60,6 +60,28 @@ struct mjs_bcode_part {
     unsigned in_rom : 1;
 };
 
+/*
+ * Inline cache entry of a property lookup site: own property of the object
+ * found by the last lookup at bcode offset `site`. Valid while `epoch` matches
+ * `mjs->cache_epoch`.
+ */
+struct mjs_prop_cache_entry {
+    mjs_val_t obj;
+    struct mjs_property* prop;
+    size_t site;
+    uint32_t epoch;
+};
+
+/*
+ * Owned string made by the string literal at bcode offset `site`, pushed again
+ * by the same literal while `epoch` matches `mjs->cache_epoch`.
+ */
+struct mjs_str_cache_entry {
+    mjs_val_t str;
+    size_t site;
+    uint32_t epoch;
+};
+
 struct mjs {
     struct mbuf bcode_gen;
     struct mbuf bcode_parts;
@@ -89,6 +111,15 @@ struct mjs {
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
 
+    /*
+     * Bumped on property deletion to drop all cache entries. Adding a property
+     * keeps cached ones valid, since they are still found first. GC drops
+     * entries of freed objects and relocates cached strings.
+     */
+    uint32_t cache_epoch;
+    struct mjs_prop_cache_entry prop_cache[MJS_PROP_CACHE_SIZE];
+    struct mjs_str_cache_entry str_cache[MJS_PROP_CACHE_SIZE];
+
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
     unsigned generate_jsc : 1;
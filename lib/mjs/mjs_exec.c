@@ -77,12 +77,76 @@ static size_t call_stack_restore_frame(struct mjs* mjs) {
     return return_address;
 }
 
-static mjs_val_t mjs_find_scope(struct mjs* mjs, mjs_val_t key) {
+/*
+ * Property inline cache: each lookup site of the bcode remembers the own
+ * property of a plain object it has found last, so that repeated lookups of
+ * the same object check one name instead of walking the property list.
+ */
+static struct mjs_prop_cache_entry*
+    prop_cache_entry(struct mjs* mjs, size_t site, mjs_val_t obj, mjs_val_t key) {
+    if((obj & MJS_TAG_MASK) != MJS_TAG_OBJECT || !mjs_is_string(key)) {
+        return NULL;
+    }
+    return &mjs->prop_cache[site % MJS_PROP_CACHE_SIZE];
+}
+
+static struct mjs_property*
+    prop_cache_get(struct mjs* mjs, size_t site, mjs_val_t obj, mjs_val_t key) {
+    struct mjs_prop_cache_entry* e = prop_cache_entry(mjs, site, obj, key);
+    size_t n;
+    const char* s;
+
+    if(e == NULL || e->site != site || e->obj != obj || e->epoch != mjs->cache_epoch) {
+        return NULL;
+    }
+    /* Names of up to 5 chars are immediate values, longer ones are compared */
+    if(e->prop->name == key) {
+        return e->prop;
+    }
+    s = mjs_get_string(mjs, &e->prop->name, &n);
+    return mjs_strcmp(mjs, &key, s, n) == 0 ? e->prop : NULL;
+}
+
+static struct mjs_property*
+    prop_cache_lookup(struct mjs* mjs, size_t site, mjs_val_t obj, mjs_val_t key) {
+    struct mjs_prop_cache_entry* e;
+    struct mjs_property* p = prop_cache_get(mjs, site, obj, key);
+
+    if(p == NULL && (p = mjs_get_own_property_v(mjs, obj, key)) != NULL &&
+       (e = prop_cache_entry(mjs, site, obj, key)) != NULL) {
+        e->obj = obj;
+        e->prop = p;
+        e->site = site;
+        e->epoch = mjs->cache_epoch;
+    }
+    return p;
+}
+
+/*
+ * Literals longer than 5 chars are copied to owned strings, the copy made by a
+ * site is pushed again instead of filling the buffer on every push.
+ */
+static mjs_val_t mjs_mk_literal(struct mjs* mjs, size_t site, const char* p, size_t len) {
+    struct mjs_str_cache_entry* e = &mjs->str_cache[site % MJS_PROP_CACHE_SIZE];
+
+    if(len <= 5) {
+        return mjs_mk_string(mjs, p, len, 1);
+    }
+    if(e->site != site || e->epoch != mjs->cache_epoch) {
+        e->str = mjs_mk_string(mjs, p, len, 1);
+        e->site = site;
+        e->epoch = mjs->cache_epoch;
+    }
+    return e->str;
+}
+
+static mjs_val_t mjs_find_scope(struct mjs* mjs, size_t site, mjs_val_t key) {
     size_t num_scopes = mjs_stack_size(&mjs->scopes);
     while(num_scopes > 0) {
         mjs_val_t scope = *vptr(&mjs->scopes, num_scopes - 1);
         num_scopes--;
-        if(mjs_get_own_property_v(mjs, scope, key) != NULL) return scope;
+        /* Inner scopes are still checked first, so the cached one is not shadowed */
+        if(prop_cache_lookup(mjs, site, scope, key) != NULL) return scope;
     }
     mjs_set_errorf(mjs, MJS_REFERENCE_ERROR, "[%s] is not defined", mjs_get_cstring(mjs, &key));
     return MJS_UNDEFINED;
@@ -717,7 +781,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
         }
         case OP_FIND_SCOPE: {
             mjs_val_t key = vtop(&mjs->stack);
-            mjs_push(mjs, mjs_find_scope(mjs, key));
+            mjs_push(mjs, mjs_find_scope(mjs, bp.start_idx + i, key));
             break;
         }
         case OP_CREATE: {
@@ -741,10 +805,15 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             mjs_val_t obj = mjs_pop(mjs);
             mjs_val_t key = mjs_pop(mjs);
             mjs_val_t val = MJS_UNDEFINED;
+            /* Entries of this site are filled only if the name is not a builtin one */
+            struct mjs_property* p = prop_cache_get(mjs, bp.start_idx + i, obj, key);
 
-            if(!getprop_builtin(mjs, obj, key, &val)) {
+            if(p != NULL) {
+                val = p->value;
+            } else if(!getprop_builtin(mjs, obj, key, &val)) {
                 if(mjs_is_object(obj)) {
-                    val = mjs_get_v_proto(mjs, obj, key);
+                    p = prop_cache_lookup(mjs, bp.start_idx + i, obj, key);
+                    val = (p != NULL) ? p->value : mjs_get_v_proto(mjs, obj, key);
                 } else if((mjs_is_data_view(obj) && (mjs_is_number(key)))) {
                     val = mjs_dataview_get_prop(mjs, obj, key);
                 } else {
@@ -784,7 +853,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             break;
         case OP_PUSH_STR: {
             int llen, n = cs_varint_decode_unsafe(&code[i + 1], &llen);
-            mjs_push(mjs, mjs_mk_string(mjs, (char*)code + i + 1 + llen, n, 1));
+            mjs_push(mjs, mjs_mk_literal(mjs, bp.start_idx + i, (char*)code + i + 1 + llen, n));
             i += llen + n;
             break;
         }
@@ -815,7 +884,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
                 mjs_val_t var_name = *vptr(&mjs->stack, -3);
                 mjs_val_t key = mjs_next(mjs, obj, iterator);
                 if(key != MJS_UNDEFINED) {
-                    mjs_val_t scope = mjs_find_scope(mjs, var_name);
+                    mjs_val_t scope = mjs_find_scope(mjs, bp.start_idx + i, var_name);
                     mjs_set_v(mjs, scope, var_name, key);
                 }
             } else {
@@ -30,4 +30,13 @@
 #endif
 #endif
 
+/*
+ * MJS_PROP_CACHE_SIZE: number of inline cache entries of property lookups and
+ * of string literals. Each site of the bcode uses entry at its offset modulo
+ * this size.
+ */
+#if !defined(MJS_PROP_CACHE_SIZE)
+#define MJS_PROP_CACHE_SIZE 32
+#endif
+
 #endif /* MJS_FEATURES_H_ */
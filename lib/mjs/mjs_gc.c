@@ -483,6 +483,31 @@ static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs) {
     }
 }
 
+/* Cached literals are kept and relocated like other roots */
+static void gc_mark_str_cache(struct mjs* mjs) {
+    size_t i;
+    for(i = 0; i < MJS_PROP_CACHE_SIZE; i++) {
+        struct mjs_str_cache_entry* e = &mjs->str_cache[i];
+        if(e->epoch == mjs->cache_epoch) {
+            gc_mark(mjs, &e->str);
+        }
+    }
+}
+
+/*
+ * Drop cached properties of objects about to be freed, properties of alive
+ * objects are alive too
+ */
+static void gc_prune_prop_cache(struct mjs* mjs) {
+    size_t i;
+    for(i = 0; i < MJS_PROP_CACHE_SIZE; i++) {
+        struct mjs_prop_cache_entry* e = &mjs->prop_cache[i];
+        if(e->epoch == mjs->cache_epoch && !MARKED(get_object_struct(e->obj))) {
+            e->epoch = 0;
+        }
+    }
+}
+
 /* Perform garbage collection */
 void mjs_gc(struct mjs* mjs, int full) {
     gc_mark_val_array(mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t));
@@ -493,9 +518,11 @@ void mjs_gc(struct mjs* mjs, int full) {
     gc_mark_mbuf_val(mjs, &mjs->call_stack);
 
     gc_mark_ffi_cbargs_list(mjs, mjs->ffi_cb_args);
+    gc_mark_str_cache(mjs);
 
     gc_compact_strings(mjs);
 
+    gc_prune_prop_cache(mjs);
     gc_sweep(mjs, &mjs->object_arena, 0);
     gc_sweep(mjs, &mjs->property_arena, 0);
     gc_sweep(mjs, &mjs->ffi_sig_arena, 0);
@@ -238,6 +238,7 @@ int mjs_del(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
                 get_object_struct(obj)->properties = prop->next;
             }
             mjs_destroy_property(&prop);
+            mjs->cache_epoch++;
             return 0;
         }
     }
@@ -60,6 +60,9 @@ const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .serialize = subghz_protocol_decoder_came_serialize,
     .deserialize = subghz_protocol_decoder_came_deserialize,
     .get_string = subghz_protocol_decoder_came_get_string,
+
+    .timing = &subghz_protocol_came_const,
+    .in_frame = subghz_protocol_decoder_came_in_frame,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_encoder = {
@@ -236,6 +239,12 @@ void subghz_protocol_decoder_came_reset(void* context) {
     instance->decoder.parser_step = CameDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_came_in_frame(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderCame* instance = context;
+    return instance->decoder.parser_step != CameDecoderStepReset;
+}
+
 void subghz_protocol_decoder_came_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderCame* instance = context;
@@ -82,6 +82,9 @@ const SubGhzProtocolDecoder subghz_protocol_came_twee_decoder = {
     .serialize = subghz_protocol_decoder_came_twee_serialize,
     .deserialize = subghz_protocol_decoder_came_twee_deserialize,
     .get_string = subghz_protocol_decoder_came_twee_get_string,
+
+    .timing = &subghz_protocol_came_twee_const,
+    .in_frame = subghz_protocol_decoder_came_twee_in_frame,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_twee_encoder = {
@@ -315,6 +318,12 @@ void subghz_protocol_decoder_came_twee_reset(void* context) {
         NULL);
 }
 
+bool subghz_protocol_decoder_came_twee_in_frame(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderCameTwee* instance = context;
+    return instance->decoder.parser_step != CameTweeDecoderStepReset;
+}
+
 void subghz_protocol_decoder_came_twee_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderCameTwee* instance = context;
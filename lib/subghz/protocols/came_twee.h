@@ -65,6 +65,13 @@ void subghz_protocol_decoder_came_twee_free(void* context);
  */
 void subghz_protocol_decoder_came_twee_reset(void* context);
 
+/**
+ * Checking if the decoder is in the middle of a frame.
+ * @param context Pointer to a SubGhzProtocolDecoderCameTwee instance
+ * @return true if every following pulse must be fed to the decoder
+ */
+bool subghz_protocol_decoder_came_twee_in_frame(void* context);
+
 /**
  * Parse a raw sequence of levels and durations received from the air.
  * @param context Pointer to a SubGhzProtocolDecoderCameTwee instance
@@ -48,6 +48,9 @@ const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder = {
     .serialize = subghz_protocol_decoder_gate_tx_serialize,
     .deserialize = subghz_protocol_decoder_gate_tx_deserialize,
     .get_string = subghz_protocol_decoder_gate_tx_get_string,
+
+    .timing = &subghz_protocol_gate_tx_const,
+    .in_frame = subghz_protocol_decoder_gate_tx_in_frame,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_gate_tx_encoder = {
@@ -200,6 +203,12 @@ void subghz_protocol_decoder_gate_tx_reset(void* context) {
     instance->decoder.parser_step = GateTXDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_gate_tx_in_frame(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderGateTx* instance = context;
+    return instance->decoder.parser_step != GateTXDecoderStepReset;
+}
+
 void subghz_protocol_decoder_gate_tx_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderGateTx* instance = context;
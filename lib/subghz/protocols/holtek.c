@@ -58,6 +58,9 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .serialize = subghz_protocol_decoder_holtek_serialize,
     .deserialize = subghz_protocol_decoder_holtek_deserialize,
     .get_string = subghz_protocol_decoder_holtek_get_string,
+
+    .timing = &subghz_protocol_holtek_const,
+    .in_frame = subghz_protocol_decoder_holtek_in_frame,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_encoder = {
@@ -213,6 +216,12 @@ void subghz_protocol_decoder_holtek_reset(void* context) {
     instance->decoder.parser_step = HoltekDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_holtek_in_frame(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoltek* instance = context;
+    return instance->decoder.parser_step != HoltekDecoderStepReset;
+}
+
 void subghz_protocol_decoder_holtek_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderHoltek* instance = context;
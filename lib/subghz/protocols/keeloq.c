@@ -66,6 +66,9 @@ const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
     .serialize = subghz_protocol_decoder_keeloq_serialize,
     .deserialize = subghz_protocol_decoder_keeloq_deserialize,
     .get_string = subghz_protocol_decoder_keeloq_get_string,
+
+    .timing = &subghz_protocol_keeloq_const,
+    .in_frame = subghz_protocol_decoder_keeloq_in_frame,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_keeloq_encoder = {
@@ -623,6 +626,12 @@ void subghz_protocol_decoder_keeloq_reset(void* context) {
     instance->keystore->kl_type = 0;
 }
 
+bool subghz_protocol_decoder_keeloq_in_frame(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderKeeloq* instance = context;
+    return instance->decoder.parser_step != KeeloqDecoderStepReset;
+}
+
 void subghz_protocol_decoder_keeloq_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderKeeloq* instance = context;
@@ -766,29 +775,153 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+typedef struct {
+    uint16_t learning;
+    bool mirrored;
+    uint8_t kl_type;
+} SubGhzProtocolKeeloqVariant;
+
+// Learning variants tried for keys of KEELOQ_LEARNING_UNKNOWN type, in order
+static const SubGhzProtocolKeeloqVariant subghz_protocol_keeloq_unknown_variants[] = {
+    {KEELOQ_LEARNING_SIMPLE, false, 1},
+    {KEELOQ_LEARNING_SIMPLE, true, 1},
+    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+    {KEELOQ_LEARNING_NORMAL, false, 2},
+    {KEELOQ_LEARNING_NORMAL, true, 2},
+    {KEELOQ_LEARNING_SECURE, false, 3},
+    {KEELOQ_LEARNING_SECURE, true, 3},
+    {KEELOQ_LEARNING_MAGIC_XOR_TYPE_1, false, 4},
+    {KEELOQ_LEARNING_MAGIC_XOR_TYPE_1, true, 4},
+};
+
+static uint64_t subghz_protocol_keeloq_mirror_key(uint64_t key) {
+    uint64_t man_rev = 0;
+    uint64_t man_rev_byte = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        man_rev_byte = (uint8_t)(key >> i);
+        man_rev = man_rev | man_rev_byte << (56 - i);
+    }
+    return man_rev;
+}
+
 /** 
- * Checking the accepted code against the database manafacture key
+ * Checking the accepted code against one manafacture key with given learning
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
- * @param keystore Pointer to a SubGhzKeystore* instance
- * @param manufacture_name 
- * @return true on successful search
+ * @param key Manufacture key
+ * @param learning Learning type, KEELOQ_LEARNING_*
+ * @param centurion Use Centurion discriminator check
+ * @return true if decrypted hop is valid
  */
-static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+static bool subghz_protocol_keeloq_check_learning(
     SubGhzBlockGeneric* instance,
     uint32_t fix,
     uint32_t hop,
-    SubGhzKeystore* keystore,
-    const char** manufacture_name) {
+    uint64_t key,
+    uint16_t learning,
+    bool centurion) {
     // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
     // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
 
     uint16_t end_serial = (uint16_t)(fix & 0xFF);
     uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
     uint64_t man;
+
+    switch(learning) {
+    case KEELOQ_LEARNING_SIMPLE:
+        man = key;
+        break;
+    case KEELOQ_LEARNING_NORMAL:
+        man = subghz_protocol_keeloq_common_normal_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_SECURE:
+        man = subghz_protocol_keeloq_common_secure_learning(fix, instance->seed, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        man = subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        man = subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        man = subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+        break;
+    default:
+        return false;
+    }
+
+    uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+    if(centurion) {
+        return subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn);
+    }
+    return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+}
+
+static uint8_t subghz_protocol_keeloq_get_variant_count(const SubGhzKey* manufacture_code) {
+    return manufacture_code->type == KEELOQ_LEARNING_UNKNOWN ?
+               COUNT_OF(subghz_protocol_keeloq_unknown_variants) :
+               1;
+}
+
+static bool subghz_protocol_keeloq_check_variant(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    const SubGhzKey* manufacture_code,
+    bool centurion,
+    uint8_t variant) {
+    if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+        const SubGhzProtocolKeeloqVariant* unknown =
+            &subghz_protocol_keeloq_unknown_variants[variant];
+        uint64_t key = unknown->mirrored ?
+                           subghz_protocol_keeloq_mirror_key(manufacture_code->key) :
+                           manufacture_code->key;
+        return subghz_protocol_keeloq_check_learning(
+            instance, fix, hop, key, unknown->learning, false);
+    }
+
+    return subghz_protocol_keeloq_check_learning(
+        instance,
+        fix,
+        hop,
+        manufacture_code->key,
+        manufacture_code->type,
+        centurion && manufacture_code->type == KEELOQ_LEARNING_NORMAL);
+}
+
+static uint8_t subghz_protocol_keeloq_selector_found(
+    SubGhzKeystore* keystore,
+    const SubGhzKey* manufacture_code,
+    uint8_t variant,
+    const char** manufacture_name) {
+    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+    keystore->mfname = *manufacture_name;
+    if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+        keystore->kl_type = subghz_protocol_keeloq_unknown_variants[variant].kl_type;
+    }
+    return 1;
+}
+
+/** 
+ * Checking the accepted code against the database manafacture key
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param manufacture_name 
+ * @return true on successful search
+ */
+static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    const char** manufacture_name) {
     bool mf_not_set = false;
     // TODO:
     // if(mfname == 0x0) {
@@ -802,186 +935,55 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
 
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+    const SubGhzKeystoreIndex* index = subghz_keystore_get_index(keystore);
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    const uint16_t centurion_id = subghz_keystore_find_name_id(keystore, "Centurion");
+    const uint32_t serial = fix & 0x0FFFFFFF;
+
+    // Keys to check: whole keystore or only keys of the already known manufacture
+    uint16_t name_id = SUBGHZ_KEYSTORE_INDEX_NAME_NONE;
+    size_t key_count = index->key_count;
+    if(!mf_not_set) {
+        name_id = subghz_keystore_find_name_id(keystore, mfname);
+        key_count = 0;
+        if(name_id != SUBGHZ_KEYSTORE_INDEX_NAME_NONE) {
+            key_count = index->name_key_offset[name_id + 1] - index->name_key_offset[name_id];
+        }
+    }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+    // Repeated press of the same remote: try the key and learning that matched last time
+    const SubGhzKeystoreMatch* match = subghz_keystore_match_cache_get(keystore, serial);
+    if(match && (mf_not_set || index->key_name_id[match->key_index] == name_id)) {
+        const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(*keys, match->key_index);
+        if(subghz_protocol_keeloq_check_variant(
+               instance,
+               fix,
+               hop,
+               manufacture_code,
+               index->key_name_id[match->key_index] == centurion_id,
+               match->variant)) {
+            return subghz_protocol_keeloq_selector_found(
+                keystore, manufacture_code, match->variant, manufacture_name);
+        }
+    }
 
-                    break;
-                }
+    for(size_t i = 0; i < key_count; i++) {
+        size_t key_index = mf_not_set ? i :
+                                        index->name_key[index->name_key_offset[name_id] + i];
+        const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(*keys, key_index);
+        const bool centurion = index->key_name_id[key_index] == centurion_id;
+        const uint8_t variant_count = subghz_protocol_keeloq_get_variant_count(manufacture_code);
+
+        for(uint8_t variant = 0; variant < variant_count; variant++) {
+            if(subghz_protocol_keeloq_check_variant(
+                   instance, fix, hop, manufacture_code, centurion, variant)) {
+                subghz_keystore_match_cache_set(keystore, serial, key_index, variant);
+                return subghz_protocol_keeloq_selector_found(
+                    keystore, manufacture_code, variant, manufacture_name);
             }
         }
+    }
 
     // MF not found
     *manufacture_name = "Unknown";
@@ -54,6 +54,9 @@ const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
     .serialize = subghz_protocol_decoder_linear_serialize,
     .deserialize = subghz_protocol_decoder_linear_deserialize,
     .get_string = subghz_protocol_decoder_linear_get_string,
+
+    .timing = &subghz_protocol_linear_const,
+    .in_frame = subghz_protocol_decoder_linear_in_frame,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_encoder = {
@@ -218,6 +221,12 @@ void subghz_protocol_decoder_linear_reset(void* context) {
     instance->decoder.parser_step = LinearDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_linear_in_frame(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderLinear* instance = context;
+    return instance->decoder.parser_step != LinearDecoderStepReset;
+}
+
 void subghz_protocol_decoder_linear_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderLinear* instance = context;
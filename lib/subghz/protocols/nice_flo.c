@@ -47,6 +47,9 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .serialize = subghz_protocol_decoder_nice_flo_serialize,
     .deserialize = subghz_protocol_decoder_nice_flo_deserialize,
     .get_string = subghz_protocol_decoder_nice_flo_get_string,
+
+    .timing = &subghz_protocol_nice_flo_const,
+    .in_frame = subghz_protocol_decoder_nice_flo_in_frame,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flo_encoder = {
@@ -205,6 +208,12 @@ void subghz_protocol_decoder_nice_flo_reset(void* context) {
     instance->decoder.parser_step = NiceFloDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_nice_flo_in_frame(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderNiceFlo* instance = context;
+    return instance->decoder.parser_step != NiceFloDecoderStepReset;
+}
+
 void subghz_protocol_decoder_nice_flo_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlo* instance = context;
@@ -58,6 +58,9 @@ const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .serialize = subghz_protocol_decoder_princeton_serialize,
     .deserialize = subghz_protocol_decoder_princeton_deserialize,
     .get_string = subghz_protocol_decoder_princeton_get_string,
+
+    .timing = &subghz_protocol_princeton_const,
+    .in_frame = subghz_protocol_decoder_princeton_in_frame,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_princeton_encoder = {
@@ -225,6 +228,12 @@ void subghz_protocol_decoder_princeton_reset(void* context) {
     instance->last_data = 0;
 }
 
+bool subghz_protocol_decoder_princeton_in_frame(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderPrinceton* instance = context;
+    return instance->decoder.parser_step != PrincetonDecoderStepReset;
+}
+
 void subghz_protocol_decoder_princeton_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderPrinceton* instance = context;
@@ -69,6 +69,13 @@ void subghz_protocol_decoder_princeton_free(void* context);
  */
 void subghz_protocol_decoder_princeton_reset(void* context);
 
+/**
+ * Checking if the decoder is in the middle of a frame.
+ * @param context Pointer to a SubGhzProtocolDecoderPrinceton instance
+ * @return true if every following pulse must be fed to the decoder
+ */
+bool subghz_protocol_decoder_princeton_in_frame(void* context);
+
 /**
  * Parse a raw sequence of levels and durations received from the air.
  * @param context Pointer to a SubGhzProtocolDecoderPrinceton instance
@@ -5,15 +5,37 @@
 
 #include <m-array.h>
 
+#define SUBGHZ_RECEIVER_DISPATCH_WORD_BITS 32U
+
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+    // Idle decoder ignores pulses not longer than this, 0 - feed every pulse
+    uint32_t duration_min;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 #define M_OPL_SubGhzReceiverSlotArray_t() ARRAY_OPLIST(SubGhzReceiverSlotArray, M_POD_OPLIST)
 
+/*
+ * Dispatch stage
+ *
+ * Slots are bucketed by the shortest pulse that their decoder can start a frame with.
+ * For every bucket there is a bitmask of slots that accept pulses falling into it,
+ * slots currently inside a frame are tracked in a separate bitmask and always fed.
+ * Bits are walked in slot order, so decoders are fed in the same order as the registry.
+ */
+typedef struct {
+    size_t words;
+    uint32_t* in_frame;
+
+    size_t threshold_count;
+    uint32_t* threshold; // Ascending duration_min values
+    uint32_t* mask; // (threshold_count + 1) * words, mask for durations above threshold[i - 1]
+} SubGhzReceiverDispatch;
+
 struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
+    SubGhzReceiverDispatch dispatch;
     SubGhzProtocolFlag filter;
     SubGhzProtocolFilter ignore_filter;
 
@@ -21,6 +43,86 @@ struct SubGhzReceiver {
     void* context;
 };
 
+static uint32_t subghz_receiver_slot_duration_min(const SubGhzReceiverSlot* slot) {
+    const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+    if(!decoder->timing || !decoder->in_frame ||
+       decoder->timing->te_short <= decoder->timing->te_delta) {
+        return 0;
+    }
+    return decoder->timing->te_short - decoder->timing->te_delta;
+}
+
+static void subghz_receiver_dispatch_init(SubGhzReceiver* instance) {
+    SubGhzReceiverDispatch* dispatch = &instance->dispatch;
+    const size_t slot_count = SubGhzReceiverSlotArray_size(instance->slots);
+
+    dispatch->words = (slot_count + SUBGHZ_RECEIVER_DISPATCH_WORD_BITS - 1) /
+                      SUBGHZ_RECEIVER_DISPATCH_WORD_BITS;
+    dispatch->in_frame = calloc(dispatch->words, sizeof(uint32_t));
+
+    // Collect distinct thresholds in ascending order
+    dispatch->threshold = malloc(slot_count * sizeof(uint32_t));
+    dispatch->threshold_count = 0;
+    for(size_t i = 0; i < slot_count; i++) {
+        SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(instance->slots, i);
+        slot->duration_min = subghz_receiver_slot_duration_min(slot);
+        if(slot->duration_min == 0) continue;
+
+        size_t pos = 0;
+        while(pos < dispatch->threshold_count && dispatch->threshold[pos] < slot->duration_min) {
+            pos++;
+        }
+        if(pos < dispatch->threshold_count && dispatch->threshold[pos] == slot->duration_min) {
+            continue;
+        }
+        memmove(
+            &dispatch->threshold[pos + 1],
+            &dispatch->threshold[pos],
+            (dispatch->threshold_count - pos) * sizeof(uint32_t));
+        dispatch->threshold[pos] = slot->duration_min;
+        dispatch->threshold_count++;
+    }
+
+    // Bucket i holds durations in (threshold[i - 1], threshold[i]]
+    dispatch->mask = calloc((dispatch->threshold_count + 1) * dispatch->words, sizeof(uint32_t));
+    for(size_t bucket = 0; bucket <= dispatch->threshold_count; bucket++) {
+        uint32_t* mask = &dispatch->mask[bucket * dispatch->words];
+        for(size_t i = 0; i < slot_count; i++) {
+            const SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_cget(instance->slots, i);
+            if(slot->duration_min == 0 ||
+               (bucket > 0 && slot->duration_min <= dispatch->threshold[bucket - 1])) {
+                mask[i / SUBGHZ_RECEIVER_DISPATCH_WORD_BITS] |=
+                    1UL << (i % SUBGHZ_RECEIVER_DISPATCH_WORD_BITS);
+            }
+        }
+    }
+}
+
+static void subghz_receiver_dispatch_deinit(SubGhzReceiver* instance) {
+    free(instance->dispatch.in_frame);
+    free(instance->dispatch.threshold);
+    free(instance->dispatch.mask);
+}
+
+static const uint32_t*
+    subghz_receiver_dispatch_get_mask(SubGhzReceiver* instance, uint32_t duration) {
+    SubGhzReceiverDispatch* dispatch = &instance->dispatch;
+
+    // Count thresholds strictly below duration
+    size_t low = 0;
+    size_t high = dispatch->threshold_count;
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        if(dispatch->threshold[mid] < duration) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return &dispatch->mask[low * dispatch->words];
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
@@ -37,6 +139,8 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         }
     }
 
+    subghz_receiver_dispatch_init(instance);
+
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -55,21 +159,64 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
             slot->base = NULL;
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
+    subghz_receiver_dispatch_deinit(instance);
 
     free(instance);
 }
 
+static inline void
+    subghz_receiver_dispatch_feed(SubGhzReceiver* instance, bool level, uint32_t duration) {
+    SubGhzReceiverDispatch* dispatch = &instance->dispatch;
+    const uint32_t* mask = subghz_receiver_dispatch_get_mask(instance, duration);
+
+    for(size_t word = 0; word < dispatch->words; word++) {
+        uint32_t pending = mask[word] | dispatch->in_frame[word];
+        while(pending) {
+            const uint32_t offset = __builtin_ctz(pending);
+            const uint32_t bit = 1UL << offset;
+            pending &= ~bit;
+
+            const size_t index = word * SUBGHZ_RECEIVER_DISPATCH_WORD_BITS + offset;
+            SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(instance->slots, index);
+            const SubGhzProtocol* protocol = slot->base->protocol;
+            if((protocol->flag & instance->filter) == 0 ||
+               (protocol->filter & instance->ignore_filter) != 0) {
+                continue;
+            }
+
+            protocol->decoder->feed(slot->base, level, duration);
+            if(slot->duration_min) {
+                if(protocol->decoder->in_frame(slot->base)) {
+                    dispatch->in_frame[word] |= bit;
+                } else {
+                    dispatch->in_frame[word] &= ~bit;
+                }
+            }
+        }
+    }
+}
+
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
     furi_check(instance);
     furi_check(instance->slots);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0 &&
-               (slot->base->protocol->filter & instance->ignore_filter) == 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
-            }
-        }
+    subghz_receiver_dispatch_feed(instance, level, duration);
+}
+
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_duration,
+    size_t count) {
+    furi_check(instance);
+    furi_check(instance->slots);
+    furi_check(level_duration || !count);
+
+    for(size_t i = 0; i < count; i++) {
+        subghz_receiver_dispatch_feed(
+            instance,
+            level_duration_get_level(level_duration[i]),
+            level_duration_get_duration(level_duration[i]));
+    }
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
@@ -80,6 +227,7 @@ void subghz_receiver_reset(SubGhzReceiver* instance) {
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             slot->base->protocol->decoder->reset(slot->base);
         }
+    memset(instance->dispatch.in_frame, 0, instance->dispatch.words * sizeof(uint32_t));
 }
 
 static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
@@ -22,15 +22,52 @@
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+#define SUBGHZ_KEYSTORE_BINARY_MAGIC (0x424B4753) // "SGKB"
+#define SUBGHZ_KEYSTORE_BINARY_VERSION 1
+#define SUBGHZ_KEYSTORE_BINARY_BLOCK_SIZE 16
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+/*
+ * Compiled keystore
+ *
+ * Header followed by a payload of key_count records and a string table
+ * of NUL-terminated manufacture names. Payload is padded to the AES block
+ * size and encrypted as a whole with the same key slot as the text format.
+ * Records keep keystore order: it decides which manufacture wins on lookup.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t encryption;
+    uint8_t iv[16];
+    uint32_t key_count;
+    uint32_t strings_size;
+    uint32_t payload_size;
+} FURI_PACKED SubGhzKeystoreBinaryHeader;
+
+typedef struct {
+    uint64_t key;
+    uint32_t name_offset;
+    uint16_t type;
+    uint16_t reserved;
+} FURI_PACKED SubGhzKeystoreBinaryRecord;
+
+typedef struct {
+    const char* name;
+    uint16_t key_index;
+} SubGhzKeystoreIndexEntry;
+
 SubGhzKeystore* subghz_keystore_alloc(void) {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    SubGhzKeystoreNameArray_init(instance->names);
+    memset(&instance->index, 0, sizeof(SubGhzKeystoreIndex));
+    memset(instance->match_cache, 0, sizeof(instance->match_cache));
 
     subghz_keystore_reset_kl(instance);
 
@@ -44,16 +81,191 @@ void subghz_keystore_reset_kl(SubGhzKeystore* instance) {
     instance->kl_type = 0;
 }
 
+static void subghz_keystore_index_reset(SubGhzKeystore* instance) {
+    SubGhzKeystoreIndex* index = &instance->index;
+
+    free(index->names);
+    free(index->key_name_id);
+    free(index->name_key_offset);
+    free(index->name_key);
+    memset(index, 0, sizeof(SubGhzKeystoreIndex));
+
+    // Cached key indexes are not valid anymore
+    memset(instance->match_cache, 0, sizeof(instance->match_cache));
+}
+
+static int subghz_keystore_index_entry_cmp(const void* a, const void* b) {
+    const SubGhzKeystoreIndexEntry* entry_a = a;
+    const SubGhzKeystoreIndexEntry* entry_b = b;
+
+    int ret = strcmp(entry_a->name, entry_b->name);
+    if(ret == 0) {
+        // Keep keystore order within one name
+        ret = (int)entry_a->key_index - (int)entry_b->key_index;
+    }
+    return ret;
+}
+
+static void subghz_keystore_index_build(SubGhzKeystore* instance) {
+    subghz_keystore_index_reset(instance);
+
+    SubGhzKeystoreIndex* index = &instance->index;
+    const size_t key_count = SubGhzKeyArray_size(instance->data);
+    furi_check(key_count < SUBGHZ_KEYSTORE_INDEX_NAME_NONE);
+    if(key_count == 0) return;
+
+    SubGhzKeystoreIndexEntry* entries = malloc(key_count * sizeof(SubGhzKeystoreIndexEntry));
+    for(size_t i = 0; i < key_count; i++) {
+        entries[i].name = furi_string_get_cstr(SubGhzKeyArray_cget(instance->data, i)->name);
+        entries[i].key_index = i;
+    }
+    qsort(entries, key_count, sizeof(SubGhzKeystoreIndexEntry), subghz_keystore_index_entry_cmp);
+
+    // Intern names: equal names are adjacent after sorting
+    size_t name_count = 0;
+    for(size_t i = 0; i < key_count; i++) {
+        if(i == 0 || strcmp(entries[i].name, entries[i - 1].name) != 0) name_count++;
+    }
+
+    index->names = malloc(name_count * sizeof(const char*));
+    index->name_key_offset = malloc((name_count + 1) * sizeof(uint16_t));
+    index->key_name_id = malloc(key_count * sizeof(uint16_t));
+    index->name_key = malloc(key_count * sizeof(uint16_t));
+    for(size_t i = 0; i < key_count; i++) {
+        if(i == 0 || strcmp(entries[i].name, entries[i - 1].name) != 0) {
+            index->names[index->name_count] = entries[i].name;
+            index->name_key_offset[index->name_count] = i;
+            index->name_count++;
+        }
+        index->key_name_id[entries[i].key_index] = index->name_count - 1;
+        index->name_key[i] = entries[i].key_index;
+    }
+    index->name_key_offset[index->name_count] = key_count;
+    index->key_count = key_count;
+
+    free(entries);
+
+    FURI_LOG_D(TAG, "Indexed %zu keys, %zu names", index->key_count, index->name_count);
+}
+
+const SubGhzKeystoreIndex* subghz_keystore_get_index(SubGhzKeystore* instance) {
+    furi_assert(instance);
+
+    if(instance->index.key_count != SubGhzKeyArray_size(instance->data)) {
+        subghz_keystore_index_build(instance);
+    }
+
+    return &instance->index;
+}
+
+uint16_t subghz_keystore_find_name_id(SubGhzKeystore* instance, const char* name) {
+    furi_assert(instance);
+    furi_assert(name);
+
+    const SubGhzKeystoreIndex* index = subghz_keystore_get_index(instance);
+
+    size_t low = 0;
+    size_t high = index->name_count;
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        int ret = strcmp(index->names[mid], name);
+        if(ret == 0) {
+            return mid;
+        } else if(ret < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return SUBGHZ_KEYSTORE_INDEX_NAME_NONE;
+}
+
+const SubGhzKeystoreMatch*
+    subghz_keystore_match_cache_get(SubGhzKeystore* instance, uint32_t serial) {
+    furi_assert(instance);
+
+    const SubGhzKeystoreMatch* match =
+        &instance->match_cache[serial % SUBGHZ_KEYSTORE_MATCH_CACHE_SIZE];
+    if(match->valid && match->serial == serial &&
+       match->key_index < SubGhzKeyArray_size(instance->data)) {
+        return match;
+    }
+
+    return NULL;
+}
+
+void subghz_keystore_match_cache_set(
+    SubGhzKeystore* instance,
+    uint32_t serial,
+    size_t key_index,
+    uint8_t variant) {
+    furi_assert(instance);
+
+    SubGhzKeystoreMatch* match = &instance->match_cache[serial % SUBGHZ_KEYSTORE_MATCH_CACHE_SIZE];
+    match->serial = serial;
+    match->key_index = key_index;
+    match->variant = variant;
+    match->valid = true;
+}
+
+static bool subghz_keystore_find_pooled_name(
+    SubGhzKeystore* instance,
+    const char* name,
+    size_t* position) {
+    size_t low = 0;
+    size_t high = SubGhzKeystoreNameArray_size(instance->names);
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        int ret = furi_string_cmp_str(*SubGhzKeystoreNameArray_cget(instance->names, mid), name);
+        if(ret == 0) {
+            *position = mid;
+            return true;
+        } else if(ret < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *position = low;
+    return false;
+}
+
+static FuriString* subghz_keystore_intern_name(SubGhzKeystore* instance, const char* name) {
+    size_t position = 0;
+    if(!subghz_keystore_find_pooled_name(instance, name, &position)) {
+        SubGhzKeystoreNameArray_push_at(instance->names, position, furi_string_alloc_set(name));
+    }
+    return *SubGhzKeystoreNameArray_cget(instance->names, position);
+}
+
+static bool subghz_keystore_name_is_pooled(SubGhzKeystore* instance, FuriString* name) {
+    size_t position = 0;
+    return subghz_keystore_find_pooled_name(instance, furi_string_get_cstr(name), &position) &&
+           *SubGhzKeystoreNameArray_cget(instance->names, position) == name;
+}
+
 void subghz_keystore_free(SubGhzKeystore* instance) {
     furi_assert(instance);
 
+    subghz_keystore_index_reset(instance);
+
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            furi_string_free(manufacture_code->name);
+            // Pooled names are released below, only keys added from outside own their name
+            if(!subghz_keystore_name_is_pooled(instance, manufacture_code->name)) {
+                furi_string_free(manufacture_code->name);
+            }
             manufacture_code->key = 0;
         }
     SubGhzKeyArray_clear(instance->data);
 
+    for
+        M_EACH(name, instance->names, SubGhzKeystoreNameArray_t) {
+            furi_string_free(*name);
+        }
+    SubGhzKeystoreNameArray_clear(instance->names);
+
     free(instance);
 }
 
@@ -63,7 +275,7 @@ static void subghz_keystore_add_key(
     uint64_t key,
     uint16_t type) {
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    manufacture_code->name = furi_string_alloc_set(name);
+    manufacture_code->name = subghz_keystore_intern_name(instance, name);
     manufacture_code->key = key;
     manufacture_code->type = type;
 }
@@ -190,6 +402,239 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
     return result;
 }
 
+static bool subghz_keystore_is_binary(Storage* storage, const char* file_name) {
+    uint32_t magic = 0;
+
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        if(storage_file_read(file, &magic, sizeof(magic)) != sizeof(magic)) {
+            magic = 0;
+        }
+    }
+    storage_file_free(file);
+
+    return magic == SUBGHZ_KEYSTORE_BINARY_MAGIC;
+}
+
+static bool subghz_keystore_binary_check_header(
+    const SubGhzKeystoreBinaryHeader* header,
+    uint64_t file_size) {
+    if(header->magic != SUBGHZ_KEYSTORE_BINARY_MAGIC ||
+       header->version != SUBGHZ_KEYSTORE_BINARY_VERSION) {
+        FURI_LOG_E(TAG, "Type or version mismatch");
+        return false;
+    }
+    if(header->encryption != SubGhzKeystoreEncryptionNone &&
+       header->encryption != SubGhzKeystoreEncryptionAES256) {
+        FURI_LOG_E(TAG, "Unknown encryption");
+        return false;
+    }
+
+    uint64_t data_size =
+        (uint64_t)header->key_count * sizeof(SubGhzKeystoreBinaryRecord) + header->strings_size;
+    if(!header->payload_size || header->payload_size < data_size ||
+       header->payload_size % SUBGHZ_KEYSTORE_BINARY_BLOCK_SIZE != 0 ||
+       header->payload_size != file_size - sizeof(SubGhzKeystoreBinaryHeader) ||
+       (header->key_count && !header->strings_size)) {
+        FURI_LOG_E(TAG, "Malformed file");
+        return false;
+    }
+    if(header->payload_size > memmgr_heap_get_max_free_block()) {
+        FURI_LOG_E(TAG, "Not enough memory");
+        return false;
+    }
+
+    return true;
+}
+
+static bool
+    subghz_keystore_load_binary(SubGhzKeystore* instance, Storage* storage, const char* file_name) {
+    bool result = false;
+    SubGhzKeystoreBinaryHeader header;
+    uint8_t* payload = NULL;
+
+    File* file = storage_file_alloc(storage);
+    do {
+        if(!storage_file_open(file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
+            break;
+        }
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) {
+            FURI_LOG_E(TAG, "Missing or incorrect header");
+            break;
+        }
+        if(!subghz_keystore_binary_check_header(&header, storage_file_size(file))) {
+            break;
+        }
+
+        // Whole payload in one read and, if needed, one decrypt
+        payload = malloc(header.payload_size);
+        if(storage_file_read(file, payload, header.payload_size) != header.payload_size) {
+            FURI_LOG_E(TAG, "Unable to read payload");
+            break;
+        }
+
+        if(header.encryption == SubGhzKeystoreEncryptionAES256) {
+            uint32_t iv[4];
+            memcpy(iv, header.iv, sizeof(iv));
+            subghz_keystore_mess_with_iv((uint8_t*)iv);
+            if(!furi_hal_crypto_enclave_load_key(
+                   SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, (uint8_t*)iv)) {
+                FURI_LOG_E(TAG, "Unable to load decryption key");
+                break;
+            }
+            bool decrypted = furi_hal_crypto_decrypt(payload, payload, header.payload_size);
+            furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+            if(!decrypted) {
+                FURI_LOG_E(TAG, "Decryption failed");
+                break;
+            }
+        }
+
+        const SubGhzKeystoreBinaryRecord* records = (const SubGhzKeystoreBinaryRecord*)payload;
+        const char* strings =
+            (const char*)&payload[header.key_count * sizeof(SubGhzKeystoreBinaryRecord)];
+        if(header.strings_size && strings[header.strings_size - 1] != '\0') {
+            FURI_LOG_E(TAG, "Malformed string table");
+            break;
+        }
+
+        SubGhzKeyArray_reserve(
+            instance->data, SubGhzKeyArray_size(instance->data) + header.key_count);
+        result = true;
+        for(size_t i = 0; i < header.key_count; i++) {
+            if(records[i].name_offset >= header.strings_size) {
+                FURI_LOG_E(TAG, "Malformed record %zu", i);
+                result = false;
+                break;
+            }
+            subghz_keystore_add_key(
+                instance, &strings[records[i].name_offset], records[i].key, records[i].type);
+        }
+    } while(false);
+
+    if(payload) {
+        // Do not leave decrypted keys in heap
+        memset(payload, 0, header.payload_size);
+        free(payload);
+    }
+    storage_file_free(file);
+
+    return result;
+}
+
+bool subghz_keystore_save_binary(SubGhzKeystore* instance, const char* file_name, uint8_t* iv) {
+    furi_assert(instance);
+    bool result = false;
+
+    const size_t key_count = SubGhzKeyArray_size(instance->data);
+    if(!key_count) {
+        FURI_LOG_E(TAG, "Nothing to save");
+        return false;
+    }
+
+    // String table: every pooled name once, in pool order
+    size_t strings_size = 0;
+    for
+        M_EACH(name, instance->names, SubGhzKeystoreNameArray_t) {
+            strings_size += furi_string_size(*name) + 1;
+        }
+    for
+        M_EACH(key, instance->data, SubGhzKeyArray_t) {
+            if(!subghz_keystore_name_is_pooled(instance, key->name)) {
+                strings_size += furi_string_size(key->name) + 1;
+            }
+        }
+
+    SubGhzKeystoreBinaryHeader header = {
+        .magic = SUBGHZ_KEYSTORE_BINARY_MAGIC,
+        .version = SUBGHZ_KEYSTORE_BINARY_VERSION,
+        .encryption = iv ? SubGhzKeystoreEncryptionAES256 : SubGhzKeystoreEncryptionNone,
+        .key_count = key_count,
+        .strings_size = strings_size,
+    };
+    size_t data_size = key_count * sizeof(SubGhzKeystoreBinaryRecord) + strings_size;
+    header.payload_size = (data_size + SUBGHZ_KEYSTORE_BINARY_BLOCK_SIZE - 1) /
+                          SUBGHZ_KEYSTORE_BINARY_BLOCK_SIZE * SUBGHZ_KEYSTORE_BINARY_BLOCK_SIZE;
+    if(iv) memcpy(header.iv, iv, sizeof(header.iv));
+
+    uint8_t* payload = malloc(header.payload_size);
+    memset(payload, 0, header.payload_size);
+    SubGhzKeystoreBinaryRecord* records = (SubGhzKeystoreBinaryRecord*)payload;
+    char* strings = (char*)&payload[key_count * sizeof(SubGhzKeystoreBinaryRecord)];
+
+    // Pooled names go first, so records of pooled keys can refer to them by position
+    const size_t pool_size = SubGhzKeystoreNameArray_size(instance->names);
+    uint32_t* pool_offset = pool_size ? malloc(pool_size * sizeof(uint32_t)) : NULL;
+    size_t strings_cursor = 0;
+    for(size_t i = 0; i < pool_size; i++) {
+        FuriString* name = *SubGhzKeystoreNameArray_cget(instance->names, i);
+        pool_offset[i] = strings_cursor;
+        memcpy(&strings[strings_cursor], furi_string_get_cstr(name), furi_string_size(name) + 1);
+        strings_cursor += furi_string_size(name) + 1;
+    }
+    for(size_t i = 0; i < key_count; i++) {
+        const SubGhzKey* key = SubGhzKeyArray_cget(instance->data, i);
+        size_t position = 0;
+        if(subghz_keystore_find_pooled_name(instance, furi_string_get_cstr(key->name), &position) &&
+           *SubGhzKeystoreNameArray_cget(instance->names, position) == key->name) {
+            records[i].name_offset = pool_offset[position];
+        } else {
+            records[i].name_offset = strings_cursor;
+            memcpy(
+                &strings[strings_cursor],
+                furi_string_get_cstr(key->name),
+                furi_string_size(key->name) + 1);
+            strings_cursor += furi_string_size(key->name) + 1;
+        }
+        records[i].key = key->key;
+        records[i].type = key->type;
+    }
+    free(pool_offset);
+    furi_check(strings_cursor == strings_size);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    do {
+        if(iv) {
+            uint32_t iv_aligned[4];
+            memcpy(iv_aligned, iv, sizeof(iv_aligned));
+            subghz_keystore_mess_with_iv((uint8_t*)iv_aligned);
+            if(!furi_hal_crypto_enclave_load_key(
+                   SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, (uint8_t*)iv_aligned)) {
+                FURI_LOG_E(TAG, "Unable to load encryption key");
+                break;
+            }
+            bool encrypted = furi_hal_crypto_encrypt(payload, payload, header.payload_size);
+            furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+            if(!encrypted) {
+                FURI_LOG_E(TAG, "Encryption failed");
+                break;
+            }
+        }
+
+        if(!storage_file_open(file, file_name, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", file_name);
+            break;
+        }
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header) ||
+           storage_file_write(file, payload, header.payload_size) != header.payload_size) {
+            FURI_LOG_E(TAG, "Unable to write file");
+            break;
+        }
+
+        FURI_LOG_I(TAG, "Compiled %zu keys, %lu bytes", key_count, header.payload_size);
+        result = true;
+    } while(false);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    memset(payload, 0, header.payload_size);
+    free(payload);
+
+    return result;
+}
+
 bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     furi_assert(instance);
     bool result = false;
@@ -206,6 +651,12 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
 
     FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
     do {
+        // Compiled keystore is detected by magic, anything else is parsed as text
+        if(subghz_keystore_is_binary(storage, file_name)) {
+            result = subghz_keystore_load_binary(instance, storage, file_name);
+            break;
+        }
+
         if(!flipper_format_file_open_existing(flipper_format, file_name)) {
             FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
             break;
@@ -246,6 +697,8 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
 
     furi_string_free(filetype);
 
+    subghz_keystore_get_index(instance);
+
     return result;
 }
 
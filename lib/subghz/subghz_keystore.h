@@ -34,6 +34,7 @@ void subghz_keystore_free(SubGhzKeystore* instance);
 
 /** 
  * Loading manufacture key from file
+ * Both text keystore and compiled binary keystore are accepted, format is detected by content
  * @param instance Pointer to a SubGhzKeystore instance
  * @param filename Full path to the file
  */
@@ -47,6 +48,15 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* filename);
  */
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
 
+/** 
+ * Save manufacture keys to compiled binary keystore file
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param filename Full path to the file
+ * @param iv IV, 16 bytes, NULL to save without encryption
+ * @return true On success
+ */
+bool subghz_keystore_save_binary(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
+
 /** 
  * Get array of keys and names manufacture
  * @param instance Pointer to a SubGhzKeystore instance
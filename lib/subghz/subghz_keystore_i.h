@@ -2,8 +2,71 @@
 
 #include <m-array.h>
 
+ARRAY_DEF(SubGhzKeystoreNameArray, FuriString*, M_PTR_OPLIST)
+
+#define SUBGHZ_KEYSTORE_INDEX_NAME_NONE UINT16_MAX
+#define SUBGHZ_KEYSTORE_MATCH_CACHE_SIZE 16
+
+/** Lookup index over SubGhzKeyArray, built at load time */
+typedef struct {
+    size_t key_count; ///< Number of keys the index was built for
+    size_t name_count;
+    const char** names; ///< Interned manufacture names, sorted by strcmp
+    uint16_t* key_name_id; ///< Name id of every key
+    uint16_t* name_key_offset; ///< name_count + 1 offsets into name_key
+    uint16_t* name_key; ///< Key indexes grouped by name id, in keystore order
+} SubGhzKeystoreIndex;
+
+/** Most recently matched key for a serial */
+typedef struct {
+    uint32_t serial;
+    uint16_t key_index;
+    uint8_t variant; ///< Protocol specific learning variant that matched
+    bool valid;
+} SubGhzKeystoreMatch;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    SubGhzKeystoreNameArray_t names; ///< Name pool shared by loaded keys, sorted by string
     const char* mfname;
     uint8_t kl_type;
+
+    SubGhzKeystoreIndex index;
+    SubGhzKeystoreMatch match_cache[SUBGHZ_KEYSTORE_MATCH_CACHE_SIZE];
 };
+
+/**
+ * Get lookup index, rebuild it if keys were added since last build.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @return const SubGhzKeystoreIndex*
+ */
+const SubGhzKeystoreIndex* subghz_keystore_get_index(SubGhzKeystore* instance);
+
+/**
+ * Find interned manufacture name id.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param name Manufacture name
+ * @return name id or SUBGHZ_KEYSTORE_INDEX_NAME_NONE
+ */
+uint16_t subghz_keystore_find_name_id(SubGhzKeystore* instance, const char* name);
+
+/**
+ * Get most recently matched key for a serial.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param serial Remote serial
+ * @return SubGhzKeystoreMatch* or NULL if nothing cached
+ */
+const SubGhzKeystoreMatch* subghz_keystore_match_cache_get(SubGhzKeystore* instance, uint32_t serial);
+
+/**
+ * Remember matched key for a serial.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param serial Remote serial
+ * @param key_index Index of the key in SubGhzKeyArray
+ * @param variant Protocol specific learning variant
+ */
+void subghz_keystore_match_cache_set(
+    SubGhzKeystore* instance,
+    uint32_t serial,
+    size_t key_index,
+    uint8_t variant);
@@ -4,6 +4,8 @@
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_BATCH_SIZE 64
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
@@ -16,7 +18,12 @@ struct SubGhzWorker {
 
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerPairBatchCallback pair_batch_callback;
     void* context;
+
+    LevelDuration rx_buffer[SUBGHZ_WORKER_BATCH_SIZE];
+    LevelDuration batch[SUBGHZ_WORKER_BATCH_SIZE];
+    size_t batch_count;
 };
 
 /** Rx callback timer
@@ -38,21 +45,46 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     if(sizeof(LevelDuration) != ret) instance->overrun = true;
 }
 
+static void subghz_worker_flush_batch(SubGhzWorker* instance) {
+    if(instance->batch_count) {
+        instance->pair_batch_callback(instance->context, instance->batch, instance->batch_count);
+        instance->batch_count = 0;
+    }
+}
+
+static void subghz_worker_pair(SubGhzWorker* instance, bool level, uint32_t duration) {
+    if(instance->pair_batch_callback) {
+        instance->batch[instance->batch_count++] = level_duration_make(level, duration);
+        if(instance->batch_count == SUBGHZ_WORKER_BATCH_SIZE) {
+            subghz_worker_flush_batch(instance);
+        }
+    } else if(instance->pair_callback) {
+        instance->pair_callback(instance->context, level, duration);
+    }
+}
+
 /** Worker callback thread
  * 
+ * Drains up to SUBGHZ_WORKER_BATCH_SIZE pulses per stream buffer receive
+ * and delivers them in one pair_batch_callback call, if it is set.
+ *
  * @param context 
  * @return exit code 
  */
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
+        size_t ret = furi_stream_buffer_receive(
+            instance->stream, instance->rx_buffer, sizeof(instance->rx_buffer), 10);
+        size_t count = ret / sizeof(LevelDuration);
+
+        for(size_t i = 0; i < count; i++) {
+            LevelDuration level_duration = instance->rx_buffer[i];
             if(level_duration_is_reset(level_duration)) {
                 FURI_LOG_E(TAG, "Overrun buffer");
+                // Deliver everything received before the overrun first
+                if(instance->pair_batch_callback) subghz_worker_flush_batch(instance);
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
                 bool level = level_duration_get_level(level_duration);
@@ -63,17 +95,18 @@ static int32_t subghz_worker_thread_callback(void* context) {
                     instance->filter_level_duration.duration += duration;
 
                 } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
+                    subghz_worker_pair(
+                        instance,
+                        instance->filter_level_duration.level,
+                        instance->filter_level_duration.duration);
 
                     instance->filter_level_duration.duration = duration;
                     instance->filter_level_duration.level = level;
                 }
             }
         }
+
+        if(instance->pair_batch_callback) subghz_worker_flush_batch(instance);
     }
 
     return 0;
@@ -115,6 +148,14 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback) {
+    furi_check(instance);
+    furi_check(!instance->running);
+    instance->pair_batch_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_check(instance);
     instance->context = context;
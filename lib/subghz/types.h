@@ -8,6 +8,7 @@
 #include <lib/toolbox/level_duration.h>
 
 #include "environment.h"
+#include "blocks/const.h"
 #include <furi.h>
 #include <furi_hal.h>
 
@@ -78,6 +79,7 @@ typedef SubGhzProtocolStatus (*SubGhzDeserialize)(void* context, FlipperFormat*
 // Decoder specific
 typedef void (*SubGhzDecoderFeed)(void* decoder, bool level, uint32_t duration);
 typedef void (*SubGhzDecoderReset)(void* decoder);
+typedef bool (*SubGhzDecoderInFrame)(void* decoder);
 typedef uint8_t (*SubGhzGetHashData)(void* decoder);
 typedef uint32_t (*SubGhzGetHashDataLong)(void* decoder);
 typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
@@ -99,6 +101,11 @@ typedef struct {
     SubGhzDeserialize deserialize;
 
     SubGhzGetHashDataLong get_hash_data_long;
+
+    // Receiver dispatch hints, optional
+    // Decoder declaring both is only fed pulses longer than te_short - te_delta while idle
+    const SubGhzBlockConst* timing;
+    SubGhzDecoderInFrame in_frame;
 } SubGhzProtocolDecoder;
 
 typedef struct {
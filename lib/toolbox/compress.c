@@ -14,6 +14,9 @@
 #define COMPRESS_ICON_ENCODED_BUFF_SIZE (1024u)
 #define COMPRESS_ICON_DECODED_BUFF_SIZE (1024u)
 
+/** Decoded icon cache slot size, bigger icons are not cached */
+#define COMPRESS_ICON_CACHE_SLOT_SIZE (128u)
+
 typedef struct {
     uint8_t is_compressed;
     uint8_t reserved;
@@ -22,9 +25,20 @@ typedef struct {
 
 _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
+typedef struct {
+    const uint8_t* icon_data; ///< NULL for empty slot
+    uint32_t hash; ///< Hash of compressed data, icon data may be reused for another icon
+    uint32_t last_use;
+} CompressIconCacheEntry;
+
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t decoded_buff[COMPRESS_ICON_DECODED_BUFF_SIZE];
+    size_t cache_slots;
+    uint32_t cache_clock; ///< Incremented on every hit and fill, orders entries for LRU
+    CompressIconCacheEntry* cache_entries;
+    uint8_t* cache_data;
+    CompressIconCacheStats cache_stats;
 };
 
 CompressIcon* compress_icon_alloc(void) {
@@ -42,37 +56,127 @@ CompressIcon* compress_icon_alloc(void) {
 void compress_icon_free(CompressIcon* instance) {
     furi_check(instance);
     heatshrink_decoder_free(instance->decoder);
+    free(instance->cache_entries);
+    free(instance->cache_data);
     free(instance);
 }
 
+void compress_icon_set_cache_size(CompressIcon* instance, size_t cache_size) {
+    furi_check(instance);
+
+    free(instance->cache_entries);
+    free(instance->cache_data);
+    instance->cache_entries = NULL;
+    instance->cache_data = NULL;
+
+    instance->cache_slots = cache_size / COMPRESS_ICON_CACHE_SLOT_SIZE;
+    if(instance->cache_slots) {
+        instance->cache_entries = malloc(instance->cache_slots * sizeof(CompressIconCacheEntry));
+        instance->cache_data = malloc(instance->cache_slots * COMPRESS_ICON_CACHE_SLOT_SIZE);
+    }
+}
+
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+
+    *stats = instance->cache_stats;
+}
+
+static uint32_t compress_icon_hash(const uint8_t* data, size_t size) {
+    // FNV-1a
+    uint32_t hash = 0x811C9DC5UL;
+    while(size--) {
+        hash ^= *data++;
+        hash *= 0x01000193UL;
+    }
+    return hash;
+}
+
+// Entry of icon data or least recently used one to replace
+static size_t compress_icon_cache_find(CompressIcon* instance, const uint8_t* icon_data) {
+    size_t victim = 0;
+    for(size_t i = 0; i < instance->cache_slots; i++) {
+        const CompressIconCacheEntry* entry = &instance->cache_entries[i];
+        if(entry->icon_data == icon_data) return i;
+
+        const CompressIconCacheEntry* victim_entry = &instance->cache_entries[victim];
+        if(!victim_entry->icon_data) continue;
+        if(!entry->icon_data || (int32_t)(entry->last_use - victim_entry->last_use) < 0) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+static size_t compress_icon_decode_int(CompressIcon* instance, const CompressHeader* header) {
+    size_t decoded_size = 0;
+    size_t data_processed = 0;
+    heatshrink_decoder_sink(
+        instance->decoder,
+        (uint8_t*)header + sizeof(CompressHeader),
+        header->compressed_buff_size,
+        &data_processed);
+    while(1) {
+        HSD_poll_res res = heatshrink_decoder_poll(
+            instance->decoder,
+            instance->decoded_buff + decoded_size,
+            sizeof(instance->decoded_buff) - decoded_size,
+            &data_processed);
+        furi_check((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
+        decoded_size += data_processed;
+        if(res != HSDR_POLL_MORE || decoded_size == sizeof(instance->decoded_buff)) {
+            break;
+        }
+    }
+    heatshrink_decoder_reset(instance->decoder);
+    return decoded_size;
+}
+
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff) {
     furi_check(instance);
     furi_check(icon_data);
     furi_check(decoded_buff);
 
     CompressHeader* header = (CompressHeader*)icon_data;
-    if(header->is_compressed) {
-        size_t data_processed = 0;
-        heatshrink_decoder_sink(
-            instance->decoder,
-            (uint8_t*)&icon_data[sizeof(CompressHeader)],
-            header->compressed_buff_size,
-            &data_processed);
-        while(1) {
-            HSD_poll_res res = heatshrink_decoder_poll(
-                instance->decoder,
-                instance->decoded_buff,
-                sizeof(instance->decoded_buff),
-                &data_processed);
-            furi_check((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
-            if(res != HSDR_POLL_MORE) {
-                break;
-            }
-        }
-        heatshrink_decoder_reset(instance->decoder);
-        *decoded_buff = instance->decoded_buff;
-    } else {
+    if(!header->is_compressed) {
         *decoded_buff = (uint8_t*)&icon_data[1];
+        return;
+    }
+
+    if(!instance->cache_slots) {
+        compress_icon_decode_int(instance, header);
+        *decoded_buff = instance->decoded_buff;
+        return;
+    }
+
+    // Hashing compressed data is much cheaper than decoding it
+    uint32_t hash =
+        compress_icon_hash(&icon_data[sizeof(CompressHeader)], header->compressed_buff_size);
+    size_t slot = compress_icon_cache_find(instance, icon_data);
+    CompressIconCacheEntry* entry = &instance->cache_entries[slot];
+    uint8_t* slot_data = &instance->cache_data[slot * COMPRESS_ICON_CACHE_SLOT_SIZE];
+
+    if(entry->icon_data == icon_data && entry->hash == hash) {
+        entry->last_use = ++instance->cache_clock;
+        instance->cache_stats.hits++;
+        *decoded_buff = slot_data;
+        return;
+    }
+
+    instance->cache_stats.misses++;
+    size_t decoded_size = compress_icon_decode_int(instance, header);
+    *decoded_buff = instance->decoded_buff;
+
+    if(decoded_size <= COMPRESS_ICON_CACHE_SLOT_SIZE) {
+        if(entry->icon_data && entry->icon_data != icon_data) instance->cache_stats.evictions++;
+        entry->icon_data = icon_data;
+        entry->hash = hash;
+        entry->last_use = ++instance->cache_clock;
+        memcpy(slot_data, instance->decoded_buff, decoded_size);
+    } else if(entry->icon_data == icon_data) {
+        // Icon data was reused for a bigger icon
+        entry->icon_data = NULL;
     }
 }
 
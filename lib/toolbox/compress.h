@@ -15,6 +15,13 @@ extern "C" {
 /** Compress Icon control structure */
 typedef struct CompressIcon CompressIcon;
 
+/** Decoded icon cache counters */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} CompressIconCacheStats;
+
 /** Initialize icon compressor
  *
  * @return     Compress Icon instance
@@ -27,10 +34,28 @@ CompressIcon* compress_icon_alloc(void);
  */
 void compress_icon_free(CompressIcon* instance);
 
+/** Set size of decoded icon cache
+ *
+ * Decoded icons are cached by icon data pointer, so redrawing the same icon
+ * skips decompression. Cache is disabled by default.
+ *
+ * @param      instance    The Compress Icon instance
+ * @param      cache_size  cache size in bytes, 0 to disable cache
+ */
+void compress_icon_set_cache_size(CompressIcon* instance, size_t cache_size);
+
+/** Get decoded icon cache counters
+ *
+ * @param      instance  The Compress Icon instance
+ * @param      stats     pointer to counters to fill
+ */
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats);
+
 /** Decompress icon
  *
  * @warning    decoded_buff pointer set by this function is valid till next
- *             `compress_icon_decode` or `compress_icon_free` call
+ *             `compress_icon_decode`, `compress_icon_set_cache_size` or
+ *             `compress_icon_free` call
  *
  * @param      instance      The Compress Icon instance
  * @param      icon_data     pointer to icon data
@@ -2,6 +2,9 @@
 #include <m-list.h>
 
 #define MAX_NAME_LEN 254
+// Entries are read from storage in batches, names are packed into the names buffer
+#define DIR_WALK_BATCH_COUNT 16
+#define DIR_WALK_BATCH_NAMES_SIZE 1024
 
 LIST_DEF(DirIndexList, uint32_t);
 
@@ -15,6 +18,12 @@ struct DirWalk {
     void* filter_context;
     const char** recurse_filter;
     size_t recurse_filter_count;
+
+    FileInfo batch_info[DIR_WALK_BATCH_COUNT];
+    char* batch_names;
+    size_t batch_count;
+    size_t batch_index;
+    size_t batch_name_offset;
 };
 
 DirWalk* dir_walk_alloc(Storage* storage) {
@@ -28,6 +37,7 @@ DirWalk* dir_walk_alloc(Storage* storage) {
     dir_walk->filter_cb = NULL;
     dir_walk->recurse_filter = NULL;
     dir_walk->recurse_filter_count = 0;
+    dir_walk->batch_names = malloc(DIR_WALK_BATCH_NAMES_SIZE);
     return dir_walk;
 }
 
@@ -37,6 +47,7 @@ void dir_walk_free(DirWalk* dir_walk) {
     storage_file_free(dir_walk->file);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
+    free(dir_walk->batch_names);
     free(dir_walk);
 }
 
@@ -56,10 +67,36 @@ void dir_walk_set_recurse_filter(DirWalk* dir_walk, const char** array, size_t c
     dir_walk->recurse_filter_count = count;
 }
 
+static void dir_walk_batch_reset(DirWalk* dir_walk) {
+    dir_walk->batch_count = 0;
+    dir_walk->batch_index = 0;
+}
+
+static bool dir_walk_batch_read(DirWalk* dir_walk, FileInfo* fileinfo, const char** name) {
+    if(dir_walk->batch_index == dir_walk->batch_count) {
+        dir_walk->batch_index = 0;
+        dir_walk->batch_name_offset = 0;
+        dir_walk->batch_count = storage_dir_read_batch(
+            dir_walk->file,
+            dir_walk->batch_info,
+            dir_walk->batch_names,
+            DIR_WALK_BATCH_NAMES_SIZE,
+            MAX_NAME_LEN,
+            DIR_WALK_BATCH_COUNT);
+        if(!dir_walk->batch_count) return false;
+    }
+
+    *fileinfo = dir_walk->batch_info[dir_walk->batch_index++];
+    *name = dir_walk->batch_names + dir_walk->batch_name_offset;
+    dir_walk->batch_name_offset += strlen(*name) + 1;
+    return true;
+}
+
 bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_check(dir_walk);
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
+    dir_walk_batch_reset(dir_walk);
     return storage_dir_open(dir_walk->file, path);
 }
 
@@ -74,14 +111,14 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     DirWalkResult result = DirWalkError;
-    char* name = malloc(MAX_NAME_LEN);
+    const char* name = NULL;
     FileInfo info;
     bool end = false;
 
     while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, MAX_NAME_LEN);
+        bool read = dir_walk_batch_read(dir_walk, &info, &name);
 
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
+        if(read) {
             result = DirWalkOK;
             dir_walk->current_index++;
 
@@ -123,6 +160,7 @@ static DirWalkResult
                     // step into
                     DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
                     dir_walk->current_index = 0;
+                    dir_walk_batch_reset(dir_walk);
                     storage_dir_close(dir_walk->file);
                     storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
                 }
@@ -137,6 +175,7 @@ static DirWalkResult
                 uint32_t index;
                 DirIndexList_pop_back(&index, dir_walk->index_list);
                 dir_walk->current_index = 0;
+                dir_walk_batch_reset(dir_walk);
 
                 storage_dir_close(dir_walk->file);
 
@@ -154,7 +193,7 @@ static DirWalkResult
                         break;
                     }
 
-                    if(!storage_dir_read(dir_walk->file, &info, name, MAX_NAME_LEN)) {
+                    if(!dir_walk_batch_read(dir_walk, &info, &name)) {
                         result = DirWalkError;
                         end = true;
                         break;
@@ -169,7 +208,6 @@ static DirWalkResult
         }
     }
 
-    free(name);
     return result;
 }
 
@@ -192,4 +230,5 @@ void dir_walk_close(DirWalk* dir_walk) {
     DirIndexList_reset(dir_walk->index_list);
     furi_string_reset(dir_walk->path);
     dir_walk->current_index = 0;
+    dir_walk_batch_reset(dir_walk);
 }
@@ -8,11 +8,66 @@
 
 #define TAG "KeysDict"
 
+#define KEYS_DICT_CACHE_EXTENSION ".cache"
+#define KEYS_DICT_CACHE_MAGIC (0x4344534BU) // "KSDC"
+#define KEYS_DICT_CACHE_VERSION (2U)
+#define KEYS_DICT_CACHE_BLOCK_KEYS (64U)
+
+#define KEYS_DICT_INDEX_CAPACITY_MIN (64U)
+#define KEYS_DICT_INDEX_EMPTY (UINT64_MAX)
+
+/*
+ * In-memory set of keys for presence checks
+ *
+ * Open addressing with linear probing, kept at most 3/4 full. Slots hold
+ * keys as big-endian integers, KEYS_DICT_INDEX_EMPTY marks a free slot
+ * and a key equal to it is tracked by has_empty_key. Built from the file
+ * on first lookup, dropped when there is not enough memory to hold it.
+ */
+typedef struct {
+    uint64_t* slots;
+    size_t capacity; ///< Power of two
+    size_t count;
+    bool has_empty_key;
+} KeysDictIndex;
+
+/*
+ * Binary cache of a read-only dictionary
+ *
+ * Header followed by total_keys packed keys of key_size bytes, stored next
+ * to the text file. Valid while size and modification time of the text file
+ * match the ones recorded in header. Saves text parsing on every key during
+ * dictionary attacks and the counting pass on open.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t key_size;
+    uint32_t key_count;
+    uint32_t source_mtime;
+    uint64_t source_size;
+} FURI_PACKED KeysDictCacheHeader;
+
+typedef struct {
+    File* file;
+    uint8_t* buffer; ///< KEYS_DICT_CACHE_BLOCK_KEYS keys
+    size_t buffer_keys; ///< Keys loaded into buffer
+    size_t buffer_pos; ///< Next key in buffer
+} KeysDictCache;
+
 struct KeysDict {
     Stream* stream;
+    Storage* storage;
+    FuriString* path;
     size_t key_size;
     size_t key_size_symbols;
     size_t total_keys;
+    bool writable; ///< Read-only dictionaries are reopened for writing on first change
+
+    KeysDictCache cache; ///< Keys are read from cache when file is open
+
+    KeysDictIndex index;
+    bool index_disabled; ///< Index can not be used, fall back to file scan
 };
 
 static inline void keys_dict_add_ending_new_line(KeysDict* instance) {
@@ -52,6 +107,300 @@ static bool keys_dict_read_key_line(KeysDict* instance, FuriString* line, bool*
     return false;
 }
 
+static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, FuriString* key_str) {
+    furi_assert(instance);
+    furi_assert(key_str);
+    furi_assert(key_int);
+
+    furi_string_reset(key_str);
+
+    for(size_t i = 0; i < instance->key_size; i++)
+        furi_string_cat_printf(key_str, "%02X", key_int[i]);
+}
+
+static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
+    furi_assert(instance);
+    furi_assert(key_str);
+    furi_assert(key_int);
+
+    uint8_t key_byte_tmp;
+    char h, l;
+
+    *key_int = 0ULL;
+
+    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
+        h = furi_string_get_char(key_str, i);
+        l = furi_string_get_char(key_str, i + 1);
+
+        args_char_to_hex(h, l, &key_byte_tmp);
+        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
+    }
+}
+
+static inline size_t keys_dict_index_slot(const KeysDictIndex* index, uint64_t key) {
+    // Fibonacci hashing, capacity is a power of two
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (index->capacity - 1);
+}
+
+static bool keys_dict_index_contains(const KeysDictIndex* index, uint64_t key) {
+    if(key == KEYS_DICT_INDEX_EMPTY) return index->has_empty_key;
+
+    for(size_t i = keys_dict_index_slot(index, key);; i = (i + 1) & (index->capacity - 1)) {
+        if(index->slots[i] == key) return true;
+        if(index->slots[i] == KEYS_DICT_INDEX_EMPTY) return false;
+    }
+}
+
+static void keys_dict_index_insert_slot(KeysDictIndex* index, uint64_t key) {
+    if(key == KEYS_DICT_INDEX_EMPTY) {
+        if(!index->has_empty_key) index->count++;
+        index->has_empty_key = true;
+        return;
+    }
+
+    for(size_t i = keys_dict_index_slot(index, key);; i = (i + 1) & (index->capacity - 1)) {
+        if(index->slots[i] == key) return;
+        if(index->slots[i] == KEYS_DICT_INDEX_EMPTY) {
+            index->slots[i] = key;
+            index->count++;
+            return;
+        }
+    }
+}
+
+static void keys_dict_index_reset(KeysDictIndex* index) {
+    free(index->slots);
+    memset(index, 0, sizeof(KeysDictIndex));
+}
+
+static bool keys_dict_index_resize(KeysDictIndex* index, size_t key_count) {
+    size_t capacity = KEYS_DICT_INDEX_CAPACITY_MIN;
+    while(capacity * 3 / 4 <= key_count) capacity *= 2;
+    if(capacity == index->capacity) return true;
+
+    // Leave at least as much heap to everyone else as the table takes
+    size_t size = capacity * sizeof(uint64_t);
+    if(size > memmgr_heap_get_max_free_block() / 2) {
+        FURI_LOG_W(TAG, "Not enough memory for index of %zu keys", key_count);
+        return false;
+    }
+
+    uint64_t* old_slots = index->slots;
+    size_t old_capacity = index->capacity;
+
+    index->slots = malloc(size);
+    memset(index->slots, 0xFF, size);
+    index->capacity = capacity;
+    index->count = index->has_empty_key ? 1 : 0;
+    for(size_t i = 0; i < old_capacity; i++) {
+        if(old_slots[i] != KEYS_DICT_INDEX_EMPTY) keys_dict_index_insert_slot(index, old_slots[i]);
+    }
+    free(old_slots);
+
+    return true;
+}
+
+static void keys_dict_get_cache_path(KeysDict* instance, FuriString* cache_path) {
+    furi_string_printf(
+        cache_path, "%s%s", furi_string_get_cstr(instance->path), KEYS_DICT_CACHE_EXTENSION);
+}
+
+static bool keys_dict_get_source_info(KeysDict* instance, KeysDictCacheHeader* header) {
+    FileInfo file_info;
+    const char* path = furi_string_get_cstr(instance->path);
+
+    if(storage_common_stat(instance->storage, path, &file_info) != FSE_OK) return false;
+    if(storage_common_mtime(instance->storage, path, &header->source_mtime) != FSE_OK)
+        return false;
+
+    header->magic = KEYS_DICT_CACHE_MAGIC;
+    header->version = KEYS_DICT_CACHE_VERSION;
+    header->key_size = instance->key_size;
+    header->source_size = file_info.size;
+
+    return true;
+}
+
+static bool keys_dict_cache_open(KeysDict* instance) {
+    KeysDictCacheHeader expected = {0};
+    KeysDictCacheHeader header = {0};
+    if(!keys_dict_get_source_info(instance, &expected)) return false;
+
+    FuriString* cache_path = furi_string_alloc();
+    keys_dict_get_cache_path(instance, cache_path);
+
+    File* file = storage_file_alloc(instance->storage);
+    bool cache_valid = false;
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(cache_path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        expected.key_count = header.key_count;
+        if(memcmp(&header, &expected, sizeof(header)) != 0) {
+            FURI_LOG_D(TAG, "Cache is outdated");
+            break;
+        }
+        if(storage_file_size(file) !=
+           sizeof(header) + (uint64_t)header.key_count * instance->key_size) {
+            FURI_LOG_W(TAG, "Cache is truncated");
+            break;
+        }
+
+        cache_valid = true;
+    } while(false);
+
+    if(cache_valid) {
+        instance->cache.file = file;
+        instance->cache.buffer = malloc(KEYS_DICT_CACHE_BLOCK_KEYS * instance->key_size);
+        instance->cache.buffer_keys = 0;
+        instance->cache.buffer_pos = 0;
+        instance->total_keys = header.key_count;
+    } else {
+        storage_file_free(file);
+    }
+
+    furi_string_free(cache_path);
+
+    return cache_valid;
+}
+
+static void keys_dict_cache_close(KeysDict* instance, bool remove) {
+    if(instance->cache.file) {
+        storage_file_free(instance->cache.file);
+        free(instance->cache.buffer);
+        memset(&instance->cache, 0, sizeof(KeysDictCache));
+    }
+
+    if(remove) {
+        FuriString* cache_path = furi_string_alloc();
+        keys_dict_get_cache_path(instance, cache_path);
+        storage_simply_remove(instance->storage, furi_string_get_cstr(cache_path));
+        furi_string_free(cache_path);
+    }
+}
+
+static bool keys_dict_cache_rewind(KeysDict* instance) {
+    instance->cache.buffer_keys = 0;
+    instance->cache.buffer_pos = 0;
+    return storage_file_seek(instance->cache.file, sizeof(KeysDictCacheHeader), true);
+}
+
+static bool keys_dict_cache_get_next_key(KeysDict* instance, uint8_t* key) {
+    KeysDictCache* cache = &instance->cache;
+
+    if(cache->buffer_pos == cache->buffer_keys) {
+        size_t bytes_read = storage_file_read(
+            cache->file, cache->buffer, KEYS_DICT_CACHE_BLOCK_KEYS * instance->key_size);
+        cache->buffer_keys = bytes_read / instance->key_size;
+        cache->buffer_pos = 0;
+        if(cache->buffer_keys == 0) return false;
+    }
+
+    memcpy(key, &cache->buffer[cache->buffer_pos * instance->key_size], instance->key_size);
+    cache->buffer_pos++;
+
+    return true;
+}
+
+static bool keys_dict_make_writable(KeysDict* instance) {
+    if(instance->writable) return true;
+
+    const char* path = furi_string_get_cstr(instance->path);
+    size_t position = stream_tell(instance->stream);
+
+    buffered_file_stream_close(instance->stream);
+    instance->writable = buffered_file_stream_open(
+        instance->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+    if(instance->writable) {
+        // Keys are appended after the last line
+        keys_dict_add_ending_new_line(instance);
+    } else {
+        FURI_LOG_E(TAG, "Unable to open for writing");
+        buffered_file_stream_open(instance->stream, path, FSAM_READ, FSOM_OPEN_EXISTING);
+    }
+    stream_seek(instance->stream, position, StreamOffsetFromStart);
+
+    return instance->writable;
+}
+
+static void keys_dict_key_from_int(KeysDict* instance, uint64_t key_int, uint8_t* key) {
+    size_t tmp_len = instance->key_size;
+    while(tmp_len--) {
+        key[tmp_len] = (uint8_t)key_int;
+        key_int >>= 8;
+    }
+}
+
+// Count keys in text file, writing them to a new cache along the way if requested
+static void keys_dict_count_keys(KeysDict* instance, bool create_cache) {
+    KeysDictCacheHeader header = {0};
+    File* cache_file = NULL;
+    uint8_t* buffer = NULL;
+    size_t buffer_keys = 0;
+    bool cache_ok = false;
+
+    FuriString* cache_path = furi_string_alloc();
+    keys_dict_get_cache_path(instance, cache_path);
+
+    if(create_cache && keys_dict_get_source_info(instance, &header)) {
+        cache_file = storage_file_alloc(instance->storage);
+        // Header is written last, a partially written cache never validates
+        KeysDictCacheHeader empty = {0};
+        cache_ok = storage_file_open(
+                       cache_file,
+                       furi_string_get_cstr(cache_path),
+                       FSAM_WRITE,
+                       FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(cache_file, &empty, sizeof(empty)) == sizeof(empty);
+        buffer = malloc(KEYS_DICT_CACHE_BLOCK_KEYS * instance->key_size);
+    }
+
+    FuriString* line = furi_string_alloc();
+    bool is_endfile = false;
+
+    // In this loop we only count the entries in the file
+    // We prefer not to load the whole file in memory for space reasons
+    while(!is_endfile) {
+        bool read_key = keys_dict_read_key_line(instance, line, &is_endfile);
+        if(read_key) {
+            instance->total_keys++;
+
+            if(cache_ok) {
+                uint64_t key_int = 0;
+                keys_dict_str_to_int(instance, line, &key_int);
+                keys_dict_key_from_int(
+                    instance, key_int, &buffer[buffer_keys * instance->key_size]);
+                buffer_keys++;
+            }
+        }
+
+        if(cache_ok && (buffer_keys == KEYS_DICT_CACHE_BLOCK_KEYS || is_endfile)) {
+            size_t size = buffer_keys * instance->key_size;
+            cache_ok = storage_file_write(cache_file, buffer, size) == size;
+            buffer_keys = 0;
+        }
+    }
+    stream_rewind(instance->stream);
+    furi_string_free(line);
+
+    if(cache_file) {
+        header.key_count = instance->total_keys;
+        cache_ok = cache_ok && storage_file_seek(cache_file, 0, true) &&
+                   storage_file_write(cache_file, &header, sizeof(header)) == sizeof(header);
+        storage_file_free(cache_file);
+        free(buffer);
+
+        if(!cache_ok) {
+            FURI_LOG_W(TAG, "Unable to write cache");
+            storage_simply_remove(instance->storage, furi_string_get_cstr(cache_path));
+        }
+    }
+
+    furi_string_free(cache_path);
+}
+
 bool keys_dict_check_presence(const char* path) {
     furi_check(path);
 
@@ -71,7 +420,10 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
     KeysDict* instance = malloc(sizeof(KeysDict));
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
+    instance->storage = storage;
     instance->stream = buffered_file_stream_alloc(storage);
+    instance->path = furi_string_alloc_set(path);
+    memset(&instance->cache, 0, sizeof(KeysDictCache));
 
     FS_OpenMode open_mode = (mode == KeysDictModeOpenAlways) ? FSOM_OPEN_ALWAYS :
                                                                FSOM_OPEN_EXISTING;
@@ -82,32 +434,37 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
 
     instance->total_keys = 0;
 
-    bool file_exists =
-        buffered_file_stream_open(instance->stream, path, FSAM_READ_WRITE, open_mode);
+    memset(&instance->index, 0, sizeof(KeysDictIndex));
+    // Index holds keys as integers, longer keys are always looked up in file
+    instance->index_disabled = key_size > sizeof(uint64_t);
+
+    // Read-only dictionaries are not modified on open, so their cache stays valid
+    instance->writable = (mode == KeysDictModeOpenAlways);
+    bool file_exists = buffered_file_stream_open(
+        instance->stream, path, instance->writable ? FSAM_READ_WRITE : FSAM_READ, open_mode);
 
     if(!file_exists) {
         buffered_file_stream_close(instance->stream);
-    } else {
+    } else if(instance->writable) {
         // Eventually add new line character in the last line to avoid skipping keys
         keys_dict_add_ending_new_line(instance);
     }
 
-    FuriString* line = furi_string_alloc();
+    if(file_exists) {
+        // Only read-only dictionaries are cached, they are not expected to change
+        bool use_cache = (mode == KeysDictModeOpenExisting) &&
+                         (key_size <= sizeof(uint64_t));
 
-    bool is_endfile = false;
-
-    // In this loop we only count the entries in the file
-    // We prefer not to load the whole file in memory for space reasons
-    while(file_exists && !is_endfile) {
-        bool read_key = keys_dict_read_key_line(instance, line, &is_endfile);
-        if(read_key) {
-            instance->total_keys++;
+        if(!use_cache || !keys_dict_cache_open(instance)) {
+            keys_dict_count_keys(instance, use_cache);
+            if(use_cache) keys_dict_cache_open(instance);
         }
     }
-    stream_rewind(instance->stream);
-    FURI_LOG_I(TAG, "Loaded dictionary with %zu keys", instance->total_keys);
-
-    furi_string_free(line);
+    FURI_LOG_I(
+        TAG,
+        "Loaded dictionary with %zu keys%s",
+        instance->total_keys,
+        instance->cache.file ? " from cache" : "");
 
     return instance;
 }
@@ -116,41 +473,53 @@ void keys_dict_free(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    keys_dict_cache_close(instance, false);
     buffered_file_stream_close(instance->stream);
     stream_free(instance->stream);
+    keys_dict_index_reset(&instance->index);
+    furi_string_free(instance->path);
     free(instance);
 
     furi_record_close(RECORD_STORAGE);
 }
 
-static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, FuriString* key_str) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
-
-    furi_string_reset(key_str);
-
-    for(size_t i = 0; i < instance->key_size; i++)
-        furi_string_cat_printf(key_str, "%02X", key_int[i]);
+static uint64_t keys_dict_key_to_int(KeysDict* instance, const uint8_t* key) {
+    uint64_t key_int = 0;
+    for(size_t i = 0; i < instance->key_size; i++) {
+        key_int = (key_int << 8) | key[i];
+    }
+    return key_int;
 }
 
-static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
+static const KeysDictIndex* keys_dict_get_index(KeysDict* instance) {
+    if(instance->index_disabled) return NULL;
+    if(instance->index.slots) return &instance->index;
 
-    uint8_t key_byte_tmp;
-    char h, l;
+    if(!keys_dict_index_resize(&instance->index, instance->total_keys)) {
+        instance->index_disabled = true;
+        return NULL;
+    }
 
-    *key_int = 0ULL;
+    FuriString* line = furi_string_alloc();
+    bool is_endfile = false;
 
-    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
-        h = furi_string_get_char(key_str, i);
-        l = furi_string_get_char(key_str, i + 1);
+    uint32_t actual_pos = stream_tell(instance->stream);
+    stream_rewind(instance->stream);
 
-        args_char_to_hex(h, l, &key_byte_tmp);
-        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
+    while(!is_endfile) {
+        if(keys_dict_read_key_line(instance, line, &is_endfile)) {
+            uint64_t key_int = 0;
+            keys_dict_str_to_int(instance, line, &key_int);
+            keys_dict_index_insert_slot(&instance->index, key_int);
+        }
     }
+
+    stream_seek(instance->stream, actual_pos, StreamOffsetFromStart);
+    furi_string_free(line);
+
+    FURI_LOG_D(TAG, "Indexed %zu keys", instance->index.count);
+
+    return &instance->index;
 }
 
 size_t keys_dict_get_total_keys(KeysDict* instance) {
@@ -163,7 +532,10 @@ bool keys_dict_rewind(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
-    return stream_rewind(instance->stream);
+    bool rewound = stream_rewind(instance->stream);
+    if(instance->cache.file) rewound = keys_dict_cache_rewind(instance) && rewound;
+
+    return rewound;
 }
 
 static bool keys_dict_get_next_key_str(KeysDict* instance, FuriString* key) {
@@ -187,20 +559,18 @@ bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->cache.file) {
+        return keys_dict_cache_get_next_key(instance, key);
+    }
+
     FuriString* temp_key = furi_string_alloc();
 
     bool key_read = keys_dict_get_next_key_str(instance, temp_key);
 
     if(key_read) {
-        size_t tmp_len = key_size;
         uint64_t key_int = 0;
-
         keys_dict_str_to_int(instance, temp_key, &key_int);
-
-        while(tmp_len--) {
-            key[tmp_len] = (uint8_t)key_int;
-            key_int >>= 8;
-        }
+        keys_dict_key_from_int(instance, key_int, key);
     }
 
     furi_string_free(temp_key);
@@ -239,6 +609,11 @@ bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    const KeysDictIndex* index = keys_dict_get_index(instance);
+    if(index) {
+        return keys_dict_index_contains(index, keys_dict_key_to_int(instance, key));
+    }
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
@@ -276,11 +651,25 @@ bool keys_dict_add_key(KeysDict* instance, const uint8_t* key, size_t key_size)
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(!keys_dict_make_writable(instance)) return false;
+
+    // Cache no longer matches the file once it is modified
+    keys_dict_cache_close(instance, true);
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
     bool key_added = keys_dict_add_key_str(instance, temp_key);
 
+    if(key_added && instance->index.slots) {
+        if(keys_dict_index_resize(&instance->index, instance->total_keys)) {
+            keys_dict_index_insert_slot(&instance->index, keys_dict_key_to_int(instance, key));
+        } else {
+            keys_dict_index_reset(&instance->index);
+            instance->index_disabled = true;
+        }
+    }
+
     FURI_LOG_I(TAG, "Added key %s", furi_string_get_cstr(temp_key));
 
     furi_string_free(temp_key);
@@ -296,6 +685,9 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
 
     bool key_removed = false;
 
+    if(!keys_dict_make_writable(instance)) return false;
+    keys_dict_cache_close(instance, true);
+
     uint8_t* temp_key = malloc(key_size);
 
     stream_rewind(instance->stream);
@@ -315,6 +707,9 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
         }
     }
 
+    // File may hold the same key more than once, index is rebuilt on next lookup
+    if(key_removed) keys_dict_index_reset(&instance->index);
+
     FuriString* tmp = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, tmp);
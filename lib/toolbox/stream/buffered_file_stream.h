@@ -13,6 +13,15 @@ extern "C" {
  */
 Stream* buffered_file_stream_alloc(Storage* storage);
 
+/**
+ * Allocate a file stream with buffered read operations and custom cache size
+ * Sequential reads are done in growing chunks up to cache_size bytes
+ * @param storage pointer to storage API instance
+ * @param cache_size read-ahead limit in bytes
+ * @return Stream*
+ */
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t cache_size);
+
 /**
  * Opens an existing file or creates a new one.
  * @param stream pointer to file stream object.
@@ -124,6 +124,13 @@ size_t stream_read(Stream* stream, uint8_t* data, size_t size) {
     return stream->vtable->read(stream, data, size);
 }
 
+size_t stream_peek(Stream* stream, const uint8_t** data) {
+    furi_check(stream);
+    furi_check(data);
+    if(!stream->vtable->peek) return 0;
+    return stream->vtable->peek(stream, data);
+}
+
 bool stream_delete_and_insert(
     Stream* stream,
     size_t delete_size,
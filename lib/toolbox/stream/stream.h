@@ -95,6 +95,17 @@ size_t stream_write(Stream* stream, const uint8_t* data, size_t size);
  */
 size_t stream_read(Stream* stream, uint8_t* data, size_t count);
 
+/**
+ * Get data at the RW pointer without copying it.
+ * RW pointer is not moved, use stream_seek to consume data.
+ * Data is valid until the next operation on the stream.
+ * @param stream Stream instance
+ * @param data pointer to store data pointer
+ * @return size_t how many bytes are available,
+ * 0 at the end of the stream or if the stream does not support peeking
+ */
+size_t stream_peek(Stream* stream, const uint8_t** data);
+
 /**
  * Delete N chars from the stream and write data by calling write_callback(context)
  * @param stream Stream instance
@@ -1,29 +1,48 @@
 #include "stream_cache.h"
 
-#define STREAM_CACHE_MAX_SIZE 1024U
+#define STREAM_CACHE_MIN_SIZE 1024U
+// Bytes of previous data kept on sequential refill, covers short seeks back done by parsers
+#define STREAM_CACHE_KEEP_SIZE 64U
 
 struct StreamCache {
-    uint8_t data[STREAM_CACHE_MAX_SIZE];
+    uint8_t* data;
+    size_t capacity;
+    size_t max_size; ///< Read-ahead limit
+    size_t fill_size; ///< Size of the next read, grows while access is sequential
     size_t data_size;
     size_t position;
 };
 
 StreamCache* stream_cache_alloc(void) {
+    return stream_cache_alloc_ex(STREAM_CACHE_DEFAULT_SIZE);
+}
+
+StreamCache* stream_cache_alloc_ex(size_t max_size) {
+    furi_check(max_size > 0);
+
     StreamCache* cache = malloc(sizeof(StreamCache));
+    cache->max_size = max_size;
+    cache->fill_size = MIN(max_size, STREAM_CACHE_MIN_SIZE);
+    cache->capacity = cache->fill_size + STREAM_CACHE_KEEP_SIZE;
+    cache->data = malloc(cache->capacity);
     cache->data_size = 0;
     cache->position = 0;
     return cache;
 }
+
 void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
     cache->data_size = 0;
     cache->position = 0;
+    free(cache->data);
     free(cache);
 }
 
 void stream_cache_drop(StreamCache* cache) {
     cache->data_size = 0;
     cache->position = 0;
+    // Access pattern is unknown after a seek, start with small reads again
+    cache->fill_size = MIN(cache->max_size, STREAM_CACHE_MIN_SIZE);
 }
 
 bool stream_cache_at_end(StreamCache* cache) {
@@ -40,9 +59,23 @@ size_t stream_cache_pos(StreamCache* cache) {
 }
 
 size_t stream_cache_fill(StreamCache* cache, Stream* stream) {
-    const size_t size_read = stream_read(stream, cache->data, STREAM_CACHE_MAX_SIZE);
-    cache->data_size = size_read;
-    cache->position = 0;
+    size_t keep_size = 0;
+
+    // Cached data was read to the end without seeking away: access is sequential
+    if(cache->data_size > 0 && cache->position == cache->data_size) {
+        cache->fill_size = MIN(cache->fill_size * 2, cache->max_size);
+        keep_size = MIN(cache->data_size, STREAM_CACHE_KEEP_SIZE);
+    }
+
+    if(keep_size + cache->fill_size > cache->capacity) {
+        cache->capacity = cache->max_size + STREAM_CACHE_KEEP_SIZE;
+        cache->data = realloc(cache->data, cache->capacity); //-V701
+    }
+
+    memmove(cache->data, cache->data + cache->data_size - keep_size, keep_size);
+    const size_t size_read = stream_read(stream, cache->data + keep_size, cache->fill_size);
+    cache->data_size = keep_size + size_read;
+    cache->position = keep_size;
     return size_read;
 }
 
@@ -64,9 +97,15 @@ size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size) {
     return size_read;
 }
 
+size_t stream_cache_peek(StreamCache* cache, const uint8_t** data) {
+    furi_assert(cache->data_size >= cache->position);
+    *data = cache->data + cache->position;
+    return cache->data_size - cache->position;
+}
+
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size) {
     furi_assert(cache->data_size >= cache->position);
-    const size_t size_written = MIN(size, STREAM_CACHE_MAX_SIZE - cache->position);
+    const size_t size_written = MIN(size, cache->capacity - cache->position);
     if(size_written > 0) {
         memcpy(cache->data + cache->position, data, size_written);
         cache->position += size_written;
@@ -6,14 +6,25 @@
 extern "C" {
 #endif
 
+/** Default read-ahead limit */
+#define STREAM_CACHE_DEFAULT_SIZE 4096U
+
 typedef struct StreamCache StreamCache;
 
 /**
- * Allocate stream cache.
+ * Allocate stream cache with default read-ahead limit.
  * @return StreamCache* pointer to a StreamCache instance
  */
 StreamCache* stream_cache_alloc(void);
 
+/**
+ * Allocate stream cache.
+ * Reads start at 1 KiB and double on every sequential refill up to max_size.
+ * @param max_size Read-ahead limit in bytes
+ * @return StreamCache* pointer to a StreamCache instance
+ */
+StreamCache* stream_cache_alloc_ex(size_t max_size);
+
 /**
  * Free stream cache.
  * @param cache Pointer to a StreamCache instance
@@ -72,6 +83,14 @@ bool stream_cache_flush(StreamCache* cache, Stream* stream);
  */
 size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size);
 
+/**
+ * Get cached data at the internal cursor without advancing it.
+ * @param cache Pointer to a StreamCache instance.
+ * @param data Pointer to store data pointer.
+ * @return Size of data after the cursor.
+ */
+size_t stream_cache_peek(StreamCache* cache, const uint8_t** data);
+
 /**
  * Write to cached data and advance the internal cursor.
  * @param cache Pointer to a StreamCache instance.
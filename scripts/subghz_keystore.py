@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+
+import struct
+
+from flipper.app import App
+
+KEYSTORE_FILE_TYPE = "Flipper SubGhz Keystore File"
+KEYSTORE_FILE_VERSION = 0
+
+BINARY_MAGIC = 0x424B4753  # "SGKB"
+BINARY_VERSION = 1
+BINARY_BLOCK_SIZE = 16
+ENCRYPTION_NONE = 0
+
+# magic, version, encryption, iv, key_count, strings_size, payload_size
+HEADER_FORMAT = "<IHH16sIII"
+# key, name_offset, type, reserved
+RECORD_FORMAT = "<QIHH"
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_compile = self.subparsers.add_parser(
+            "compile", help="Compile decrypted keystore to binary keystore"
+        )
+        self.parser_compile.add_argument("source", type=str)
+        self.parser_compile.add_argument("destination", type=str)
+        self.parser_compile.set_defaults(func=self.compile)
+
+        self.parser_dump = self.subparsers.add_parser(
+            "dump", help="Print unencrypted binary keystore as text"
+        )
+        self.parser_dump.add_argument("filename", type=str)
+        self.parser_dump.set_defaults(func=self.dump)
+
+    def _load_text(self, filename):
+        keys = []
+        header = {}
+        with open(filename, "r", encoding="ascii") as f:
+            lines = [line.strip() for line in f.read().splitlines()]
+        for line in lines:
+            if not line or line.startswith("#"):
+                continue
+            # Header lines are "Key: value", key lines are "KEY:TYPE:NAME"
+            if ": " in line and len(header) < 3:
+                name, value = line.split(": ", 1)
+                header[name] = value
+                continue
+            key, key_type, name = line.split(":", 2)
+            keys.append((int(key, 16), int(key_type), name))
+
+        if (
+            header.get("Filetype") != KEYSTORE_FILE_TYPE
+            or int(header.get("Version", -1)) != KEYSTORE_FILE_VERSION
+        ):
+            raise Exception(f"Incorrect file type or version: {header}")
+        if int(header.get("Encryption", -1)) != ENCRYPTION_NONE:
+            raise Exception("Encrypted keystores can only be compiled on device")
+        return keys
+
+    def compile(self):
+        keys = self._load_text(self.args.source)
+
+        strings = bytearray()
+        offsets = {}
+        for _, _, name in keys:
+            if name not in offsets:
+                offsets[name] = len(strings)
+                strings += name.encode("ascii") + b"\0"
+
+        payload = bytearray()
+        for key, key_type, name in keys:
+            payload += struct.pack(RECORD_FORMAT, key, offsets[name], key_type, 0)
+        payload += strings
+        payload += b"\0" * (-len(payload) % BINARY_BLOCK_SIZE)
+
+        header = struct.pack(
+            HEADER_FORMAT,
+            BINARY_MAGIC,
+            BINARY_VERSION,
+            ENCRYPTION_NONE,
+            b"\0" * 16,
+            len(keys),
+            len(strings),
+            len(payload),
+        )
+        with open(self.args.destination, "wb") as f:
+            f.write(header)
+            f.write(payload)
+
+        self.logger.info(
+            f"Compiled {len(keys)} keys, {len(offsets)} names, {len(payload)} bytes"
+        )
+        return 0
+
+    def dump(self):
+        with open(self.args.filename, "rb") as f:
+            data = f.read()
+        header_size = struct.calcsize(HEADER_FORMAT)
+        (
+            magic,
+            version,
+            encryption,
+            _,
+            key_count,
+            strings_size,
+            payload_size,
+        ) = struct.unpack_from(HEADER_FORMAT, data)
+        if magic != BINARY_MAGIC or version != BINARY_VERSION:
+            self.logger.error("Not a binary keystore")
+            return 1
+        if encryption != ENCRYPTION_NONE:
+            self.logger.error("Encrypted binary keystore can only be read on device")
+            return 1
+
+        record_size = struct.calcsize(RECORD_FORMAT)
+        strings_start = header_size + key_count * record_size
+        strings = data[strings_start : strings_start + strings_size]
+        for i in range(key_count):
+            key, name_offset, key_type, _ = struct.unpack_from(
+                RECORD_FORMAT, data, header_size + i * record_size
+            )
+            name = strings[name_offset : strings.index(b"\0", name_offset)]
+            print(f"{key:016X}:{key_type}:{name.decode('ascii')}")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
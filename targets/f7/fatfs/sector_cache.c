@@ -6,51 +6,285 @@
 #include <furi.h>
 #include <furi_hal_memory.h>
 
+#define TAG "SectorCache"
+
 #define SECTOR_SIZE 512
-#define N_SECTORS 8
+#define N_SECTORS (SECTOR_CACHE_SETS * SECTOR_CACHE_WAYS)
+
+#define SECTOR_FLAG_VALID (1 << 0)
+#define SECTOR_FLAG_DIRTY (1 << 1)
+#define SECTOR_FLAG_METADATA (1 << 2)
+
+typedef struct {
+    uint32_t sector;
+    uint32_t last_use;
+    uint8_t flags;
+} SectorCacheEntry;
 
 typedef struct {
-    uint32_t itr;
-    uint32_t sectors[N_SECTORS];
+    uint32_t clock; ///< Incremented on every access, orders entries for LRU
+    uint32_t dirty_count;
+    bool write_back_active; ///< Device write of a dirty sector is in progress
+    bool invalidate_pending; ///< Invalidation requested during write-back
+    SectorCacheHint hint;
+    SectorCacheWriteCallback write_callback;
+    SectorCacheStats stats;
+    SectorCacheEntry entries[N_SECTORS];
     uint8_t sector_data[N_SECTORS][SECTOR_SIZE];
 } SectorCache;
 
 static SectorCache* cache = NULL;
 
+static inline size_t sector_cache_set_start(uint32_t n_sector) {
+    return (n_sector % SECTOR_CACHE_SETS) * SECTOR_CACHE_WAYS;
+}
+
+static SectorCacheEntry* sector_cache_find(uint32_t n_sector) {
+    size_t start = sector_cache_set_start(n_sector);
+    for(size_t i = start; i < start + SECTOR_CACHE_WAYS; i++) {
+        if((cache->entries[i].flags & SECTOR_FLAG_VALID) && cache->entries[i].sector == n_sector) {
+            return &cache->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static inline uint8_t* sector_cache_data(SectorCacheEntry* entry) {
+    return cache->sector_data[entry - cache->entries];
+}
+
+static void sector_cache_touch(SectorCacheEntry* entry, SectorCacheHint hint) {
+    entry->last_use = ++cache->clock;
+    if(hint != SectorCacheHintData) entry->flags |= SECTOR_FLAG_METADATA;
+}
+
+static void sector_cache_drop_clean(void) {
+    // Dirty sectors are the only copy of their data, keep them
+    for(size_t i = 0; i < N_SECTORS; i++) {
+        if(!(cache->entries[i].flags & SECTOR_FLAG_DIRTY)) {
+            cache->entries[i].flags = 0;
+        }
+    }
+}
+
+static bool sector_cache_write_entry(SectorCacheEntry* entry) {
+    if(!cache->write_callback) return false;
+
+    // Device driver may reinit the card and invalidate cache from the callback
+    cache->write_back_active = true;
+    bool written = cache->write_callback(entry->sector, sector_cache_data(entry));
+    cache->write_back_active = false;
+
+    if(cache->invalidate_pending) {
+        cache->invalidate_pending = false;
+        sector_cache_drop_clean();
+    }
+    if(!written) return false;
+
+    entry->flags &= ~SECTOR_FLAG_DIRTY;
+    cache->dirty_count--;
+    cache->stats.write_backs++;
+    return true;
+}
+
+static void sector_cache_drop_entry(SectorCacheEntry* entry) {
+    if(entry->flags & SECTOR_FLAG_DIRTY) cache->dirty_count--;
+    entry->flags = 0;
+}
+
+// Free entry in set, evicting least recently used data sector first
+static SectorCacheEntry* sector_cache_evict(uint32_t n_sector, SectorCacheHint hint) {
+    size_t start = sector_cache_set_start(n_sector);
+    SectorCacheEntry* victim = NULL;
+
+    for(size_t i = start; i < start + SECTOR_CACHE_WAYS; i++) {
+        SectorCacheEntry* entry = &cache->entries[i];
+        if(!(entry->flags & SECTOR_FLAG_VALID)) return entry;
+
+        // Data never evicts metadata
+        bool is_metadata = entry->flags & SECTOR_FLAG_METADATA;
+        if(hint == SectorCacheHintData && is_metadata) continue;
+
+        if(!victim) {
+            victim = entry;
+            continue;
+        }
+
+        // Prefer data over metadata, clean over dirty, then least recently used
+        bool victim_metadata = victim->flags & SECTOR_FLAG_METADATA;
+        bool victim_dirty = victim->flags & SECTOR_FLAG_DIRTY;
+        bool is_dirty = entry->flags & SECTOR_FLAG_DIRTY;
+        if(is_metadata != victim_metadata) {
+            if(!is_metadata) victim = entry;
+        } else if(is_dirty != victim_dirty) {
+            if(!is_dirty) victim = entry;
+        } else if((int32_t)(entry->last_use - victim->last_use) < 0) {
+            victim = entry;
+        }
+    }
+
+    if(victim) {
+        if((victim->flags & SECTOR_FLAG_DIRTY) && !sector_cache_write_entry(victim)) {
+            return NULL;
+        }
+        victim->flags = 0;
+        cache->stats.evictions++;
+    }
+
+    return victim;
+}
+
 void sector_cache_init(void) {
     if(cache == NULL) {
         cache = memmgr_aux_pool_alloc(sizeof(SectorCache));
+        if(cache != NULL) {
+            memset(cache, 0, sizeof(SectorCache));
+        }
+        return;
     }
 
-    if(cache != NULL) {
-        memset(cache, 0, sizeof(SectorCache));
+    // Entries must not change under write-back in progress, drop them after it
+    if(cache->write_back_active) {
+        cache->invalidate_pending = true;
+        return;
     }
+
+    sector_cache_drop_clean();
 }
 
-uint8_t* sector_cache_get(uint32_t n_sector) {
-    if(cache != NULL && n_sector != 0) {
-        for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-            if(cache->sectors[sector_i] == n_sector) {
-                return cache->sector_data[sector_i];
-            }
-        }
+void sector_cache_reset(void) {
+    if(cache == NULL) return;
+
+    if(cache->dirty_count) {
+        FURI_LOG_W(TAG, "Dropping %lu dirty sectors", cache->dirty_count);
+    }
+    memset(cache->entries, 0, sizeof(cache->entries));
+    cache->dirty_count = 0;
+    cache->hint = SectorCacheHintData;
+}
+
+void sector_cache_set_write_callback(SectorCacheWriteCallback callback) {
+    if(cache == NULL) return;
+    cache->write_callback = callback;
+}
+
+void sector_cache_set_hint(SectorCacheHint hint) {
+    if(cache == NULL) return;
+    cache->hint = hint;
+}
+
+SectorCacheHint sector_cache_take_hint(void) {
+    if(cache == NULL) return SectorCacheHintData;
+    SectorCacheHint hint = cache->hint;
+    cache->hint = SectorCacheHintData;
+    return hint;
+}
+
+uint8_t* sector_cache_get(uint32_t n_sector, SectorCacheHint hint) {
+    if(cache == NULL) return NULL;
+
+    SectorCacheEntry* entry = sector_cache_find(n_sector);
+    if(entry) {
+        sector_cache_touch(entry, hint);
+        cache->stats.hits++;
+        return sector_cache_data(entry);
     }
+
+    cache->stats.misses++;
     return NULL;
 }
 
-void sector_cache_put(uint32_t n_sector, uint8_t* data) {
+void sector_cache_put(uint32_t n_sector, const uint8_t* data, SectorCacheHint hint) {
     if(cache == NULL) return;
-    cache->sectors[cache->itr % N_SECTORS] = n_sector;
-    memcpy(cache->sector_data[cache->itr % N_SECTORS], data, SECTOR_SIZE);
-    cache->itr++;
+
+    SectorCacheEntry* entry = sector_cache_find(n_sector);
+    if(entry) {
+        // Device content is older than dirty one
+        if(entry->flags & SECTOR_FLAG_DIRTY) return;
+    } else {
+        entry = sector_cache_evict(n_sector, hint);
+        if(!entry) return;
+        entry->sector = n_sector;
+        entry->flags = SECTOR_FLAG_VALID;
+    }
+
+    memcpy(sector_cache_data(entry), data, SECTOR_SIZE);
+    sector_cache_touch(entry, hint);
+}
+
+bool sector_cache_write(uint32_t n_sector, const uint8_t* data, SectorCacheHint hint) {
+    if(cache == NULL) return false;
+
+    SectorCacheEntry* entry = sector_cache_find(n_sector);
+    if(!SECTOR_CACHE_WRITE_BACK || hint != SectorCacheHintFat || !cache->write_callback) {
+        if(entry) sector_cache_drop_entry(entry);
+        return false;
+    }
+
+    if(!entry) {
+        entry = sector_cache_evict(n_sector, hint);
+        if(!entry) return false;
+        entry->sector = n_sector;
+        entry->flags = SECTOR_FLAG_VALID;
+    }
+
+    if(!(entry->flags & SECTOR_FLAG_DIRTY)) {
+        entry->flags |= SECTOR_FLAG_DIRTY;
+        cache->dirty_count++;
+    }
+    memcpy(sector_cache_data(entry), data, SECTOR_SIZE);
+    sector_cache_touch(entry, hint);
+
+    return true;
+}
+
+void sector_cache_apply_dirty(uint32_t start_sector, uint32_t count, uint8_t* data) {
+    if(cache == NULL || cache->dirty_count == 0) return;
+
+    for(size_t i = 0; i < N_SECTORS; i++) {
+        SectorCacheEntry* entry = &cache->entries[i];
+        if((entry->flags & SECTOR_FLAG_DIRTY) && (entry->sector - start_sector) < count) {
+            memcpy(
+                &data[(entry->sector - start_sector) * SECTOR_SIZE],
+                sector_cache_data(entry),
+                SECTOR_SIZE);
+        }
+    }
 }
 
 void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
     if(cache == NULL) return;
-    for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-        if((cache->sectors[sector_i] >= start_sector) &&
-           (cache->sectors[sector_i] <= end_sector)) {
-            cache->sectors[sector_i] = 0;
+    for(size_t i = 0; i < N_SECTORS; ++i) {
+        SectorCacheEntry* entry = &cache->entries[i];
+        if((entry->flags & SECTOR_FLAG_VALID) && (entry->sector >= start_sector) &&
+           (entry->sector <= end_sector)) {
+            sector_cache_drop_entry(entry);
+        }
+    }
+}
+
+bool sector_cache_flush(void) {
+    if(cache == NULL) return true;
+
+    bool result = true;
+    for(size_t i = 0; i < N_SECTORS && cache->dirty_count; i++) {
+        SectorCacheEntry* entry = &cache->entries[i];
+        if(entry->flags & SECTOR_FLAG_DIRTY) {
+            result &= sector_cache_write_entry(entry);
         }
     }
-}
\ No newline at end of file
+
+    return result;
+}
+
+void sector_cache_get_stats(SectorCacheStats* stats) {
+    furi_check(stats);
+
+    if(cache == NULL) {
+        memset(stats, 0, sizeof(SectorCacheStats));
+        return;
+    }
+
+    *stats = cache->stats;
+    stats->dirty = cache->dirty_count;
+}
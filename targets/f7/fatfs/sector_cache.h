@@ -1,28 +1,112 @@
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Number of sets, sector n goes to set n % SECTOR_CACHE_SETS */
+#ifndef SECTOR_CACHE_SETS
+#define SECTOR_CACHE_SETS 4
+#endif
+
+/** Number of sectors in each set */
+#ifndef SECTOR_CACHE_WAYS
+#define SECTOR_CACHE_WAYS 4
+#endif
+
+/** Keep FAT updates in cache until flush or eviction */
+#ifndef SECTOR_CACHE_WRITE_BACK
+#define SECTOR_CACHE_WRITE_BACK 1
+#endif
+
+/** Kind of sector, metadata is evicted only by other metadata */
+typedef enum {
+    SectorCacheHintData,
+    SectorCacheHintMetadata,
+    SectorCacheHintFat,
+} SectorCacheHint;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t write_backs;
+    uint32_t dirty;
+} SectorCacheStats;
+
+/**
+ * @brief Write sector to the device, used for write-back
+ * @param n_sector Sector number
+ * @param data Pointer to sector data
+ * @return true on success
+ */
+typedef bool (*SectorCacheWriteCallback)(uint32_t n_sector, const uint8_t* data);
+
 /**
  * @brief Init sector cache system
+ * Invalidates clean sectors, dirty sectors are kept until flushed
+ * Called from write callback, invalidation is deferred until write-back is done
  */
 void sector_cache_init(void);
 
+/**
+ * @brief Drop all sectors including dirty ones, for a newly mounted volume
+ */
+void sector_cache_reset(void);
+
+/**
+ * @brief Set device write callback for write-back
+ * @param callback Write callback
+ */
+void sector_cache_set_write_callback(SectorCacheWriteCallback callback);
+
+/**
+ * @brief Set kind of the next single sector transfer
+ * @param hint Sector kind
+ */
+void sector_cache_set_hint(SectorCacheHint hint);
+
+/**
+ * @brief Get and clear kind of the current transfer
+ * @return Sector kind set by sector_cache_set_hint or SectorCacheHintData
+ */
+SectorCacheHint sector_cache_take_hint(void);
+
 /**
  * @brief Get sector data from cache
  * @param n_sector Sector number
+ * @param hint Sector kind
  * @return Pointer to sector data or NULL if not found
  */
-uint8_t* sector_cache_get(uint32_t n_sector);
+uint8_t* sector_cache_get(uint32_t n_sector, SectorCacheHint hint);
 
 /**
  * @brief Put sector data to cache
  * @param n_sector Sector number
  * @param data Pointer to sector data
+ * @param hint Sector kind
+ */
+void sector_cache_put(uint32_t n_sector, const uint8_t* data, SectorCacheHint hint);
+
+/**
+ * @brief Store written sector in cache without writing it to the device
+ * Only FAT sectors are stored, and only if write-back is enabled
+ * @param n_sector Sector number
+ * @param data Pointer to sector data
+ * @param hint Sector kind
+ * @return true if sector was stored, false if it must be written to the device
  */
-void sector_cache_put(uint32_t n_sector, uint8_t* data);
+bool sector_cache_write(uint32_t n_sector, const uint8_t* data, SectorCacheHint hint);
+
+/**
+ * @brief Copy dirty sectors of given range over data read from the device
+ * @param start_sector Start sector number
+ * @param count Number of sectors in data
+ * @param data Pointer to data of count sectors
+ */
+void sector_cache_apply_dirty(uint32_t start_sector, uint32_t count, uint8_t* data);
 
 /**
  * @brief Invalidate sector cache for given range
@@ -31,6 +115,18 @@ void sector_cache_put(uint32_t n_sector, uint8_t* data);
  */
 void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector);
 
+/**
+ * @brief Write all dirty sectors to the device
+ * @return true on success
+ */
+bool sector_cache_flush(void);
+
+/**
+ * @brief Get cache counters
+ * @param stats Pointer to stats to fill
+ */
+void sector_cache_get_stats(SectorCacheStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,11 @@ Diskio_drvTypeDef sd_fatfs_driver = {
     driver_ioctl,
 };
 
+/* Identity of the card sector cache holds sectors of */
+static bool driver_card_known = false;
+static uint8_t driver_card_manufacturer_id;
+static uint32_t driver_card_serial_number;
+
 /**
   * @brief  Initializes a Drive
   * @param  pdrv: Physical drive number (0..)
@@ -24,6 +29,23 @@ Diskio_drvTypeDef sd_fatfs_driver = {
   */
 static DSTATUS driver_initialize(BYTE pdrv) {
     UNUSED(pdrv);
+    FuriHalSdInfo sd_info;
+    if(furi_hal_sd_info(&sd_info) != FuriStatusOk) return STA_NOINIT;
+
+    bool same_card = driver_card_known &&
+                     sd_info.manufacturer_id == driver_card_manufacturer_id &&
+                     sd_info.product_serial_number == driver_card_serial_number;
+    if(same_card) {
+        // Remount after a transient error, dirty sectors still belong to this card
+        sector_cache_flush();
+    } else {
+        // Writing sectors of the previous card would corrupt this one
+        sector_cache_reset();
+        driver_card_manufacturer_id = sd_info.manufacturer_id;
+        driver_card_serial_number = sd_info.product_serial_number;
+        driver_card_known = true;
+    }
+
     return RES_OK;
 }
 
@@ -81,13 +103,23 @@ static DRESULT driver_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
     DRESULT res = RES_ERROR;
     FuriHalSdInfo sd_info;
 
+    /* Sector kind hint comes before every window transfer, keep it cheap */
+    if(cmd == CTRL_HINT) {
+        BYTE hint = *(BYTE*)buff;
+        sector_cache_set_hint(
+            hint == HINT_FAT  ? SectorCacheHintFat :
+            hint == HINT_META ? SectorCacheHintMetadata :
+                                SectorCacheHintData);
+        return RES_OK;
+    }
+
     DSTATUS status = driver_status(pdrv);
     if(status & STA_NOINIT) return RES_NOTRDY;
 
     switch(cmd) {
     /* Make sure that no pending write process */
     case CTRL_SYNC:
-        res = RES_OK;
+        res = sector_cache_flush() ? RES_OK : RES_ERROR;
         break;
 
     /* Get number of sectors on the disk (DWORD) */
@@ -816,8 +816,8 @@ static FuriStatus sd_spi_get_card_state(void) {
     return FuriStatusError;
 }
 
-static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
-    uint8_t* cached_data = sector_cache_get(address);
+static inline bool sd_cache_get(uint32_t address, uint32_t* data, SectorCacheHint hint) {
+    uint8_t* cached_data = sector_cache_get(address, hint);
     if(cached_data) {
         memcpy(data, cached_data, SD_BLOCK_SIZE);
         return true;
@@ -825,8 +825,8 @@ static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
     return false;
 }
 
-static inline void sd_cache_put(uint32_t address, uint32_t* data) {
-    sector_cache_put(address, (uint8_t*)data);
+static inline void sd_cache_put(uint32_t address, const uint32_t* data, SectorCacheHint hint) {
+    sector_cache_put(address, (const uint8_t*)data, hint);
 }
 
 static inline void sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
@@ -891,6 +891,35 @@ static FuriStatus sd_device_write(const uint32_t* buff, uint32_t sector, uint32_
     return status;
 }
 
+static FuriStatus
+    sd_device_write_with_retry(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = sd_device_write(buff, sector, count);
+
+    if(status != FuriStatusOk) {
+        uint8_t counter = furi_hal_sd_max_mount_retry_count();
+
+        while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
+            if((counter % 2) == 0) {
+                // power reset sd card
+                status = furi_hal_sd_init(true);
+            } else {
+                status = furi_hal_sd_init(false);
+            }
+
+            if(status == FuriStatusOk) {
+                status = sd_device_write(buff, sector, count);
+            }
+            counter--;
+        }
+    }
+
+    return status;
+}
+
+static bool sd_cache_write_callback(uint32_t sector, const uint8_t* data) {
+    return sd_device_write_with_retry((const uint32_t*)data, sector, 1) == FuriStatusOk;
+}
+
 void furi_hal_sd_presence_init(void) {
     // low speed input with pullup
     furi_hal_gpio_init(&gpio_sdcard_cd, GpioModeInput, GpioPullUp, GpioSpeedLow);
@@ -955,6 +984,7 @@ FuriStatus furi_hal_sd_init(bool power_reset) {
 
     // Init sector cache
     sector_cache_init();
+    sector_cache_set_write_callback(sd_cache_write_callback);
 
     return status;
 }
@@ -976,9 +1006,10 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
 
     FuriStatus status;
     bool single_sector = count == 1;
+    SectorCacheHint hint = sector_cache_take_hint();
 
     if(single_sector) {
-        if(sd_cache_get(sector, buff)) {
+        if(sd_cache_get(sector, buff, hint)) {
             return FuriStatusOk;
         }
     }
@@ -1003,8 +1034,13 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         }
     }
 
-    if(single_sector && status == FuriStatusOk) {
-        sd_cache_put(sector, buff);
+    if(status == FuriStatusOk) {
+        if(single_sector) {
+            sd_cache_put(sector, buff, hint);
+        } else {
+            // Card content is older than not yet written back sectors
+            sector_cache_apply_dirty(sector, count, (uint8_t*)buff);
+        }
     }
 
     return status;
@@ -1014,32 +1050,36 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
     furi_check(buff);
 
     FuriStatus status;
+    SectorCacheHint hint = sector_cache_take_hint();
 
-    sd_cache_invalidate_range(sector, sector + count);
-
-    status = sd_device_write(buff, sector, count);
-
-    if(status != FuriStatusOk) {
-        uint8_t counter = furi_hal_sd_max_mount_retry_count();
+    if(count == 1 && sector_cache_write(sector, (const uint8_t*)buff, hint)) {
+        return FuriStatusOk;
+    }
+    sd_cache_invalidate_range(sector, sector + count - 1);
 
-        while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
-            if((counter % 2) == 0) {
-                // power reset sd card
-                status = furi_hal_sd_init(true);
-            } else {
-                status = furi_hal_sd_init(false);
-            }
+    status = sd_device_write_with_retry(buff, sector, count);
 
-            if(status == FuriStatusOk) {
-                status = sd_device_write(buff, sector, count);
-            }
-            counter--;
-        }
+    // Write-through for metadata, it is likely to be read again soon
+    if(status == FuriStatusOk && count == 1 && hint != SectorCacheHintData) {
+        sd_cache_put(sector, buff, hint);
     }
 
     return status;
 }
 
+void furi_hal_sd_get_cache_stats(FuriHalSdCacheStats* stats) {
+    furi_check(stats);
+
+    SectorCacheStats cache_stats;
+    sector_cache_get_stats(&cache_stats);
+
+    stats->hits = cache_stats.hits;
+    stats->misses = cache_stats.misses;
+    stats->evictions = cache_stats.evictions;
+    stats->write_backs = cache_stats.write_backs;
+    stats->dirty = cache_stats.dirty;
+}
+
 FuriStatus furi_hal_sd_info(FuriHalSdInfo* info) {
     furi_check(info);
 
@@ -26,6 +26,14 @@ typedef struct {
     uint16_t manufacturing_year; /*!< manufacturing year */
 } FuriHalSdInfo;
 
+typedef struct {
+    uint32_t hits; /*!< sector reads served from cache */
+    uint32_t misses; /*!< sector reads that went to card */
+    uint32_t evictions; /*!< sectors evicted to make room */
+    uint32_t write_backs; /*!< dirty sectors written to card */
+    uint32_t dirty; /*!< sectors not yet written to card */
+} FuriHalSdCacheStats;
+
 /** 
  * @brief Init SD card presence detection
  */
@@ -81,6 +89,12 @@ FuriStatus furi_hal_sd_info(FuriHalSdInfo* info);
  */
 FuriStatus furi_hal_sd_get_card_state(void);
 
+/**
+ * @brief Get SD card sector cache counters
+ * @param stats 
+ */
+void furi_hal_sd_get_cache_stats(FuriHalSdCacheStats* stats);
+
 #ifdef __cplusplus
 }
 #endif